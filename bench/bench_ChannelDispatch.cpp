@@ -0,0 +1,78 @@
+/**
+ * @file bench_ChannelDispatch.cpp
+ * @brief Scaling of ChannelDispatchPool from 1 lane to one per core
+ *
+ * Each update posts 1024 messages spread over 16 channels; every handler
+ * call does a fixed amount of per-channel work (a short smoothing loop,
+ * standing in for voice allocation / parameter smoothing). Reports
+ * messages/s and speedup over the serial (1 lane) run.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/ChannelDispatchPool.hpp>
+
+using oc::hal::midi::ChannelDispatchPool;
+
+namespace bench {
+
+constexpr int UPDATES = 400;
+constexpr uint32_t MESSAGES_PER_UPDATE = 1024;
+constexpr int WORK = 400;  // Inner iterations per message
+
+struct alignas(64) ChannelState {
+    double value = 0.0;
+};
+
+double measure(size_t lanes) {
+    ChannelDispatchPool pool(lanes);
+    ChannelState state[16];
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < UPDATES; ++update) {
+        for (uint32_t i = 0; i < MESSAGES_PER_UPDATE; ++i) {
+            const uint8_t channel = static_cast<uint8_t>(i & 0x0F);
+            const uint8_t cc[3] = {static_cast<uint8_t>(0xB0 | channel), 74,
+                                   static_cast<uint8_t>(i & 0x7F)};
+            pool.post(channel, cc, sizeof(cc), i);
+        }
+        pool.run([&](const ChannelDispatchPool::Item& item) {
+            ChannelState& s = state[item.bytes[0] & 0x0F];
+            const double target = item.bytes[2] / 127.0;
+            for (int k = 0; k < WORK; ++k) s.value += (target - s.value) * 0.01;
+        });
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    volatile double sink = 0.0;
+    for (const auto& s : state) sink = sink + s.value;
+    return static_cast<double>(UPDATES) * MESSAGES_PER_UPDATE / seconds;
+}
+
+}  // namespace bench
+
+int main() {
+    size_t cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    if (cores > ChannelDispatchPool::MAX_LANES) cores = ChannelDispatchPool::MAX_LANES;
+
+    std::printf("ChannelDispatchPool scaling (%zu cores)\n", cores);
+    std::printf("%-6s %14s %8s\n", "lanes", "msg/s", "speedup");
+
+    const double serial = bench::measure(1);
+    std::printf("%-6d %14.0f %8.2f\n", 1, serial, 1.0);
+    for (size_t lanes = 2; lanes <= cores; lanes *= 2) {
+        const double rate = bench::measure(lanes);
+        std::printf("%-6zu %14.0f %8.2f\n", lanes, rate, rate / serial);
+    }
+    if (cores > 1 && (cores & (cores - 1)) != 0) {
+        const double rate = bench::measure(cores);
+        std::printf("%-6zu %14.0f %8.2f\n", cores, rate, rate / serial);
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file bench_ClockThru.cpp
+ * @brief Output jitter of a re-emitted MIDI clock: update() echo vs ClockThru
+ *
+ * A receive thread gets clock ticks every PERIOD (24 ppqn at 125 BPM),
+ * each arriving up to INPUT_JITTER late (pseudo-random), and either:
+ * - echo: queues them under a mutex for a main loop running update() every
+ *   16.7 ms (60 Hz frame), which sends from the clock callback
+ * - immediate: ClockThru sends from the receive thread
+ * - smoothed: ClockThru sends DLL-filtered ticks from its scheduling thread
+ *
+ * Reports the spread of the output tick intervals (stddev, worst deviation
+ * from PERIOD) after a settling time, and the mean delay from the ideal
+ * tick time to the send.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/ClockThru.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+constexpr int TICKS = 200;
+constexpr int SETTLE_TICKS = 50;  // DLL settling (~1 s at 1 Hz bandwidth)
+constexpr uint64_t PERIOD_US = 20000;
+constexpr uint64_t INPUT_JITTER_US = 1000;
+constexpr uint64_t FRAME_US = 16667;
+
+struct Output {
+    std::mutex mutex;
+    std::vector<uint64_t> times;
+
+    Output() { times.reserve(TICKS); }
+
+    void record() {
+        const uint64_t now = steadyNowUs();
+        std::lock_guard<std::mutex> lock(mutex);
+        times.push_back(now);
+    }
+};
+
+/// Feed TICKS ticks to @p onTick(arrivalUs) on this thread; returns the ideal time of tick 0
+template <typename OnTick>
+uint64_t feedClock(OnTick&& onTick) {
+    uint32_t seed = 1;
+    const uint64_t startUs = steadyNowUs() + 5000;
+    for (int i = 0; i < TICKS; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const uint64_t arrivalUs = startUs + i * PERIOD_US + (seed >> 8) % INPUT_JITTER_US;
+        sleepUntilUs(arrivalUs);
+        onTick(steadyNowUs());
+    }
+    return startUs;
+}
+
+void report(const char* name, const std::vector<uint64_t>& times, uint64_t startUs) {
+    std::vector<double> intervals;
+    double delay = 0.0;
+    for (size_t i = SETTLE_TICKS; i < times.size(); ++i) {
+        intervals.push_back(static_cast<double>(times[i] - times[i - 1]));
+        delay += static_cast<double>(times[i]) - static_cast<double>(startUs + i * PERIOD_US);
+    }
+    double mean = 0.0;
+    double worst = 0.0;
+    for (double interval : intervals) {
+        mean += interval;
+        worst = std::max(worst, std::fabs(interval - static_cast<double>(PERIOD_US)));
+    }
+    mean /= intervals.size();
+    double sq = 0.0;
+    for (double interval : intervals) sq += (interval - mean) * (interval - mean);
+
+    std::printf("%-28s n=%-4zu interval stddev %8.1f us  worst %8.1f us  delay %8.1f us\n",
+                name, times.size(), std::sqrt(sq / intervals.size()), worst,
+                delay / intervals.size());
+}
+
+void runEcho() {
+    std::mutex mutex;
+    std::vector<uint64_t> queue;
+    std::atomic<bool> done{false};
+    Output out;
+
+    uint64_t startUs = 0;
+    std::thread rx([&] {
+        startUs = feedClock([&](uint64_t arrivalUs) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(arrivalUs);
+        });
+        done = true;
+    });
+
+    std::vector<uint64_t> local;
+    uint64_t nextFrame = steadyNowUs();
+    for (;;) {
+        nextFrame += FRAME_US;
+        sleepUntilUs(nextFrame);
+        const bool finished = done;  // Read before the swap: nothing is left behind
+        local.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            local.swap(queue);
+        }
+        for (size_t i = 0; i < local.size(); ++i) out.record();  // on_clock_ -> sendClock()
+        if (finished && local.empty()) break;
+    }
+    rx.join();
+    report("echo via update() (60 Hz)", out.times, startUs);
+}
+
+void runClockThru(const char* name, ClockThruMode mode) {
+    ClockThruConfig config;
+    config.mode = mode;
+    config.latencyUs = 2000;
+    Output out;
+    uint64_t startUs = 0;
+    {
+        ClockThru thru(config, [&](const uint8_t*, size_t) { out.record(); });
+        const uint8_t tick = 0xF8;
+        startUs = feedClock([&](uint64_t arrivalUs) { thru.handle(&tick, 1, arrivalUs); });
+        sleepUntilUs(steadyNowUs() + 3 * config.latencyUs);
+    }
+    report(name, out.times, startUs);
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("Clock thru output jitter (period %llu us, input jitter 0-%llu us)\n",
+                static_cast<unsigned long long>(bench::PERIOD_US),
+                static_cast<unsigned long long>(bench::INPUT_JITTER_US));
+    bench::runEcho();
+    bench::runClockThru("ClockThru immediate", ClockThruMode::Immediate);
+    bench::runClockThru("ClockThru smoothed (DLL)", ClockThruMode::Smoothed);
+    return 0;
+}
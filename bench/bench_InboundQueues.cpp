@@ -0,0 +1,116 @@
+/**
+ * @file bench_InboundQueues.cpp
+ * @brief Note latency behind a SysEx flood: one FIFO vs per-class queues
+ *
+ * Each frame, a SysEx dump (SYSEX_PER_FRAME messages whose handler takes
+ * SYSEX_HANDLER_US, e.g. decoding a preset) arrives just before a few
+ * notes and clocks. The frame is drained and dispatched as update() does:
+ * - single FIFO: every message in one class, arrival order
+ * - per class: realtime, then channel voice, then SysEx
+ *
+ * Reports, per class, the time from queuing to the handler call.
+ *
+ * A second run replays a preset recall (BURST_SIZE controllers between two
+ * updates, then idle updates) against a fixed 1024-slot queue and the
+ * default ring + spill: drops, and slots held during the burst and at idle.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <oc/hal/midi/InboundQueues.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+constexpr int FRAMES = 200;
+constexpr int SYSEX_PER_FRAME = 32;
+constexpr int NOTES_PER_FRAME = 4;
+constexpr uint64_t SYSEX_HANDLER_US = 20;
+constexpr int BURST_SIZE = 2000;
+constexpr int IDLE_UPDATES = 1000;
+
+struct Item {
+    uint8_t status = 0;
+    uint64_t timestampUs = 0;
+};
+
+void spinUs(uint64_t us) {
+    const uint64_t end = steadyNowUs() + us;
+    while (steadyNowUs() < end) {
+    }
+}
+
+void run(const char* name, bool split) {
+    InboundQueues<Item> queues(InboundQueueConfig{});
+    std::vector<Item> batch;
+    auto classOf = [&](uint8_t status) {
+        return split ? midiTrafficClass(status) : MidiTrafficClass::ChannelVoice;
+    };
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        const uint64_t nowUs = steadyNowUs();
+        for (int i = 0; i < SYSEX_PER_FRAME; ++i) queues.push(classOf(0xF0), Item{0xF0, nowUs});
+        for (int i = 0; i < NOTES_PER_FRAME; ++i) {
+            queues.push(classOf(0x90), Item{0x90, nowUs});
+            queues.push(classOf(0xF8), Item{0xF8, nowUs});
+        }
+
+        batch.clear();
+        queues.drain(batch);
+        for (const Item& item : batch) {
+            // Latency is kept under the message's real class either way.
+            queues.recordLatency(midiTrafficClass(item.status), steadyNowUs() - item.timestampUs);
+            if (item.status == 0xF0) spinUs(SYSEX_HANDLER_US);
+        }
+    }
+
+    std::printf("%s\n", name);
+    const char* names[] = {"realtime", "channel voice", "sysex"};
+    for (size_t i = 0; i < MIDI_TRAFFIC_CLASS_COUNT; ++i) {
+        const auto latency = queues.stats(static_cast<MidiTrafficClass>(i)).latency;
+        std::printf("  %-14s n=%-6llu mean %8.1f us  max %8lld us\n", names[i],
+                    static_cast<unsigned long long>(latency.count), latency.meanUs,
+                    static_cast<long long>(latency.maxUs));
+    }
+}
+
+void runBurst(const char* name, const InboundQueueConfig& config, size_t ringSize) {
+    InboundQueues<Item> queues(config);
+    std::vector<Item> batch;
+    for (int i = 0; i < BURST_SIZE; ++i) queues.push(MidiTrafficClass::ChannelVoice, Item{0xB0, 0});
+    queues.drain(batch);
+    const auto burst = queues.stats(MidiTrafficClass::ChannelVoice);
+
+    for (int i = 0; i < IDLE_UPDATES; ++i) {
+        queues.push(MidiTrafficClass::ChannelVoice, Item{0xB0, 0});
+        batch.clear();
+        queues.drain(batch);
+    }
+    const auto idle = queues.stats(MidiTrafficClass::ChannelVoice);
+
+    std::printf("  %-18s dropped %5llu  slots after burst %5zu  at idle %5zu\n", name,
+                static_cast<unsigned long long>(burst.dropped), ringSize + burst.spillReserve,
+                ringSize + idle.spillReserve);
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("Queue latency behind a SysEx flood (%d x %llu us SysEx handlers per frame)\n",
+                bench::SYSEX_PER_FRAME,
+                static_cast<unsigned long long>(bench::SYSEX_HANDLER_US));
+    bench::run("single FIFO", false);
+    bench::run("per-class queues", true);
+
+    std::printf("\nPreset recall: %d controllers, then %d idle updates\n", bench::BURST_SIZE,
+                bench::IDLE_UPDATES);
+    InboundQueueConfig fixed;
+    fixed.channelVoice = {1024, QueueDropPolicy::DropNewest, 1024};
+    bench::runBurst("fixed 1024", fixed, 1024);
+    const InboundQueueConfig adaptive;
+    bench::runBurst("ring + spill", adaptive, adaptive.channelVoice.ringSize);
+    return 0;
+}
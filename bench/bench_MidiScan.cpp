@@ -0,0 +1,61 @@
+/**
+ * @file bench_MidiScan.cpp
+ * @brief findStatusByte (SIMD) vs findStatusByteScalar
+ *
+ * Scans buffers with a status byte every N bytes, from dense channel
+ * traffic (N = 3) to multi-kilobyte SysEx data runs, and reports GB/s.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <oc/hal/midi/MidiScan.hpp>
+
+using oc::hal::midi::findStatusByte;
+using oc::hal::midi::findStatusByteScalar;
+
+namespace bench {
+
+std::vector<uint8_t> makeBuffer(size_t size, size_t statusEvery) {
+    std::vector<uint8_t> out(size);
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = (i % statusEvery == statusEvery - 1) ? 0xF7 : static_cast<uint8_t>(i & 0x7F);
+    }
+    return out;
+}
+
+template <typename Scan>
+double measure(const std::vector<uint8_t>& buffer, int iterations, Scan scan) {
+    volatile size_t sink = 0;
+    const uint8_t* end = buffer.data() + buffer.size();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        const uint8_t* p = buffer.data();
+        while (p < end) {
+            p = scan(p, end);
+            sink = sink + static_cast<size_t>(end - p);
+            if (p < end) ++p;
+        }
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(buffer.size()) * iterations / seconds / 1e9;
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("findStatusByte: %s vs scalar\n", oc::hal::midi::MIDI_SCAN_ISA);
+    std::printf("%-14s %12s %12s %8s\n", "status every", "scalar GB/s", "simd GB/s", "speedup");
+
+    for (size_t every : {size_t{3}, size_t{16}, size_t{64}, size_t{256}, size_t{4096}, size_t{65536}}) {
+        const auto buffer = bench::makeBuffer(1 << 22, every);
+        const double scalar = bench::measure(buffer, 20, findStatusByteScalar);
+        const double simd = bench::measure(buffer, 20, findStatusByte);
+        std::printf("%-14zu %12.2f %12.2f %7.2fx\n", every, scalar, simd, simd / scalar);
+    }
+    return 0;
+}
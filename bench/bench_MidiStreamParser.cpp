@@ -0,0 +1,86 @@
+/**
+ * @file bench_MidiStreamParser.cpp
+ * @brief Throughput benchmark for MidiStreamParser
+ *
+ * Parses synthetic streams (channel voice with running status, interleaved
+ * clock, large SysEx dumps) and reports MB/s and messages/s.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <oc/hal/midi/MidiStreamParser.hpp>
+
+using oc::hal::midi::MidiStreamParser;
+
+namespace bench {
+
+std::vector<uint8_t> makeChannelStream(size_t bytes) {
+    std::vector<uint8_t> out;
+    out.reserve(bytes + 8);
+    uint8_t n = 0;
+    while (out.size() < bytes) {
+        out.push_back(0xB0 | (n & 0x0F));
+        for (int i = 0; i < 8; ++i) {  // running status
+            out.push_back(static_cast<uint8_t>(n++ & 0x7F));
+            out.push_back(static_cast<uint8_t>((n * 3) & 0x7F));
+        }
+        out.push_back(0xF8);
+    }
+    return out;
+}
+
+std::vector<uint8_t> makeSysExStream(size_t bytes, size_t dumpSize) {
+    std::vector<uint8_t> out;
+    out.reserve(bytes + dumpSize);
+    while (out.size() < bytes) {
+        out.push_back(0xF0);
+        for (size_t i = 0; i < dumpSize; ++i) out.push_back(static_cast<uint8_t>(i & 0x7F));
+        out.push_back(0xF7);
+    }
+    return out;
+}
+
+void run(const char* name, const std::vector<uint8_t>& stream, size_t chunk, int iterations) {
+    static std::array<uint8_t, 65536> sysex;
+    MidiStreamParser parser(sysex.data(), sysex.size());
+    volatile uint64_t sink = 0;
+    uint64_t messages = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        for (size_t off = 0; off < stream.size(); off += chunk) {
+            const size_t n = stream.size() - off < chunk ? stream.size() - off : chunk;
+            parser.parse(stream.data() + off, n, [&](const uint8_t* data, size_t length) {
+                sink = sink + data[0] + length;
+                ++messages;
+            });
+        }
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double bytes = static_cast<double>(stream.size()) * iterations;
+    std::printf("%-28s chunk=%-6zu %8.1f MB/s  %8.2f Mmsg/s\n", name, chunk,
+                bytes / seconds / 1e6, static_cast<double>(messages) / seconds / 1e6);
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("MidiStreamParser throughput\n");
+
+    const auto channel = bench::makeChannelStream(1 << 20);
+    const auto sysex = bench::makeSysExStream(1 << 20, 4096);
+
+    for (size_t chunk : {size_t{3}, size_t{64}, size_t{4096}}) {
+        bench::run("channel+running status", channel, chunk, 50);
+    }
+    for (size_t chunk : {size_t{64}, size_t{4096}}) {
+        bench::run("sysex 4 KiB dumps", sysex, chunk, 50);
+    }
+    return 0;
+}
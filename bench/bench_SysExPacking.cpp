@@ -0,0 +1,53 @@
+/**
+ * @file bench_SysExPacking.cpp
+ * @brief 7-in-8 pack/unpack throughput (GB/s of raw data), vectorised vs scalar
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include <oc/hal/midi/SysExPacking.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+template <typename Kernel>
+double measure(const std::vector<uint8_t>& in, std::vector<uint8_t>& out, size_t rawBytes,
+               int iterations, Kernel kernel) {
+    volatile uint8_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int it = 0; it < iterations; ++it) {
+        kernel(in.data(), in.size(), out.data());
+        sink = sink + out[it % out.size()];
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(rawBytes) * iterations / seconds / 1e9;
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("SysEx 7-in-8 packing (GB/s of raw data)\n");
+    std::printf("%-10s %10s %10s %10s %10s\n", "size", "pack", "pack ref", "unpack", "unpack ref");
+
+    for (size_t size : {size_t{64}, size_t{1024}, size_t{65536}, size_t{1} << 20}) {
+        std::vector<uint8_t> raw(size);
+        for (size_t i = 0; i < size; ++i) raw[i] = static_cast<uint8_t>(i * 131 + 7);
+        std::vector<uint8_t> packed(sysEx7PackedSize(size));
+        std::vector<uint8_t> unpacked(size);
+        packSysEx7(raw.data(), raw.size(), packed.data());
+
+        const int iterations = static_cast<int>((size_t{1} << 28) / size);
+        const double pack = bench::measure(raw, packed, size, iterations, packSysEx7);
+        const double packRef = bench::measure(raw, packed, size, iterations, packSysEx7Scalar);
+        const double unpack = bench::measure(packed, unpacked, size, iterations, unpackSysEx7);
+        const double unpackRef =
+            bench::measure(packed, unpacked, size, iterations, unpackSysEx7Scalar);
+        std::printf("%-10zu %10.2f %10.2f %10.2f %10.2f\n", size, pack, packRef, unpack, unpackRef);
+    }
+    return 0;
+}
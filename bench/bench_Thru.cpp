@@ -0,0 +1,135 @@
+/**
+ * @file bench_Thru.cpp
+ * @brief Input-to-output latency: soft thru on the receive thread vs update() echo
+ *
+ * A receive thread frames bursts of messages with MidiStreamParser and
+ * either:
+ * - thru: forwards them with MidiThru right away, or
+ * - echo: copies each into a vector queued under a mutex, as the transport
+ *   does; a main loop running update() every 1 ms (a typical frame) drains
+ *   the queue and "sends" from its handler.
+ *
+ * Latency is measured from the moment the bytes reach the receive thread to
+ * the send call. Reports mean, p99 and max in microseconds.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/MidiStreamParser.hpp>
+#include <oc/hal/midi/MidiThru.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int BURSTS = 2000;
+constexpr int PER_BURST = 4;
+constexpr auto BURST_GAP = std::chrono::microseconds(700);
+constexpr auto FRAME = std::chrono::milliseconds(1);
+
+double toUs(Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); }
+
+void report(const char* name, std::vector<double>& latencies) {
+    std::sort(latencies.begin(), latencies.end());
+    double sum = 0.0;
+    for (double l : latencies) sum += l;
+    std::printf("%-32s n=%-6zu mean %8.2f us  p99 %8.2f us  max %8.2f us\n", name,
+                latencies.size(), sum / latencies.size(),
+                latencies[latencies.size() * 99 / 100], latencies.back());
+}
+
+std::array<uint8_t, PER_BURST * 3> makeBurst(int n) {
+    std::array<uint8_t, PER_BURST * 3> burst{};
+    for (int i = 0; i < PER_BURST; ++i) {
+        burst[i * 3] = 0x90;
+        burst[i * 3 + 1] = static_cast<uint8_t>((n + i) & 0x7F);
+        burst[i * 3 + 2] = 100;
+    }
+    return burst;
+}
+
+void runThru() {
+    std::array<uint8_t, 256> sysex;
+    MidiStreamParser parser(sysex.data(), sysex.size());
+    MidiThru thru;
+    thru.add(MidiThru::Route{});
+    std::vector<double> latencies;
+    latencies.reserve(BURSTS * PER_BURST);
+
+    for (int n = 0; n < BURSTS; ++n) {
+        const auto burst = makeBurst(n);
+        const auto arrived = Clock::now();
+        parser.parse(burst.data(), burst.size(), [&](const uint8_t* data, size_t length) {
+            thru.forward(data, length, [&](const uint8_t*, size_t) {
+                latencies.push_back(toUs(Clock::now() - arrived));
+            });
+        });
+        std::this_thread::sleep_for(BURST_GAP);
+    }
+    report("thru (receive thread)", latencies);
+}
+
+void runEcho() {
+    struct Pending {
+        std::vector<uint8_t> bytes;
+        Clock::time_point arrived;
+    };
+    std::mutex mutex;
+    std::vector<Pending> queue;
+    std::atomic<bool> done{false};
+    std::vector<double> latencies;
+    latencies.reserve(BURSTS * PER_BURST);
+
+    std::thread rx([&] {
+        std::array<uint8_t, 256> sysex;
+        MidiStreamParser parser(sysex.data(), sysex.size());
+        for (int n = 0; n < BURSTS; ++n) {
+            const auto burst = makeBurst(n);
+            const auto arrived = Clock::now();
+            parser.parse(burst.data(), burst.size(), [&](const uint8_t* data, size_t length) {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push_back({std::vector<uint8_t>(data, data + length), arrived});
+            });
+            std::this_thread::sleep_for(BURST_GAP);
+        }
+        done = true;
+    });
+
+    std::vector<Pending> local;
+    auto nextFrame = Clock::now();
+    for (;;) {
+        nextFrame += FRAME;
+        std::this_thread::sleep_until(nextFrame);
+        const bool finished = done;  // Read before the swap: nothing is left behind
+        local.clear();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            local.swap(queue);
+        }
+        for (const auto& pending : local) {
+            latencies.push_back(toUs(Clock::now() - pending.arrived));  // handler -> send
+        }
+        if (finished && local.empty()) break;
+    }
+    rx.join();
+    report("echo via update() (1 ms frame)", latencies);
+}
+
+}  // namespace bench
+
+int main() {
+    std::printf("MIDI thru latency\n");
+    bench::runThru();
+    bench::runEcho();
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file bench_TransformPipeline.cpp
+ * @brief Cost per stage per message of TransformPipeline and StaticTransform
+ *
+ * Runs a stream of note / CC messages through chains of 1 to 16 stages
+ * (cycling through the stage types, all passing) and reports ns per
+ * message and ns per stage, next to a compile-time chain of 4 stages.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <oc/hal/midi/TransformPipeline.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+constexpr size_t MESSAGES = 1 << 16;
+constexpr int ROUNDS = 64;
+
+std::vector<uint8_t> makeMessages() {
+    std::vector<uint8_t> out(MESSAGES * 3);
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        out[i * 3] = static_cast<uint8_t>((i % 3 == 0 ? 0xB0 : 0x90) | (i & 0x0F));
+        out[i * 3 + 1] = static_cast<uint8_t>(24 + (i % 80));
+        out[i * 3 + 2] = static_cast<uint8_t>(1 + (i % 126));
+    }
+    return out;
+}
+
+TransformPipeline::Stage stageAt(size_t i) {
+    switch (i % 6) {
+        case 0: return transform::KeyZone{0, 59, 1};
+        case 1: return transform::Transpose{1};
+        case 2: return transform::ScaleVelocity{250};
+        case 3: return transform::MapChannel{};
+        case 4: return transform::FilterChannels{};
+        default: return transform::Transpose{-1};
+    }
+}
+
+template <typename Chain>
+double nsPerMessage(const Chain& chain, const std::vector<uint8_t>& input) {
+    std::vector<uint8_t> work(input.size());
+    volatile uint32_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; ++round) {
+        std::memcpy(work.data(), input.data(), input.size());
+        uint32_t kept = 0;
+        for (size_t i = 0; i < MESSAGES; ++i) kept += chain.apply(&work[i * 3], 3);
+        sink = sink + kept + work[round];
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (static_cast<double>(MESSAGES) * ROUNDS);
+}
+
+}  // namespace bench
+
+int main() {
+    const auto input = bench::makeMessages();
+
+    std::printf("Transform pipeline cost\n");
+    std::printf("%-22s %10s %10s\n", "chain", "ns/msg", "ns/stage");
+
+    const double base = bench::nsPerMessage(TransformPipeline{}, input);
+    std::printf("%-22s %10.2f %10s\n", "runtime, 0 stages", base, "-");
+
+    for (size_t stages : {size_t{1}, size_t{2}, size_t{4}, size_t{8}, size_t{16}}) {
+        TransformPipeline pipeline;
+        for (size_t i = 0; i < stages; ++i) pipeline.add(bench::stageAt(i));
+        const double ns = bench::nsPerMessage(pipeline, input);
+        char name[32];
+        std::snprintf(name, sizeof(name), "runtime, %zu stages", stages);
+        std::printf("%-22s %10.2f %10.2f\n", name, ns, (ns - base) / stages);
+    }
+
+    const StaticTransform<transform::KeyZone, transform::Transpose, transform::ScaleVelocity,
+                          transform::MapChannel>
+        fixed(transform::KeyZone{0, 59, 1}, transform::Transpose{1},
+              transform::ScaleVelocity{250}, transform::MapChannel{});
+    const double ns = bench::nsPerMessage(fixed, input);
+    std::printf("%-22s %10.2f %10.2f\n", "static, 4 stages", ns, (ns - base) / 4);
+    return 0;
+}
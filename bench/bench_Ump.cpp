@@ -0,0 +1,113 @@
+/**
+ * @file bench_Ump.cpp
+ * @brief Receive-side cost: MIDI 1.0 byte path vs UMP packet path
+ *
+ * Byte path (as LibreMidiTransport does without UMP): frame with
+ * MidiStreamParser, copy each message into a heap vector, queue it under a
+ * mutex, then decode the status byte on the consumer side.
+ *
+ * UMP path: push fixed-size packets into SpscQueue, pop and route them
+ * through UmpDispatcher's per-type table.
+ *
+ * Both run producer and consumer on one thread in batches of 64, which
+ * isolates the per-message cost from scheduling noise.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include <oc/hal/midi/MidiEvent.hpp>
+#include <oc/hal/midi/MidiStreamParser.hpp>
+#include <oc/hal/midi/SpscQueue.hpp>
+#include <oc/hal/midi/Ump.hpp>
+#include <oc/hal/midi/UmpTranslator.hpp>
+
+using namespace oc::hal::midi;
+
+namespace bench {
+
+constexpr size_t MESSAGES = 1 << 20;
+constexpr size_t BATCH = 64;
+
+std::vector<uint8_t> makeStream() {
+    std::vector<uint8_t> out;
+    out.reserve(MESSAGES * 3);
+    for (size_t i = 0; i < MESSAGES; ++i) {
+        out.push_back(static_cast<uint8_t>((i & 1 ? 0x90 : 0xB0) | (i & 0x0F)));
+        out.push_back(static_cast<uint8_t>(i & 0x7F));
+        out.push_back(static_cast<uint8_t>((i * 7) & 0x7F));
+    }
+    return out;
+}
+
+double bytePath(const std::vector<uint8_t>& stream) {
+    static std::array<uint8_t, 1024> sysex;
+    MidiStreamParser parser(sysex.data(), sysex.size());
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> queue;
+    std::vector<std::vector<uint8_t>> local;
+    volatile uint32_t sink = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t off = 0; off < stream.size(); off += BATCH * 3) {
+        parser.parse(stream.data() + off, BATCH * 3, [&](const uint8_t* data, size_t length) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.emplace_back(data, data + length);
+        });
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            local.swap(queue);
+        }
+        for (const auto& message : local) {
+            MidiEvent event;
+            if (decodeMidiEvent(message.data(), message.size(), event)) sink = sink + event.data2;
+        }
+        local.clear();
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(MESSAGES) / seconds / 1e6;
+}
+
+double umpPath(const std::vector<UmpPacket>& packets) {
+    SpscQueue<UmpPacket> queue(1024);
+    UmpDispatcher dispatcher;
+    volatile uint32_t sink = 0;
+    dispatcher.setHandler(UmpType::Midi1ChannelVoice,
+                          [&](const UmpPacket& packet) { sink = sink + (packet.words[0] & 0x7F); });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t off = 0; off < packets.size(); off += BATCH) {
+        for (size_t i = 0; i < BATCH; ++i) queue.push(packets[off + i]);
+        UmpPacket packet;
+        while (queue.pop(packet)) dispatcher.dispatch(packet);
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(MESSAGES) / seconds / 1e6;
+}
+
+}  // namespace bench
+
+int main() {
+    const auto stream = bench::makeStream();
+
+    std::vector<UmpPacket> packets;
+    packets.reserve(bench::MESSAGES);
+    Midi1ToUmp translator;
+    for (size_t off = 0; off < stream.size(); off += 3) {
+        translator.convert(stream.data() + off, 3,
+                           [&](const UmpPacket& packet) { packets.push_back(packet); });
+    }
+
+    std::printf("Receive path, channel voice (Mmsg/s)\n");
+    for (int run = 0; run < 3; ++run) {
+        std::printf("bytes + vector + mutex queue %8.2f   ump + spsc ring + dispatch %8.2f\n",
+                    bench::bytePath(stream), bench::umpPath(packets));
+    }
+    return 0;
+}
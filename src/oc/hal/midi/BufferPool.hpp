@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file BufferPool.hpp
+ * @brief Recycled byte buffers for messages that must outlive their caller
+ *
+ * When bytes have to be queued past the call that produced them (e.g. SysEx
+ * fragments handed from the receive thread to update()), they are copied
+ * into a buffer borrowed from this pool and the buffer is returned once
+ * consumed. Buffers keep their capacity across uses, so steady traffic of
+ * similar sizes stops allocating after the first few messages.
+ *
+ * Not thread-safe: guard with the lock protecting the queue that holds the
+ * borrowed buffers.
+ *
+ * Usage:
+ *   BufferPool pool(4, 256);
+ *   auto buffer = pool.acquire(data, length);
+ *   queue.push_back(std::move(buffer));
+ *   ...
+ *   pool.release(std::move(queue.front()));
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oc::hal::midi {
+
+class BufferPool {
+public:
+    struct Stats {
+        uint32_t acquired = 0;     ///< Buffers handed out
+        uint32_t allocations = 0;  ///< acquire() calls that had to allocate
+    };
+
+    /**
+     * @param maxBuffers  Buffers kept for reuse (extra releases are freed)
+     * @param reserveBytes Initial capacity of each pre-allocated buffer
+     */
+    explicit BufferPool(size_t maxBuffers = 4, size_t reserveBytes = 0)
+        : max_buffers_(maxBuffers) {
+        free_.reserve(maxBuffers);
+        if (reserveBytes == 0) return;
+        for (size_t i = 0; i < maxBuffers; ++i) {
+            free_.emplace_back();
+            free_.back().reserve(reserveBytes);
+        }
+    }
+
+    /// Borrow a buffer holding a copy of @p data
+    std::vector<uint8_t> acquire(const uint8_t* data, size_t length) {
+        std::vector<uint8_t> buffer = take(length);
+        buffer.assign(data, data + length);
+        return buffer;
+    }
+
+    /// Return a buffer; its capacity is kept for the next acquire()
+    void release(std::vector<uint8_t>&& buffer) {
+        if (free_.size() >= max_buffers_ || buffer.capacity() == 0) return;
+        buffer.clear();
+        free_.push_back(std::move(buffer));
+    }
+
+    size_t available() const { return free_.size(); }
+    const Stats& stats() const { return stats_; }
+
+private:
+    // Smallest free buffer that fits, else the largest one (grown once).
+    std::vector<uint8_t> take(size_t length) {
+        ++stats_.acquired;
+        if (free_.empty()) {
+            ++stats_.allocations;
+            return {};
+        }
+
+        size_t best = 0;
+        for (size_t i = 1; i < free_.size(); ++i) {
+            const size_t capacity = free_[i].capacity();
+            const size_t bestCapacity = free_[best].capacity();
+            const bool fits = capacity >= length;
+            const bool bestFits = bestCapacity >= length;
+            if ((fits && (!bestFits || capacity < bestCapacity)) ||
+                (!fits && !bestFits && capacity > bestCapacity)) {
+                best = i;
+            }
+        }
+        if (free_[best].capacity() < length) ++stats_.allocations;
+
+        std::vector<uint8_t> buffer = std::move(free_[best]);
+        if (best + 1 != free_.size()) free_[best] = std::move(free_.back());
+        free_.pop_back();
+        return buffer;
+    }
+
+    size_t max_buffers_;
+    std::vector<std::vector<uint8_t>> free_;
+    Stats stats_;
+};
+
+}  // namespace oc::hal::midi
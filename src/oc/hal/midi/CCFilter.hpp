@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file CCFilter.hpp
+ * @brief Per-(channel, controller) ingress policies: hysteresis, rate limit, dedup
+ *
+ * Cheap potentiometers jitter by one step continuously. CCFilter decides on
+ * the receive thread, before anything is queued, whether a Control Change
+ * is worth delivering. Each of the 16 x 128 controllers has its own entry
+ * in a flat table; controllers without a policy pass untouched.
+ *
+ * Policies (any combination):
+ * - deadband: a change of direction is ignored unless it exceeds the
+ *   deadband (hysteresis); moving on in the same direction passes.
+ *   0 and 127 always pass so a control can reach its ends.
+ * - maxRateHz: at most this many values per second. Values arriving too
+ *   early are held, and the latest one is delivered by poll() when the
+ *   interval ends, so the final position is never lost.
+ * - dropUnchanged: a value equal to the last delivered one is dropped.
+ *
+ * Not thread-safe.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+struct CCPolicy {
+    /// Largest direction reversal ignored (0 = no hysteresis)
+    uint8_t deadband = 0;
+
+    /// Max values per second (0 = unlimited)
+    uint16_t maxRateHz = 0;
+
+    /// Drop values equal to the last one delivered
+    bool dropUnchanged = false;
+
+    bool active() const { return deadband != 0 || maxRateHz != 0 || dropUnchanged; }
+};
+
+class CCFilter {
+public:
+    struct Stats {
+        uint32_t passed = 0;
+        uint32_t dropped = 0;  ///< Below deadband or unchanged
+        uint32_t held = 0;     ///< Rate-limited (superseded or delivered by poll())
+    };
+
+    CCFilter() { clear(); }
+
+    /// Set the policy of one controller (an inactive policy removes it)
+    void setPolicy(uint8_t channel, uint8_t controller, const CCPolicy& policy) {
+        Entry& e = entries_[index(channel, controller)];
+        e = Entry{};
+        if (!policy.active()) return;
+        e.active = true;
+        e.deadband = policy.deadband;
+        e.dropUnchanged = policy.dropUnchanged;
+        e.minIntervalUs = policy.maxRateHz ? 1000000u / policy.maxRateHz : 0;
+        clearPending(index(channel, controller));
+    }
+
+    /// Same policy for @p controller on all 16 channels
+    void setPolicy(uint8_t controller, const CCPolicy& policy) {
+        for (uint8_t channel = 0; channel < 16; ++channel) setPolicy(channel, controller, policy);
+    }
+
+    /// Remove every policy
+    void clear() {
+        for (auto& e : entries_) e = Entry{};
+        for (auto& word : pending_) word = 0;
+    }
+
+    /// Forget delivered values and held updates, keeping the policies
+    void reset() {
+        for (auto& e : entries_) {
+            e.hasLast = false;
+            e.direction = 0;
+        }
+        for (auto& word : pending_) word = 0;
+    }
+
+    /// @return true if the value should be delivered now
+    bool accept(uint8_t channel, uint8_t controller, uint8_t value, uint64_t nowUs) {
+        const size_t i = index(channel, controller);
+        Entry& e = entries_[i];
+        if (!e.active) return true;
+
+        if (e.hasLast) {
+            if (value == e.last && (e.dropUnchanged || e.deadband)) {
+                clearPending(i);  // Back where the receiver already is
+                ++stats_.dropped;
+                return false;
+            }
+            if (e.deadband && value != 0 && value != 127) {
+                const int delta = static_cast<int>(value) - e.last;
+                const int8_t direction = delta > 0 ? 1 : -1;
+                const int magnitude = delta > 0 ? delta : -delta;
+                if (direction != e.direction && magnitude <= e.deadband) {
+                    ++stats_.dropped;
+                    return false;
+                }
+            }
+            if (e.minIntervalUs && elapsedUs(nowUs, e.lastUs) < e.minIntervalUs) {
+                e.pendingValue = value;
+                pending_[i >> 6] |= uint64_t{1} << (i & 63);
+                ++stats_.held;
+                return false;
+            }
+        }
+        deliver(i, value, nowUs);
+        return true;
+    }
+
+    /**
+     * @brief Deliver held values whose interval has ended
+     * @param emit Called as emit(channel, controller, value)
+     */
+    template <typename Emit>
+    void poll(uint64_t nowUs, Emit&& emit) {
+        for (size_t word = 0; word < PENDING_WORDS; ++word) {
+            uint64_t bits = pending_[word];
+            while (bits) {
+                const size_t bit = static_cast<size_t>(lowestBit(bits));
+                bits &= bits - 1;
+                const size_t i = word * 64 + bit;
+                Entry& e = entries_[i];
+                if (elapsedUs(nowUs, e.lastUs) < e.minIntervalUs) continue;
+                deliver(i, e.pendingValue, nowUs);
+                emit(static_cast<uint8_t>(i >> 7), static_cast<uint8_t>(i & 0x7F), e.last);
+            }
+        }
+    }
+
+    bool hasPending() const {
+        for (auto word : pending_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    static constexpr size_t ENTRIES = 16 * 128;
+    static constexpr size_t PENDING_WORDS = ENTRIES / 64;
+
+    struct Entry {
+        uint64_t lastUs = 0;
+        uint32_t minIntervalUs = 0;
+        uint8_t deadband = 0;
+        uint8_t last = 0;
+        uint8_t pendingValue = 0;
+        int8_t direction = 0;  ///< Of the last delivered move: -1, 0 (none yet), 1
+        bool active = false;
+        bool dropUnchanged = false;
+        bool hasLast = false;
+    };
+
+    static size_t index(uint8_t channel, uint8_t controller) {
+        return (static_cast<size_t>(channel & 0x0F) << 7) | (controller & 0x7F);
+    }
+
+    // Saturating: a delivery stamped after nowUs (the receive thread's
+    // clock ran ahead of the poller's) is not an interval that has ended.
+    static uint64_t elapsedUs(uint64_t nowUs, uint64_t sinceUs) {
+        return nowUs > sinceUs ? nowUs - sinceUs : 0;
+    }
+
+    static int lowestBit(uint64_t v) {
+        int n = 0;
+        while (!(v & 1u)) {
+            v >>= 1;
+            ++n;
+        }
+        return n;
+    }
+
+    void clearPending(size_t i) { pending_[i >> 6] &= ~(uint64_t{1} << (i & 63)); }
+
+    void deliver(size_t i, uint8_t value, uint64_t nowUs) {
+        Entry& e = entries_[i];
+        if (e.hasLast && value != e.last) e.direction = value > e.last ? 1 : -1;
+        e.last = value;
+        e.lastUs = nowUs;
+        e.hasLast = true;
+        clearPending(i);
+        ++stats_.passed;
+    }
+
+    Entry entries_[ENTRIES];
+    uint64_t pending_[PENDING_WORDS];
+    Stats stats_;
+};
+
+}  // namespace oc::hal::midi
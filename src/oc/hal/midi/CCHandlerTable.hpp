@@ -0,0 +1,94 @@
+#pragma once
+
+/**
+ * @file CCHandlerTable.hpp
+ * @brief Control Change handlers bound to (channel, controller) pairs
+ *
+ * A flat table of 16 x 128 handlers indexed by (channel << 7) | controller,
+ * plus a fallback for controllers nobody mapped. Dispatch is one indexed
+ * call instead of a switch over hundreds of mappings in a single on-CC
+ * function.
+ *
+ * A bitmap of mapped entries is readable from any thread, so the receive
+ * thread can drop controllers that have neither a handler nor a fallback
+ * before they are queued (wants()). Handlers themselves are set and called
+ * on the main thread.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace oc::hal::midi {
+
+class CCHandlerTable {
+public:
+    using Handler = std::function<void(uint8_t channel, uint8_t controller, uint8_t value)>;
+
+    /// Bind on all 16 channels
+    static constexpr uint8_t ANY_CHANNEL = 0xFF;
+
+    /// Bind @p handler to one controller (nullptr unbinds it)
+    void set(uint8_t channel, uint8_t controller, Handler handler) {
+        if (channel == ANY_CHANNEL) {
+            for (uint8_t ch = 0; ch < 16; ++ch) set(ch, controller, handler);
+            return;
+        }
+        const size_t i = index(channel, controller);
+        const uint64_t bit = uint64_t{1} << (i & 63);
+        if (handler) {
+            mapped_[i >> 6].fetch_or(bit, std::memory_order_relaxed);
+        } else {
+            mapped_[i >> 6].fetch_and(~bit, std::memory_order_relaxed);
+        }
+        handlers_[i] = std::move(handler);
+    }
+
+    /// Called for controllers without their own handler (nullptr removes it)
+    void setFallback(Handler handler) {
+        has_fallback_.store(static_cast<bool>(handler), std::memory_order_relaxed);
+        fallback_ = std::move(handler);
+    }
+
+    /// Any thread: would dispatch() call something for this controller?
+    bool wants(uint8_t channel, uint8_t controller) const {
+        if (has_fallback_.load(std::memory_order_relaxed)) return true;
+        const size_t i = index(channel, controller);
+        return (mapped_[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1u;
+    }
+
+    /// Any thread: no handler and no fallback
+    bool empty() const {
+        if (has_fallback_.load(std::memory_order_relaxed)) return false;
+        for (const auto& word : mapped_) {
+            if (word.load(std::memory_order_relaxed)) return false;
+        }
+        return true;
+    }
+
+    /// @return false if nothing handled the controller
+    bool dispatch(uint8_t channel, uint8_t controller, uint8_t value) const {
+        const Handler& handler = handlers_[index(channel, controller)];
+        if (handler) {
+            handler(channel, controller, value);
+            return true;
+        }
+        if (!fallback_) return false;
+        fallback_(channel, controller, value);
+        return true;
+    }
+
+private:
+    static size_t index(uint8_t channel, uint8_t controller) {
+        return (static_cast<size_t>(channel & 0x0F) << 7) | (controller & 0x7F);
+    }
+
+    std::array<Handler, 16 * 128> handlers_;
+    Handler fallback_;
+    std::atomic<uint64_t> mapped_[32] = {};
+    std::atomic<bool> has_fallback_{false};
+};
+
+}  // namespace oc::hal::midi
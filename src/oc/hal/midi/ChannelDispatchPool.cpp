@@ -0,0 +1,88 @@
+#include "ChannelDispatchPool.hpp"
+
+#include <cstring>
+
+namespace oc::hal::midi {
+
+ChannelDispatchPool::ChannelDispatchPool(size_t lanes) {
+    if (lanes == 0) lanes = 1;
+    if (lanes > MAX_LANES) lanes = MAX_LANES;
+    batches_.resize(lanes);
+
+    workers_.reserve(lanes - 1);
+    for (size_t lane = 1; lane < lanes; ++lane) {
+        workers_.emplace_back([this, lane] { workerLoop(lane); });
+    }
+}
+
+ChannelDispatchPool::~ChannelDispatchPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+}
+
+void ChannelDispatchPool::post(uint8_t channel, const uint8_t* data, size_t length,
+                               uint64_t timestampUs) {
+    Item item{};
+    item.timestampUs = timestampUs;
+    item.length = static_cast<uint8_t>(length < sizeof(item.bytes) ? length : sizeof(item.bytes));
+    std::memcpy(item.bytes, data, item.length);
+    batches_[(channel & 0x0F) % batches_.size()].push_back(item);
+}
+
+size_t ChannelDispatchPool::pending() const {
+    size_t count = 0;
+    for (const auto& batch : batches_) count += batch.size();
+    return count;
+}
+
+void ChannelDispatchPool::run(const Handler& handler) {
+    bool others = false;
+    for (size_t lane = 1; lane < batches_.size(); ++lane) others |= !batches_[lane].empty();
+
+    if (others) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            handler_ = &handler;
+            remaining_ = workers_.size();
+            ++generation_;
+        }
+        start_cv_.notify_all();
+    }
+
+    runLane(0, handler);
+
+    if (others) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this] { return remaining_ == 0; });
+        handler_ = nullptr;
+    }
+}
+
+void ChannelDispatchPool::runLane(size_t lane, const Handler& handler) {
+    auto& batch = batches_[lane];
+    for (const auto& item : batch) handler(item);
+    batch.clear();
+}
+
+void ChannelDispatchPool::workerLoop(size_t lane) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        start_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) return;
+        seen = generation_;
+        const Handler* handler = handler_;
+
+        lock.unlock();
+        runLane(lane, *handler);
+        lock.lock();
+
+        if (--remaining_ == 0) done_cv_.notify_one();
+    }
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,85 @@
+#pragma once
+
+/**
+ * @file ChannelDispatchPool.hpp
+ * @brief Run channel voice handlers in parallel, sharded by MIDI channel
+ *
+ * Messages are posted with their channel; channel c always goes to lane
+ * c % lanes, so messages of one channel run on one thread in posting
+ * order. run() releases all lanes at once, runs lane 0 on the calling
+ * thread, and returns only when every lane is done (barrier), so handlers
+ * never outlive the update() that posted them.
+ *
+ * Ordering holds within a channel only: two channels on different lanes
+ * run concurrently, and their handlers must not share unsynchronised
+ * state.
+ *
+ * With one lane no thread is started and run() is a plain loop. Batches
+ * keep their capacity between runs: steady-state posting does not
+ * allocate.
+ *
+ * Usage:
+ *   ChannelDispatchPool pool(4);     // calling thread + 3 workers
+ *   pool.post(channel, data, length, timestampUs);
+ *   pool.run([&](const ChannelDispatchPool::Item& item) { handle(item); });
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oc::hal::midi {
+
+class ChannelDispatchPool {
+public:
+    /// One channel voice message (at most 3 bytes)
+    struct Item {
+        uint64_t timestampUs;
+        uint8_t bytes[3];
+        uint8_t length;
+    };
+
+    using Handler = std::function<void(const Item& item)>;
+
+    /// Most lanes useful (one per channel)
+    static constexpr size_t MAX_LANES = 16;
+
+    /// @param lanes Threads running handlers, the calling thread included (1-16)
+    explicit ChannelDispatchPool(size_t lanes);
+    ~ChannelDispatchPool();
+
+    ChannelDispatchPool(const ChannelDispatchPool&) = delete;
+    ChannelDispatchPool& operator=(const ChannelDispatchPool&) = delete;
+
+    size_t lanes() const { return batches_.size(); }
+
+    /// Queue one message of @p channel for the next run() (longer messages are truncated to 3 bytes)
+    void post(uint8_t channel, const uint8_t* data, size_t length, uint64_t timestampUs);
+
+    /// Messages posted since the last run()
+    size_t pending() const;
+
+    /// Run @p handler on every posted message and wait for all lanes
+    void run(const Handler& handler);
+
+private:
+    void workerLoop(size_t lane);
+    void runLane(size_t lane, const Handler& handler);
+
+    std::vector<std::vector<Item>> batches_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const Handler* handler_ = nullptr;
+    uint64_t generation_ = 0;
+    size_t remaining_ = 0;
+    bool stop_ = false;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,143 @@
+#include "ClockThru.hpp"
+
+#include <algorithm>
+
+namespace oc::hal::midi {
+
+ClockThru::ClockThru(const ClockThruConfig& config, Sink sink)
+    : config_(config), sink_(std::move(sink)), dll_(config.bandwidthHz) {
+    config_.divide = std::clamp<uint8_t>(config_.divide, 1, 96);
+    config_.multiply = std::clamp<uint8_t>(config_.multiply, 1, 24);
+    scheduled_ = config_.mode == ClockThruMode::Smoothed || config_.multiply > 1;
+    if (scheduled_) thread_ = std::thread([this] { run(); });
+}
+
+ClockThru::~ClockThru() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true, std::memory_order_relaxed);
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool ClockThru::handle(const uint8_t* data, size_t length, uint64_t timestampUs) {
+    if (length != 1) return false;
+    switch (data[0]) {
+        case 0xF8:
+            onTick(timestampUs);
+            return true;
+        case 0xFA:
+        case 0xFB:
+        case 0xFC:
+            onTransport(data[0], timestampUs);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ClockThru::onTick(uint64_t timestampUs) {
+    const double filteredUs = dll_.update(timestampUs);
+    period_us_.store(dll_.periodUs(), std::memory_order_relaxed);
+
+    if (tick_count_++ % config_.divide != 0) return;
+    if (!scheduled_) {
+        send(0xF8);
+        return;
+    }
+
+    const double baseUs = config_.mode == ClockThruMode::Smoothed
+                              ? filteredUs + config_.latencyUs
+                              : static_cast<double>(timestampUs);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        schedule(static_cast<uint64_t>(baseUs), 0xF8, false);
+
+        // Extra ticks need a period estimate; until then only the tick itself is sent.
+        if (config_.multiply > 1 && dll_.locked()) {
+            const double stepUs = dll_.periodUs() * config_.divide / config_.multiply;
+            for (uint8_t k = 1; k < config_.multiply; ++k) {
+                schedule(static_cast<uint64_t>(baseUs + k * stepUs), 0xF8, true);
+            }
+        }
+    }
+    cv_.notify_one();
+}
+
+void ClockThru::onTransport(uint8_t status, uint64_t timestampUs) {
+    if (status == 0xFA) tick_count_ = 0;  // Divided output restarts on the downbeat
+
+    if (!scheduled_) {
+        if (config_.forwardTransport) send(status);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        dropInterpolatedLocked();
+        if (config_.forwardTransport) {
+            const uint32_t delayUs =
+                config_.mode == ClockThruMode::Smoothed ? config_.latencyUs : 0;
+            schedule(timestampUs + delayUs, status, false);
+        }
+    }
+    cv_.notify_one();
+}
+
+void ClockThru::schedule(uint64_t deadlineUs, uint8_t status, bool interpolated) {
+    if (count_ == MAX_SCHEDULED) return;  // Scheduling thread stalled: drop
+
+    // Keep the ring ordered: a tick never overtakes one scheduled before it.
+    deadlineUs = std::max(deadlineUs, last_deadline_us_);
+    last_deadline_us_ = deadlineUs;
+    ring_[(head_ + count_) % MAX_SCHEDULED] = Scheduled{deadlineUs, status, interpolated};
+    ++count_;
+}
+
+void ClockThru::dropInterpolatedLocked() {
+    size_t kept = 0;
+    for (size_t i = 0; i < count_; ++i) {
+        const Scheduled entry = ring_[(head_ + i) % MAX_SCHEDULED];
+        if (!entry.interpolated) ring_[(head_ + kept++) % MAX_SCHEDULED] = entry;
+    }
+    if (kept == count_) return;
+
+    count_ = kept;
+    ++generation_;
+    // Entries already sent were due by now; dropped ones must not delay new ones.
+    last_deadline_us_ = kept > 0 ? ring_[(head_ + kept - 1) % MAX_SCHEDULED].deadlineUs
+                                 : std::min(last_deadline_us_, steadyNowUs());
+}
+
+void ClockThru::send(uint8_t status) {
+    sink_(&status, 1);
+    if (status == 0xF8) ticks_sent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ClockThru::run() {
+    if (config_.realtimePriority) raiseThreadPriority();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        cv_.wait(lock, [this] { return stop_.load(std::memory_order_relaxed) || count_ > 0; });
+        if (stop_.load(std::memory_order_relaxed)) return;
+
+        const Scheduled next = ring_[head_];
+        const uint64_t generation = generation_;
+        lock.unlock();
+        const bool reached = sleepUntilUs(next.deadlineUs, config_.spinUs, &stop_);
+        lock.lock();
+        if (!reached) return;
+        if (generation != generation_) continue;  // The entry may have been dropped
+
+        head_ = (head_ + 1) % MAX_SCHEDULED;
+        --count_;
+        lock.unlock();
+        jitter_.record(static_cast<int64_t>(steadyNowUs() - next.deadlineUs));
+        send(next.status);
+        lock.lock();
+    }
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,218 @@
+#pragma once
+
+/**
+ * @file ClockThru.hpp
+ * @brief Re-emit an external MIDI clock with low jitter, divided or multiplied
+ *
+ * Clock ticks (F8) are taken on the receive thread as they are framed, not
+ * from update(), so the re-emitted clock does not inherit the frame period
+ * as jitter. Two modes:
+ * - Immediate: each tick is sent from the receive thread as it arrives;
+ *   output jitter is the input jitter
+ * - Smoothed: tick times are filtered by a delay-locked loop (ClockDll) and
+ *   the ticks are sent from a scheduling thread at the filtered times plus a
+ *   fixed latency. Input jitter up to that latency is removed; tempo changes
+ *   are followed within about 1 / bandwidthHz seconds
+ *
+ * Output ticks = input ticks * multiply / divide. Divided output starts on
+ * the first tick after Start (FA), so it stays aligned to the song. Ticks
+ * added by multiplication are spread evenly over the estimated period, so
+ * they need the scheduling thread in either mode.
+ *
+ * Start, Stop and Continue are forwarded in order with the ticks; ticks
+ * added by multiplication that are still pending are dropped at that point.
+ *
+ * Usage:
+ *   ClockThruConfig config;
+ *   config.mode = ClockThruMode::Smoothed;
+ *   ClockThru thru(config, [&](const uint8_t* data, size_t length) { send(data, length); });
+ *   // Receive thread:
+ *   thru.handle(data, length, timestampUs);
+ */
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Timing.hpp"
+
+namespace oc::hal::midi {
+
+/**
+ * @brief Second-order delay-locked loop tracking a periodic event
+ *
+ * Each update() with the arrival time of one event returns its filtered
+ * time and predicts the next. The loop bandwidth is relative to the
+ * current period, so the response time in seconds does not depend on
+ * tempo. An error larger than one period (dropout, tempo jump) restarts
+ * the loop from that event.
+ */
+class ClockDll {
+public:
+    explicit ClockDll(double bandwidthHz = 1.0) : bandwidth_hz_(bandwidthHz) {}
+
+    void reset() { events_ = 0; }
+
+    /// @return Filtered time of this event, in microseconds
+    double update(uint64_t timeUs) {
+        const double t = static_cast<double>(timeUs);
+        if (events_ == 0) {
+            start(t);
+            return t;
+        }
+        if (events_ == 1) {
+            period_ = t - t0_;
+            if (period_ <= 0.0) {
+                start(t);
+                return t;
+            }
+            t0_ = t;
+            t1_ = t + period_;
+            events_ = 2;
+            return t;
+        }
+
+        const double error = t - t1_;
+        if (std::fabs(error) > period_) {
+            start(t);
+            return t;
+        }
+
+        const double omega = TWO_PI * bandwidth_hz_ * period_ * 1e-6;
+        t0_ = t1_;
+        t1_ += std::sqrt(2.0) * omega * error + period_;
+        period_ += omega * omega * error;
+        return t0_;
+    }
+
+    /// A period estimate is available (two events seen since the last restart)
+    bool locked() const { return events_ >= 2; }
+
+    /// Estimated period in microseconds (0 until locked)
+    double periodUs() const { return locked() ? period_ : 0.0; }
+
+    /// Predicted time of the next event
+    double nextUs() const { return t1_; }
+
+private:
+    static constexpr double TWO_PI = 6.283185307179586;
+
+    void start(double t) {
+        t0_ = t;
+        t1_ = t;
+        period_ = 0.0;
+        events_ = 1;
+    }
+
+    double bandwidth_hz_;
+    double t0_ = 0.0;
+    double t1_ = 0.0;
+    double period_ = 0.0;
+    uint32_t events_ = 0;
+};
+
+enum class ClockThruMode : uint8_t {
+    Immediate,  ///< Send each tick from the receive thread
+    Smoothed    ///< Send DLL-filtered ticks from a scheduling thread
+};
+
+struct ClockThruConfig {
+    ClockThruMode mode = ClockThruMode::Immediate;
+
+    /// Send one tick per @p divide input ticks (1-96)
+    uint8_t divide = 1;
+
+    /// Send @p multiply ticks per (divided) input tick (1-24)
+    uint8_t multiply = 1;
+
+    /// Loop bandwidth: lower is smoother but follows tempo changes slower
+    double bandwidthHz = 1.0;
+
+    /// Smoothed: delay added to every tick; absorbs input jitter up to this
+    uint32_t latencyUs = 2000;
+
+    /// Forward Start / Stop / Continue in order with the ticks
+    bool forwardTransport = true;
+
+    /// Spin window before each deadline (see sleepUntilUs)
+    uint32_t spinUs = DEFAULT_SPIN_US;
+
+    /// Try to run the scheduling thread with realtime priority
+    bool realtimePriority = true;
+};
+
+class ClockThru {
+public:
+    /// Receives one realtime message per call (receive or scheduling thread)
+    using Sink = std::function<void(const uint8_t* data, size_t length)>;
+
+    ClockThru(const ClockThruConfig& config, Sink sink);
+    ~ClockThru();
+
+    // Non-copyable, non-movable (owns a thread referencing this)
+    ClockThru(const ClockThru&) = delete;
+    ClockThru& operator=(const ClockThru&) = delete;
+
+    /**
+     * @brief Offer one framed input message (receive thread only)
+     * @return true if it was clock or transport (F8, FA, FB, FC)
+     */
+    bool handle(const uint8_t* data, size_t length, uint64_t timestampUs);
+
+    /// Estimated input tick period in microseconds, 0 until two ticks are seen
+    double periodUs() const { return period_us_.load(std::memory_order_relaxed); }
+
+    /// Ticks sent (after division / multiplication)
+    uint64_t ticksSent() const { return ticks_sent_.load(std::memory_order_relaxed); }
+
+    /// Lateness of the scheduled sends (empty when nothing is scheduled)
+    JitterStats jitter() const { return jitter_.stats(); }
+
+private:
+    struct Scheduled {
+        uint64_t deadlineUs;
+        uint8_t status;
+        bool interpolated;  ///< Added by multiplication
+    };
+
+    static constexpr size_t MAX_SCHEDULED = 64;
+
+    void onTick(uint64_t timestampUs);
+    void onTransport(uint8_t status, uint64_t timestampUs);
+    void schedule(uint64_t deadlineUs, uint8_t status, bool interpolated);
+    void dropInterpolatedLocked();
+    void send(uint8_t status);
+    void run();
+
+    ClockThruConfig config_;
+    Sink sink_;
+    bool scheduled_ = false;  ///< Sends go through the scheduling thread
+
+    // Receive thread only
+    ClockDll dll_;
+    uint32_t tick_count_ = 0;  ///< Input ticks since Start
+
+    std::atomic<double> period_us_{0.0};
+    std::atomic<uint64_t> ticks_sent_{0};
+    JitterMeter jitter_;
+
+    // Deadline-ordered ring shared with the scheduling thread
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::array<Scheduled, MAX_SCHEDULED> ring_{};
+    size_t head_ = 0;
+    size_t count_ = 0;
+    uint64_t last_deadline_us_ = 0;
+    uint64_t generation_ = 0;  ///< Bumped when entries are removed
+
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file ControllerState.hpp
+ * @brief Current value of every controller, readable from any thread
+ *
+ * Consumers that only need "where is CC 74 on channel 3 now" read this
+ * table instead of registering a callback and keeping shadow state. Per
+ * channel it holds the 128 CC values, held notes (velocity, 0 = released),
+ * poly pressure, channel pressure, pitch bend and last program.
+ *
+ * One writer (the receive path) calls apply() for each decoded event. Any
+ * number of readers, on any thread:
+ * - Single values (cc(), noteVelocity(), pitchBend(), ...) are one relaxed
+ *   atomic load: wait-free, never blocked by the writer
+ * - snapshot() copies one channel consistently under a per-channel seqlock,
+ *   retrying only if the writer touched that channel during the copy
+ * - version() changes whenever a channel changes, for cheap polling
+ *
+ * All Sound Off (CC 120) and All Notes Off (CC 123) release the channel's
+ * notes; System Reset restores every default.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "MidiEvent.hpp"
+
+namespace oc::hal::midi {
+
+/// Plain copy of one channel, filled by ControllerState::snapshot()
+struct ChannelState {
+    uint8_t cc[128];
+    uint8_t noteVelocity[128];  ///< 0 = not held
+    uint8_t polyPressure[128];
+    uint16_t pitchBend;         ///< Raw 14-bit value, 8192 = centre
+    uint8_t channelPressure;
+    uint8_t program;            ///< ControllerState::NO_PROGRAM until received
+
+    bool noteHeld(uint8_t note) const { return noteVelocity[note & 0x7F] != 0; }
+};
+
+class ControllerState {
+public:
+    static constexpr uint8_t NO_PROGRAM = 0xFF;
+    static constexpr uint16_t PITCH_BEND_CENTER = 8192;
+
+    ControllerState() { reset(); }
+
+    ControllerState(const ControllerState&) = delete;
+    ControllerState& operator=(const ControllerState&) = delete;
+
+    /// Writer only. @return true if the event changed controller state
+    bool apply(const MidiEvent& event) {
+        switch (event.type) {
+            case MidiEventType::NoteOn:
+                write(event.channel, [&](Channel& ch) {
+                    store(ch.noteVelocity[event.data1 & 0x7F], event.data2);
+                });
+                return true;
+            case MidiEventType::NoteOff:
+                write(event.channel,
+                      [&](Channel& ch) { store(ch.noteVelocity[event.data1 & 0x7F], 0); });
+                return true;
+            case MidiEventType::PolyPressure:
+                write(event.channel, [&](Channel& ch) {
+                    store(ch.polyPressure[event.data1 & 0x7F], event.data2);
+                });
+                return true;
+            case MidiEventType::ControlChange:
+                write(event.channel, [&](Channel& ch) {
+                    store(ch.cc[event.data1 & 0x7F], event.data2);
+                    if (event.data1 == 120 || event.data1 == 123) {
+                        for (auto& note : ch.noteVelocity) store(note, 0);
+                    }
+                });
+                return true;
+            case MidiEventType::ProgramChange:
+                write(event.channel, [&](Channel& ch) { store(ch.program, event.data1); });
+                return true;
+            case MidiEventType::ChannelPressure:
+                write(event.channel, [&](Channel& ch) { store(ch.channelPressure, event.data1); });
+                return true;
+            case MidiEventType::PitchBend:
+                write(event.channel, [&](Channel& ch) { store(ch.pitchBend, event.value14); });
+                return true;
+            case MidiEventType::SystemReset:
+                reset();
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// Writer only: restore defaults on every channel
+    void reset() {
+        for (uint8_t channel = 0; channel < 16; ++channel) {
+            write(channel, [](Channel& ch) {
+                for (size_t i = 0; i < 128; ++i) {
+                    store(ch.cc[i], 0);
+                    store(ch.noteVelocity[i], 0);
+                    store(ch.polyPressure[i], 0);
+                }
+                store(ch.pitchBend, PITCH_BEND_CENTER);
+                store(ch.channelPressure, 0);
+                store(ch.program, NO_PROGRAM);
+            });
+        }
+    }
+
+    uint8_t cc(uint8_t channel, uint8_t controller) const {
+        return load(channels_[channel & 0x0F].cc[controller & 0x7F]);
+    }
+
+    uint8_t noteVelocity(uint8_t channel, uint8_t note) const {
+        return load(channels_[channel & 0x0F].noteVelocity[note & 0x7F]);
+    }
+
+    bool noteHeld(uint8_t channel, uint8_t note) const { return noteVelocity(channel, note) != 0; }
+
+    uint8_t polyPressure(uint8_t channel, uint8_t note) const {
+        return load(channels_[channel & 0x0F].polyPressure[note & 0x7F]);
+    }
+
+    uint16_t pitchBend(uint8_t channel) const { return load(channels_[channel & 0x0F].pitchBend); }
+
+    uint8_t channelPressure(uint8_t channel) const {
+        return load(channels_[channel & 0x0F].channelPressure);
+    }
+
+    uint8_t program(uint8_t channel) const { return load(channels_[channel & 0x0F].program); }
+
+    /// Even, and different after every change to @p channel
+    uint32_t version(uint8_t channel) const {
+        return channels_[channel & 0x0F].sequence.load(std::memory_order_acquire) & ~1u;
+    }
+
+    /// Consistent copy of one channel
+    void snapshot(uint8_t channel, ChannelState& out) const {
+        const Channel& ch = channels_[channel & 0x0F];
+        for (;;) {
+            const uint32_t before = ch.sequence.load(std::memory_order_acquire);
+            if (before & 1u) continue;  // Write in progress
+
+            for (size_t i = 0; i < 128; ++i) {
+                out.cc[i] = load(ch.cc[i]);
+                out.noteVelocity[i] = load(ch.noteVelocity[i]);
+                out.polyPressure[i] = load(ch.polyPressure[i]);
+            }
+            out.pitchBend = load(ch.pitchBend);
+            out.channelPressure = load(ch.channelPressure);
+            out.program = load(ch.program);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (ch.sequence.load(std::memory_order_relaxed) == before) return;
+        }
+    }
+
+private:
+    // Every field is atomic so concurrent reads are defined; relaxed
+    // accesses compile to plain loads and stores on common targets.
+    struct alignas(64) Channel {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint8_t> cc[128];
+        std::atomic<uint8_t> noteVelocity[128];
+        std::atomic<uint8_t> polyPressure[128];
+        std::atomic<uint16_t> pitchBend;
+        std::atomic<uint8_t> channelPressure;
+        std::atomic<uint8_t> program;
+    };
+
+    template <typename T, typename V>
+    static void store(std::atomic<T>& field, V value) {
+        field.store(static_cast<T>(value), std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    static T load(const std::atomic<T>& field) {
+        return field.load(std::memory_order_relaxed);
+    }
+
+    // Seqlock write: odd sequence while the channel is being modified.
+    template <typename Fn>
+    void write(uint8_t channel, Fn&& fn) {
+        Channel& ch = channels_[channel & 0x0F];
+        const uint32_t seq = ch.sequence.load(std::memory_order_relaxed);
+        ch.sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fn(ch);
+        ch.sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    Channel channels_[16];
+};
+
+}  // namespace oc::hal::midi
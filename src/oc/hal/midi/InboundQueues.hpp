@@ -0,0 +1,296 @@
+#pragma once
+
+/**
+ * @file InboundQueues.hpp
+ * @brief Inbound message queues split by traffic class, drained by priority
+ *
+ * With a single FIFO, a long SysEx transfer or a controller flood delays
+ * every note and clock queued behind it. Here each traffic class has its
+ * own bounded queue:
+ * - Realtime: clock, transport, MTC and other system common messages
+ * - ChannelVoice: notes, controllers, pressure, program, pitch bend
+ * - SysEx: whole SysEx and SysEx chunks
+ *
+ * Each queue has its own capacity and drop policy (drop the newest item,
+ * or make room by dropping the oldest). drain() empties the queues one
+ * class after the other in the configured priority order: order is kept
+ * within a class, not across classes.
+ *
+ * Storage per class is a small preallocated ring (ringSize) plus a spill
+ * area for bursts beyond it, both bounded by the capacity:
+ * - Steady traffic stays in the ring: no allocation, small footprint
+ * - A burst (preset recall, SysEx dump) continues into the spill vector
+ * - At each drain, a spill peak above the high watermark of its reserve
+ *   grows the reserve until that peak sits below the watermark, so the next
+ *   burst of that size does not allocate on the receive thread; after
+ *   spillShrinkAfter drains with peaks below the low watermark the reserve
+ *   is halved, down to nothing
+ * - A full DropOldest queue refills its ring from the spill without
+ *   shifting it; consumed spill slots are compacted lazily, so the spill
+ *   storage may reach twice the capacity between drains
+ *
+ * Per-class counters and a latency meter (queue time, recorded by the
+ * consumer with recordLatency()) are kept alongside.
+ *
+ * Usage:
+ *   InboundQueues<Message> queues(config);
+ *   queues.push(midiTrafficClass(status), std::move(message));   // any thread
+ *   queues.drain(batch);                                        // consumer
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Timing.hpp"
+
+namespace oc::hal::midi {
+
+enum class MidiTrafficClass : uint8_t {
+    Realtime = 0,
+    ChannelVoice = 1,
+    SysEx = 2
+};
+
+inline constexpr size_t MIDI_TRAFFIC_CLASS_COUNT = 3;
+
+/// Class of a message from its status byte
+inline MidiTrafficClass midiTrafficClass(uint8_t status) {
+    if (status < 0xF0) return MidiTrafficClass::ChannelVoice;
+    if (status == 0xF0 || status == 0xF7) return MidiTrafficClass::SysEx;
+    return MidiTrafficClass::Realtime;
+}
+
+enum class QueueDropPolicy : uint8_t {
+    DropNewest,  ///< A full queue refuses new items
+    DropOldest   ///< A full queue drops its oldest item to take the new one
+};
+
+struct TrafficClassConfig {
+    /// Items held (ring + spill) before the drop policy applies
+    size_t capacity;
+
+    QueueDropPolicy drop = QueueDropPolicy::DropNewest;
+
+    /// Preallocated ring; items beyond it go to the spill area
+    size_t ringSize = 64;
+};
+
+struct InboundQueueConfig {
+    TrafficClassConfig realtime{1024};
+    TrafficClassConfig channelVoice{4096, QueueDropPolicy::DropNewest, 256};
+    TrafficClassConfig sysex{256, QueueDropPolicy::DropNewest, 16};
+
+    /// Drain order, highest priority first (each class once)
+    std::array<MidiTrafficClass, MIDI_TRAFFIC_CLASS_COUNT> order = {
+        MidiTrafficClass::Realtime, MidiTrafficClass::ChannelVoice, MidiTrafficClass::SysEx};
+
+    /// Spill peak, as a fraction of the spill reserve, that grows the reserve
+    float spillHighWatermark = 0.75f;
+
+    /// Spill peak below which a drain counts as quiet
+    float spillLowWatermark = 0.25f;
+
+    /// Consecutive quiet drains before the spill reserve is halved
+    uint32_t spillShrinkAfter = 256;
+};
+
+/// Counters of one traffic class
+struct InboundQueueStats {
+    uint64_t queued = 0;
+    uint64_t dropped = 0;
+    uint64_t spilled = 0;      ///< Items that did not fit in the ring
+    size_t highWater = 0;      ///< Most items held at once
+    size_t spillReserve = 0;   ///< Spill slots currently allocated
+    JitterStats latency;       ///< Queue time in microseconds, as recorded by the consumer
+};
+
+template <typename T>
+class InboundQueues {
+public:
+    explicit InboundQueues(const InboundQueueConfig& config)
+        : order_(config.order),
+          high_watermark_(config.spillHighWatermark),
+          low_watermark_(config.spillLowWatermark),
+          shrink_after_(config.spillShrinkAfter) {
+        // A class missing from the order would never be drained.
+        uint32_t seen = 0;
+        for (MidiTrafficClass cls : order_) seen |= 1u << index(cls);
+        if (seen != (1u << MIDI_TRAFFIC_CLASS_COUNT) - 1) order_ = InboundQueueConfig{}.order;
+
+        const TrafficClassConfig* classes[] = {&config.realtime, &config.channelVoice,
+                                               &config.sysex};
+        for (size_t i = 0; i < MIDI_TRAFFIC_CLASS_COUNT; ++i) {
+            Queue& queue = queues_[i];
+            queue.capacity = std::max<size_t>(classes[i]->capacity, 1);
+            queue.drop = classes[i]->drop;
+            queue.ring.resize(std::clamp<size_t>(classes[i]->ringSize, 1, queue.capacity));
+        }
+    }
+
+    InboundQueues(const InboundQueues&) = delete;
+    InboundQueues& operator=(const InboundQueues&) = delete;
+
+    /**
+     * @brief Queue one item (any thread)
+     * @return false if @p item was dropped (DropNewest and full)
+     */
+    bool push(MidiTrafficClass cls, T&& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Queue& queue = queues_[index(cls)];
+        if (queue.size() >= queue.capacity) {
+            ++queue.dropped;
+            if (queue.drop == QueueDropPolicy::DropNewest) return false;
+            dropOldest(queue);
+        }
+        place(queue, std::move(item));
+        return true;
+    }
+
+    /// Queue one item past the capacity (end markers that must not be lost)
+    void force(MidiTrafficClass cls, T&& item) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        place(queues_[index(cls)], std::move(item));
+    }
+
+    /// Consumer: append every queued item to @p out, class by class in priority order
+    void drain(std::vector<T>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (MidiTrafficClass cls : order_) {
+            Queue& queue = queues_[index(cls)];
+            for (size_t i = 0; i < queue.count; ++i) {
+                out.push_back(std::move(queue.ring[(queue.head + i) % queue.ring.size()]));
+            }
+            for (size_t i = queue.spillHead; i < queue.spill.size(); ++i) {
+                out.push_back(std::move(queue.spill[i]));
+            }
+            queue.head = 0;
+            queue.count = 0;
+            queue.spill.clear();
+            queue.spillHead = 0;
+            adaptSpill(queue);
+        }
+    }
+
+    /// Consumer only: time one item of @p cls spent queued
+    void recordLatency(MidiTrafficClass cls, uint64_t latencyUs) {
+        latency_[index(cls)].record(static_cast<int64_t>(latencyUs));
+    }
+
+    InboundQueueStats stats(MidiTrafficClass cls) const {
+        InboundQueueStats out;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const Queue& queue = queues_[index(cls)];
+            out.queued = queue.queued;
+            out.dropped = queue.dropped;
+            out.spilled = queue.spilled;
+            out.highWater = queue.highWater;
+            out.spillReserve = queue.spill.capacity();
+        }
+        out.latency = latency_[index(cls)].stats();
+        return out;
+    }
+
+private:
+    struct Queue {
+        // Oldest items are in the ring; once anything spills, newer items
+        // follow in the spill vector until the next drain. Spill items
+        // before spillHead were already moved back into the ring.
+        std::vector<T> ring;
+        size_t head = 0;
+        size_t count = 0;
+        std::vector<T> spill;
+        size_t spillHead = 0;
+        size_t capacity = 1;
+        QueueDropPolicy drop = QueueDropPolicy::DropNewest;
+        uint64_t queued = 0;
+        uint64_t dropped = 0;
+        uint64_t spilled = 0;
+        size_t highWater = 0;
+        size_t spillPeak = 0;  ///< Since the last drain
+        uint32_t quietDrains = 0;
+
+        size_t size() const { return count + spill.size() - spillHead; }
+    };
+
+    static size_t index(MidiTrafficClass cls) { return static_cast<size_t>(cls); }
+
+    static void place(Queue& queue, T&& item) {
+        if (queue.spill.empty() && queue.count < queue.ring.size()) {
+            queue.ring[(queue.head + queue.count) % queue.ring.size()] = std::move(item);
+            ++queue.count;
+        } else {
+            queue.spill.push_back(std::move(item));
+            ++queue.spilled;
+            queue.spillPeak = std::max(queue.spillPeak, queue.spill.size());
+        }
+        ++queue.queued;
+        queue.highWater = std::max(queue.highWater, queue.size());
+    }
+
+    static void dropOldest(Queue& queue) {
+        if (queue.count == 0) refill(queue);
+        queue.head = (queue.head + 1) % queue.ring.size();
+        --queue.count;
+    }
+
+    // Ring empty, spill not: move the oldest spill items back into the
+    // ring, so a saturated DropOldest queue keeps cycling through it.
+    static void refill(Queue& queue) {
+        const size_t n = std::min(queue.ring.size(), queue.spill.size() - queue.spillHead);
+        for (size_t i = 0; i < n; ++i) {
+            queue.ring[i] = std::move(queue.spill[queue.spillHead + i]);
+        }
+        queue.spillHead += n;
+        queue.head = 0;
+        queue.count = n;
+
+        // Moved-out items are compacted away once they outnumber the live
+        // ones: each compaction moves fewer items than were refilled since
+        // the last, and the spill stays within twice its live size.
+        if (queue.spillHead == queue.spill.size()) {
+            queue.spill.clear();
+            queue.spillHead = 0;
+        } else if (queue.spillHead > queue.spill.size() / 2) {
+            queue.spill.erase(queue.spill.begin(),
+                              queue.spill.begin() + static_cast<std::ptrdiff_t>(queue.spillHead));
+            queue.spillHead = 0;
+        }
+    }
+
+    // Consumer side, spill empty: size the reserve for the next burst.
+    void adaptSpill(Queue& queue) {
+        const size_t peak = queue.spillPeak;
+        const size_t reserve = queue.spill.capacity();
+        queue.spillPeak = 0;
+
+        if (peak > 0 && peak >= reserve * high_watermark_) {
+            const auto target = static_cast<size_t>(peak / std::max(high_watermark_, 0.01f)) + 1;
+            queue.spill.reserve(std::min(target, queue.capacity));
+            queue.quietDrains = 0;
+        } else if (reserve > 0 && peak <= reserve * low_watermark_) {
+            if (++queue.quietDrains < shrink_after_) return;
+            queue.quietDrains = 0;
+            std::vector<T> smaller;
+            if (reserve / 2 >= queue.ring.size()) smaller.reserve(reserve / 2);
+            queue.spill.swap(smaller);
+        } else {
+            queue.quietDrains = 0;
+        }
+    }
+
+    std::array<MidiTrafficClass, MIDI_TRAFFIC_CLASS_COUNT> order_;
+    float high_watermark_;
+    float low_watermark_;
+    uint32_t shrink_after_;
+    mutable std::mutex mutex_;
+    std::array<Queue, MIDI_TRAFFIC_CLASS_COUNT> queues_;
+    std::array<JitterMeter, MIDI_TRAFFIC_CLASS_COUNT> latency_;
+};
+
+}  // namespace oc::hal::midi
@@ -1,20 +1,32 @@
 #include "LibreMidiTransport.hpp"
 
-#include <chrono>
+#include <cstring>
+
 #include <libremidi/libremidi.hpp>
-#ifdef __EMSCRIPTEN__
 #include <libremidi/configurations.hpp>
-#endif
 #include <oc/log/Log.hpp>
 
+#include "SysExPacking.hpp"
+#include "Timing.hpp"
+
 namespace oc::hal::midi {
 
 namespace {
 
-uint64_t nowSteadyUs() {
-    const auto now = std::chrono::steady_clock::now().time_since_epoch();
-    return static_cast<uint64_t>(
-        std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+InboundQueueConfig inboundQueueConfig(const LibreMidiConfig& config) {
+    InboundQueueConfig queues = config.inboundQueues;
+    // Chunk loss is reported by ending the SysEx with Abort: a chunk must
+    // never disappear from the middle of the queue.
+    if (config.sysexChunkSize > 0) queues.sysex.drop = QueueDropPolicy::DropNewest;
+    return queues;
+}
+
+LibreMidiConfig platformConfig(const LibreMidiConfig& config) {
+    LibreMidiConfig out = config;
+#ifdef __EMSCRIPTEN__
+    out.useUmp = false;  // WebMIDI has no UMP backend
+#endif
+    return out;
 }
 
 }  // namespace
@@ -22,9 +34,21 @@ uint64_t nowSteadyUs() {
 LibreMidiTransport::LibreMidiTransport() : LibreMidiTransport(LibreMidiConfig{}) {}
 
 LibreMidiTransport::LibreMidiTransport(const LibreMidiConfig& config)
-    : config_(config) {}
-
-LibreMidiTransport::~LibreMidiTransport() = default;
+    : config_(platformConfig(config)),
+      tx_dedup_(config.sysexDedup),
+      rx_queues_(inboundQueueConfig(config)),
+      rx_chunk_pool_(config.sysexChunkSize > 0 ? config.inboundQueues.sysex.capacity : 0),
+      rx_ump_queue_(config_.useUmp ? config.umpQueueCapacity : 1),
+      tx_midi1_to_ump_(config.umpGroup, config.umpMidi2Protocol),
+      tx_mirror_(config.outputMirror),
+      rx_assembler_(config.parameterAssembler) {}
+
+LibreMidiTransport::~LibreMidiTransport() {
+    // Input feeds the clock thru thread, which sends to midi_out_: stop both
+    // before the output and its mutex go away.
+    midi_in_.reset();
+    rx_clock_thru_.reset();
+}
 
 oc::type::Result<void> LibreMidiTransport::init() {
     if (initialized_) {
@@ -37,6 +61,38 @@ oc::type::Result<void> LibreMidiTransport::init() {
         note.active = false;
     }
 
+    // Inbound SysEx reassembly buffer (the parser never allocates). With
+    // chunking enabled it only needs to hold one fragment; a limit that fits
+    // sizes it exactly, anything larger goes to rx_sysex_large_.
+    size_t sysexBuffer = config_.sysexBufferSize;
+    if (config_.sysexChunkSize > 0) {
+        sysexBuffer = config_.sysexChunkSize;
+    } else if (config_.maxSysExSize > 0 && config_.maxSysExSize < sysexBuffer) {
+        sysexBuffer = config_.maxSysExSize;
+    }
+    rx_sysex_buffer_.resize(sysexBuffer);
+    rx_parser_.setSysExBuffer(rx_sysex_buffer_.data(), rx_sysex_buffer_.size());
+
+    // SysEx7 reassembly buffers for UMP <-> MIDI 1.0 translation (fixed size)
+    const size_t umpSysEx =
+        config_.maxSysExSize > 0 ? config_.maxSysExSize : config_.sysexBufferSize;
+    rx_ump_sysex_.resize(config_.useUmp ? umpSysEx : 0);
+    rx_ump_to_midi1_.setSysExBuffer(rx_ump_sysex_.data(), rx_ump_sysex_.size());
+    tx_ump_sysex_.resize(umpSysEx);
+    tx_ump_to_midi1_.setSysExBuffer(tx_ump_sysex_.data(), tx_ump_sysex_.size());
+
+    if (config_.dispatchThreads > 1) {
+        rx_dispatch_pool_ = std::make_unique<ChannelDispatchPool>(config_.dispatchThreads);
+    }
+
+    if (config_.forwardClock) {
+        rx_clock_thru_ = std::make_unique<ClockThru>(
+            config_.clockThru, [this](const uint8_t* data, size_t length) {
+                std::lock_guard<std::mutex> lock(output_mutex_);
+                if (midi_out_ && midi_out_->is_port_connected()) writeLocked(data, length);
+            });
+    }
+
     try {
 #ifdef __EMSCRIPTEN__
         // ═══════════════════════════════════════════════════════════════
@@ -77,25 +133,13 @@ oc::type::Result<void> LibreMidiTransport::init() {
         // We need realtime clock / transport for external sync.
         in_config.ignore_timing = false;
         in_config.on_message = [this](libremidi::message&& msg) {
-            if (msg.bytes.empty()) return;
-
-            PendingMessage pending{};
-            pending.timestampUs = nowSteadyUs();
-            pending.bytes = std::move(msg.bytes);
-
-            std::lock_guard<std::mutex> lock(pending_mutex_);
-            if (pending_messages_.size() >= max_pending_messages_) {
-                // Drop newest to keep bounded memory.
-                return;
-            }
-            pending_messages_.push_back(std::move(pending));
+            handleIncoming(std::move(msg));
         };
 
 #if defined(__APPLE__)
         if (config_.useVirtualPorts) {
             // macOS: CoreMIDI virtual ports (native support)
-            midi_in_ = std::make_unique<libremidi::midi_in>(in_config);
-            midi_out_ = std::make_unique<libremidi::midi_out>();
+            createPorts(in_config);
 
             if (!config_.inputPortName.empty()) {
                 midi_in_->open_virtual_port(config_.inputPortName);
@@ -113,17 +157,19 @@ oc::type::Result<void> LibreMidiTransport::init() {
             // Connect to existing ports
             // Linux: VirMIDI kernel ports (via snd-virmidi module)
             // Windows: loopMIDI virtual ports
-            midi_in_ = std::make_unique<libremidi::midi_in>(in_config);
-            midi_out_ = std::make_unique<libremidi::midi_out>();
+            createPorts(in_config);
 
             // Configure observer to see both hardware and virtual ports
             libremidi::observer_configuration obs_config;
             obs_config.track_hardware = true;
             obs_config.track_virtual = true;  // Needed for VirMIDI/loopMIDI
-            libremidi::observer obs{obs_config};
+            auto obs = config_.useUmp
+                ? std::make_unique<libremidi::observer>(
+                      obs_config, libremidi::midi2::observer_default_configuration())
+                : std::make_unique<libremidi::observer>(obs_config);
 
-            auto in_ports = obs.get_input_ports();
-            auto out_ports = obs.get_output_ports();
+            auto in_ports = obs->get_input_ports();
+            auto out_ports = obs->get_output_ports();
 
             OC_LOG_INFO("MIDI: Found {} input ports, {} output ports", in_ports.size(), out_ports.size());
 
@@ -176,75 +222,378 @@ oc::type::Result<void> LibreMidiTransport::init() {
     return oc::type::Result<void>::ok();
 }
 
+void LibreMidiTransport::createPorts(const libremidi::input_configuration& inConfig) {
+#ifndef __EMSCRIPTEN__
+    if (config_.useUmp) {
+        libremidi::ump_input_configuration umpConfig;
+        umpConfig.ignore_timing = false;
+        umpConfig.on_message = [this](libremidi::ump&& packet) {
+            handleIncomingUmp(packet);
+        };
+        midi_in_ = std::make_unique<libremidi::midi_in>(
+            umpConfig, libremidi::midi2::in_default_configuration());
+        midi_out_ = std::make_unique<libremidi::midi_out>(
+            libremidi::output_configuration{}, libremidi::midi2::out_default_configuration());
+        return;
+    }
+#endif
+    midi_in_ = std::make_unique<libremidi::midi_in>(inConfig);
+    midi_out_ = std::make_unique<libremidi::midi_out>();
+}
+
+void LibreMidiTransport::handleIncomingUmp(const libremidi::ump& packet) {
+    RxPacket rx{};
+    rx.timestampUs = steadyNowUs();
+    for (size_t i = 0; i < 4; ++i) rx.packet.words[i] = packet.data[i];
+
+    // System realtime (type 1): clock thru runs here, not in drainUmp().
+    if (rx_clock_thru_ && (packet.data[0] >> 28) == 0x1) {
+        const uint8_t status = static_cast<uint8_t>(packet.data[0] >> 16);
+        rx_clock_thru_->handle(&status, 1, rx.timestampUs);
+    }
+
+    // Full ring: drop newest, like the byte queue.
+    if (!rx_ump_queue_.push(rx)) rx_ump_dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LibreMidiTransport::drainUmp() {
+    RxPacket rx;
+    while (rx_ump_queue_.pop(rx)) {
+        if (ump_dispatcher_.dispatch(rx.packet)) continue;
+        rx_ump_to_midi1_.convert(rx.packet, [&](const uint8_t* data, size_t length) {
+            uint8_t edited[3];
+            if (!rx_transform_.empty()) {
+                data = transformIncoming(data, length, edited);
+                if (!data) return;
+            }
+            if (!rx_thru_.empty()) forwardThru(data, length);
+            // Same filtering and traffic-class queues as the byte path,
+            // drained right after this in update().
+            if (filterIncoming(data, length, rx.timestampUs)) {
+                enqueueIncoming(std::vector<uint8_t>(data, data + length), rx.timestampUs);
+            }
+        });
+    }
+}
+
+void LibreMidiTransport::handleIncoming(libremidi::message&& msg) {
+    if (msg.bytes.empty()) return;
+    const uint64_t timestampUs = steadyNowUs();
+
+    // Most backends deliver exactly one complete message per callback: keep
+    // the backend's vector in that case. Anything else (running status,
+    // several messages per callback, SysEx split across callbacks) is
+    // re-framed by the parser and copied per message.
+    bool whole = false;
+    auto onMessage = [&](const uint8_t* data, size_t length) {
+        if (rx_clock_thru_) rx_clock_thru_->handle(data, length, timestampUs);
+        uint8_t edited[3];
+        if (!rx_transform_.empty()) {
+            data = transformIncoming(data, length, edited);
+            if (!data) return;
+        }
+        if (!rx_thru_.empty()) forwardThru(data, length);
+        if (!filterIncoming(data, length, timestampUs)) return;
+        if (data != edited && length == msg.bytes.size() && data[0] == msg.bytes[0]) {
+            whole = true;
+            return;
+        }
+        enqueueIncoming(std::vector<uint8_t>(data, data + length), timestampUs);
+    };
+
+    if (config_.sysexChunkSize > 0) {
+        rx_parser_.parse(msg.bytes.data(), msg.bytes.size(), onMessage,
+                         [&](SysExChunkPhase phase, const uint8_t* data, size_t length) {
+                             if (phase == SysExChunkPhase::Begin) rx_chunk_lost_ = false;
+                             if (rx_chunk_lost_) return;
+
+                             PendingMessage pending{};
+                             pending.timestampUs = timestampUs;
+                             pending.kind = PendingMessage::Kind::SysExChunk;
+                             pending.chunkPhase = phase;
+                             if (phase != SysExChunkPhase::Abort) {
+                                 std::lock_guard<std::mutex> lock(rx_chunk_pool_mutex_);
+                                 pending.bytes = rx_chunk_pool_.acquire(data, length);
+                             }
+                             if (enqueuePending(std::move(pending))) return;
+
+                             // Queue full: the consumer must not see a SysEx
+                             // with a hole in it, so end this one with Abort.
+                             rx_chunk_lost_ = true;
+                             if (phase == SysExChunkPhase::Begin) return;
+                             PendingMessage abort{};
+                             abort.timestampUs = timestampUs;
+                             abort.kind = PendingMessage::Kind::SysExChunk;
+                             abort.chunkPhase = SysExChunkPhase::Abort;
+                             rx_queues_.force(MidiTrafficClass::SysEx, std::move(abort));
+                         });
+    } else if (config_.maxSysExSize == 0 || config_.maxSysExSize > rx_sysex_buffer_.size()) {
+        // SysEx beyond the preallocated buffer: collect the parser's
+        // fragments in a growable buffer and deliver the whole message.
+        rx_parser_.parse(msg.bytes.data(), msg.bytes.size(), onMessage,
+                         [&](SysExChunkPhase phase, const uint8_t* data, size_t length) {
+                             if (phase == SysExChunkPhase::Begin) {
+                                 rx_sysex_large_.clear();
+                                 rx_sysex_too_large_ = false;
+                             }
+                             if (phase == SysExChunkPhase::Abort || rx_sysex_too_large_) return;
+                             if (config_.maxSysExSize > 0 &&
+                                 rx_sysex_large_.size() + length > config_.maxSysExSize) {
+                                 rx_sysex_too_large_ = true;
+                                 return;
+                             }
+                             rx_sysex_large_.insert(rx_sysex_large_.end(), data, data + length);
+                             if (phase == SysExChunkPhase::End) {
+                                 onMessage(rx_sysex_large_.data(), rx_sysex_large_.size());
+                             }
+                         });
+    } else {
+        rx_parser_.parse(msg.bytes.data(), msg.bytes.size(), onMessage);
+    }
+
+    if (whole) {
+        enqueueIncoming(std::move(msg.bytes), timestampUs);
+    }
+}
+
+const uint8_t* LibreMidiTransport::transformIncoming(const uint8_t* data, size_t length,
+                                                     uint8_t* edited) const {
+    // Only SysEx is longer than 3 bytes; stages never edit it.
+    if (length > 3) return rx_transform_.passes(MidiEventType::SysEx) ? data : nullptr;
+
+    std::memcpy(edited, data, length);
+    if (!rx_transform_.apply(edited, length)) return nullptr;
+    return std::memcmp(edited, data, length) == 0 ? data : edited;
+}
+
+void LibreMidiTransport::forwardThru(const uint8_t* data, size_t length) {
+    // Clock thru already sends these to this output; routes with their own
+    // sink still get them.
+    const bool clockedHere =
+        rx_clock_thru_ && length == 1 &&
+        (data[0] == 0xF8 ||
+         (config_.clockThru.forwardTransport && data[0] >= 0xFA && data[0] <= 0xFC));
+
+    // Locked per send: a route's own sink may be this transport's sendMessage().
+    rx_thru_.forward(data, length, [this, clockedHere](const uint8_t* out, size_t outLength) {
+        if (clockedHere) return;
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (midi_out_ && midi_out_->is_port_connected()) writeLocked(out, outLength);
+    });
+}
+
+bool LibreMidiTransport::filterIncoming(const uint8_t* data, size_t length,
+                                        uint64_t timestampUs) {
+    MidiEvent event;
+    if (!decodeMidiEvent(data, length, event)) return false;
+    if (config_.trackControllerState) rx_state_.apply(event);
+    if (config_.chaseMtc) {
+        if (event.type == MidiEventType::MtcQuarterFrame) {
+            rx_mtc_.applyQuarterFrame(event.data1, timestampUs);
+        } else if (event.type == MidiEventType::SysEx) {
+            rx_mtc_.applyFullFrame(data, length, timestampUs);
+        }
+    }
+
+    if (event.type == MidiEventType::ControlChange &&
+        has_cc_policies_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(rx_cc_filter_mutex_);
+        if (!rx_cc_filter_.accept(event.channel, event.data1, event.data2, timestampUs)) {
+            return false;
+        }
+    }
+
+    if (config_.assembleParameters && event.type == MidiEventType::ControlChange) {
+        std::lock_guard<std::mutex> lock(rx_assembler_mutex_);
+        const bool consumed =
+            rx_assembler_.process(event, timestampUs, [&](const ParameterEvent& parameter) {
+                enqueueParameter(parameter, timestampUs);
+            });
+        if (consumed) return false;
+    }
+
+    if (rx_subscribers_.interestMask() & midiEventBit(event.type)) return true;
+    if (event.type == MidiEventType::ControlChange) {
+        return rx_cc_handlers_.wants(event.channel, event.data1);
+    }
+    if (rx_interest_.load(std::memory_order_relaxed) & midiEventBit(event.type)) return true;
+    return event.type == MidiEventType::SysEx && sysex_router_.matches(data, length);
+}
+
+void LibreMidiTransport::enqueueParameter(const ParameterEvent& parameter, uint64_t timestampUs) {
+    if (!has_parameter_callback_.load(std::memory_order_relaxed)) return;
+
+    PendingMessage pending{};
+    pending.timestampUs = timestampUs;
+    pending.kind = PendingMessage::Kind::Parameter;
+    pending.parameter = parameter;
+    enqueuePending(std::move(pending));
+}
+
+void LibreMidiTransport::setInterest(MidiEventType type, bool enabled) {
+    if (enabled) {
+        rx_interest_.fetch_or(midiEventBit(type), std::memory_order_relaxed);
+    } else {
+        rx_interest_.fetch_and(~midiEventBit(type), std::memory_order_relaxed);
+    }
+}
+
+void LibreMidiTransport::enqueueIncoming(std::vector<uint8_t>&& bytes, uint64_t timestampUs) {
+    PendingMessage pending{};
+    pending.timestampUs = timestampUs;
+    pending.bytes = std::move(bytes);
+    enqueuePending(std::move(pending));
+}
+
+bool LibreMidiTransport::enqueuePending(PendingMessage&& pending) {
+    const MidiTrafficClass cls = trafficClassOf(pending);
+    return rx_queues_.push(cls, std::move(pending));
+}
+
+MidiTrafficClass LibreMidiTransport::trafficClassOf(const PendingMessage& pending) {
+    switch (pending.kind) {
+        case PendingMessage::Kind::SysExChunk: return MidiTrafficClass::SysEx;
+        case PendingMessage::Kind::Parameter: return MidiTrafficClass::ChannelVoice;
+        default: return midiTrafficClass(pending.bytes.empty() ? 0 : pending.bytes[0]);
+    }
+}
+
 void LibreMidiTransport::update() {
-    // Process buffered MIDI messages on the main thread.
-    std::vector<PendingMessage> local;
-    {
-        std::lock_guard<std::mutex> lock(pending_mutex_);
-        local.swap(pending_messages_);
+    // One replayed message per lock, so a sender on another thread waits
+    // for a single write, not for the whole burst.
+    const uint64_t resyncUs = steadyNowUs();
+    for (;;) {
+        std::lock_guard<std::mutex> lock(output_mutex_);
+        if (!tx_mirror_.resyncPending() || !midi_out_ || !midi_out_->is_port_connected()) break;
+        const size_t sent = tx_mirror_.resync(
+            resyncUs, [this](const uint8_t* data, size_t length) { writeLocked(data, length); }, 1);
+        if (sent == 0) break;
     }
 
+    // MSBs whose LSB never came (7-bit senders) are emitted after a timeout.
+    // The clock is read under the lock, so no RX timestamp is newer.
+    if (config_.assembleParameters) {
+        std::lock_guard<std::mutex> lock(rx_assembler_mutex_);
+        const uint64_t nowUs = steadyNowUs();
+        rx_assembler_.poll(nowUs, [&](const ParameterEvent& parameter) {
+            enqueueParameter(parameter, nowUs);
+        });
+    }
+
+    // Rate-limited controller values whose interval has ended.
+    if (has_cc_policies_.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(rx_cc_filter_mutex_);
+        const uint64_t nowUs = steadyNowUs();  // Under the lock, as for the assembler
+        rx_cc_filter_.poll(nowUs, [&](uint8_t channel, uint8_t controller, uint8_t value) {
+            const bool subscribed = rx_subscribers_.interestMask() &
+                                    midiEventBit(MidiEventType::ControlChange);
+            if (!subscribed && !rx_cc_handlers_.wants(channel, controller)) return;
+            enqueueIncoming({static_cast<uint8_t>(0xB0 | channel), controller, value}, nowUs);
+        });
+    }
+
+    if (config_.useUmp) drainUmp();
+
+    // Process buffered MIDI messages on the main thread, realtime first
+    // by default (see LibreMidiConfig::inboundQueues).
+    rx_queues_.drain(rx_drained_);
+    dispatchPending(rx_drained_);
+    rx_drained_.clear();
+}
+
+void LibreMidiTransport::dispatchPending(std::vector<PendingMessage>& local) {
     for (auto& pending : local) {
-        processMessage(pending.bytes.data(), pending.bytes.size(), pending.timestampUs);
+        const uint64_t nowUs = steadyNowUs();
+        rx_queues_.recordLatency(trafficClassOf(pending),
+                                 nowUs > pending.timestampUs ? nowUs - pending.timestampUs : 0);
+        switch (pending.kind) {
+            case PendingMessage::Kind::SysExChunk:
+                flushDispatchLanes();
+                if (on_sysex_chunk_) {
+                    on_sysex_chunk_(pending.chunkPhase, pending.bytes.data(), pending.bytes.size());
+                }
+                {
+                    std::lock_guard<std::mutex> lock(rx_chunk_pool_mutex_);
+                    rx_chunk_pool_.release(std::move(pending.bytes));
+                }
+                break;
+            case PendingMessage::Kind::Parameter:
+                flushDispatchLanes();
+                if (on_parameter_) on_parameter_(pending.parameter);
+                break;
+            default: {
+                const uint8_t* data = pending.bytes.data();
+                const size_t length = pending.bytes.size();
+                MidiEvent event;
+                if (!rx_dispatch_pool_ || !decodeMidiEvent(data, length, event) ||
+                    event.type < MidiEventType::NoteOff || event.type > MidiEventType::PitchBend) {
+                    flushDispatchLanes();
+                    processMessage(data, length, pending.timestampUs);
+                    break;
+                }
+                // Subscribers see everything in order here; the channel's
+                // own callbacks run on its lane below.
+                rx_subscribers_.dispatch(event, data, length, pending.timestampUs);
+                rx_dispatch_pool_->post(event.channel, data, length, pending.timestampUs);
+                break;
+            }
+        }
     }
+
+    flushDispatchLanes();
+}
+
+void LibreMidiTransport::flushDispatchLanes() {
+    // Barrier: whatever runs on the calling thread next (system messages,
+    // SysEx, parameters) must not overtake channel voice posted before it.
+    if (!rx_dispatch_pool_ || rx_dispatch_pool_->pending() == 0) return;
+    rx_dispatch_pool_->run([this](const ChannelDispatchPool::Item& item) {
+        MidiEvent event;
+        if (decodeMidiEvent(item.bytes, item.length, event)) dispatchChannelVoice(event);
+    });
 }
 
 void LibreMidiTransport::processMessage(const uint8_t* data, size_t length, uint64_t timestampUs) {
-    if (length == 0) return;
+    MidiEvent event;
+    if (!decodeMidiEvent(data, length, event)) return;
 
     // Debug: log incoming MIDI (can be very chatty)
     OC_LOG_DEBUG("MIDI RX: status={} len={}", data[0], length);
 
-    uint8_t status = data[0];
+    rx_subscribers_.dispatch(event, data, length, timestampUs);
 
-    // Realtime single-byte messages (may appear interleaved at any time)
-    switch (status) {
-        case 0xF8:
-            if (on_clock_) on_clock_(timestampUs);
-            return;
-        case 0xFA:
-            if (on_start_) on_start_();
-            return;
-        case 0xFB:
-            if (on_continue_) on_continue_();
-            return;
-        case 0xFC:
-            if (on_stop_) on_stop_();
-            return;
-        default:
-            break;
-    }
+    if (dispatchChannelVoice(event)) return;
 
-    uint8_t type = status & 0xF0;
-    uint8_t channel = status & 0x0F;
-
-    switch (type) {
-        case 0x80: // Note Off
-            if (length >= 3 && on_note_off_) {
-                on_note_off_(channel, data[1], data[2]);
-            }
+    switch (event.type) {
+        case MidiEventType::SysEx:
+            if (!sysex_router_.dispatch(data, length) && on_sysex_) on_sysex_(data, length);
             break;
-
-        case 0x90: // Note On
-            if (length >= 3) {
-                if (data[2] == 0 && on_note_off_) {
-                    on_note_off_(channel, data[1], 0);
-                } else if (on_note_on_) {
-                    on_note_on_(channel, data[1], data[2]);
-                }
+        case MidiEventType::MtcQuarterFrame:
+            if (on_mtc_quarter_frame_) {
+                on_mtc_quarter_frame_(event.data1 >> 4, event.data1 & 0x0F);
             }
             break;
-
-        case 0xB0: // Control Change
-            if (length >= 3 && on_cc_) {
-                on_cc_(channel, data[1], data[2]);
-            }
+        case MidiEventType::SongPosition:
+            if (on_song_position_) on_song_position_(event.value14);
+            break;
+        case MidiEventType::SongSelect:
+            if (on_song_select_) on_song_select_(event.data1);
+            break;
+        case MidiEventType::TuneRequest:
+            if (on_tune_request_) on_tune_request_();
             break;
 
-        case 0xF0: // System Exclusive
-            if (status == 0xF0 && on_sysex_) {
-                on_sysex_(data, length);
-            }
+        case MidiEventType::Clock:
+            if (on_clock_) on_clock_(timestampUs);
+            break;
+        case MidiEventType::Start:
+            if (on_start_) on_start_();
+            break;
+        case MidiEventType::Continue:
+            if (on_continue_) on_continue_();
+            break;
+        case MidiEventType::Stop:
+            if (on_stop_) on_stop_();
             break;
 
         default:
@@ -252,6 +601,36 @@ void LibreMidiTransport::processMessage(const uint8_t* data, size_t length, uint
     }
 }
 
+bool LibreMidiTransport::dispatchChannelVoice(const MidiEvent& event) {
+    const uint8_t channel = event.channel;
+
+    switch (event.type) {
+        case MidiEventType::NoteOff:
+            if (on_note_off_) on_note_off_(channel, event.data1, event.data2);
+            return true;
+        case MidiEventType::NoteOn:
+            if (on_note_on_) on_note_on_(channel, event.data1, event.data2);
+            return true;
+        case MidiEventType::PolyPressure:
+            if (on_poly_pressure_) on_poly_pressure_(channel, event.data1, event.data2);
+            return true;
+        case MidiEventType::ControlChange:
+            rx_cc_handlers_.dispatch(channel, event.data1, event.data2);
+            return true;
+        case MidiEventType::ProgramChange:
+            if (on_program_change_) on_program_change_(channel, event.data1);
+            return true;
+        case MidiEventType::ChannelPressure:
+            if (on_channel_pressure_) on_channel_pressure_(channel, event.data1);
+            return true;
+        case MidiEventType::PitchBend:
+            if (on_pitch_bend_) on_pitch_bend_(channel, event.pitchBend());
+            return true;
+        default:
+            return false;
+    }
+}
+
 void LibreMidiTransport::markNoteActive(uint8_t channel, uint8_t note) {
     for (auto& slot : active_notes_) {
         if (!slot.active) {
@@ -273,117 +652,222 @@ void LibreMidiTransport::markNoteInactive(uint8_t channel, uint8_t note) {
     }
 }
 
-void LibreMidiTransport::sendCC(uint8_t channel, uint8_t cc, uint8_t value) {
+void LibreMidiTransport::writeLocked(const uint8_t* data, size_t length) {
+    // Whatever the path (sendCC, sendMessage, thru, mirror replay), a CC
+    // that reaches the receiver may change what the encoder assumes.
+    if (length >= 3 && (data[0] & 0xF0) == 0xB0) {
+        tx_parameters_.observeCC(data[0] & 0x0F, data[1] & 0x7F, data[2] & 0x7F);
+    }
+    emitLocked(data, length);
+}
+
+void LibreMidiTransport::emitLocked(const uint8_t* data, size_t length) {
+    if (config_.mirrorOutputState) tx_mirror_.observe(data, length);
+    if (!config_.useUmp) {
+        // Pointer overload: no libremidi::message (heap vector) per send.
+        midi_out_->send_message(data, length);
+        return;
+    }
+    tx_midi1_to_ump_.convert(data, length, [this](const UmpPacket& packet) {
+        midi_out_->send_ump(packet.words, packet.wordCount());
+    });
+}
+
+void LibreMidiTransport::setCCPolicy(uint8_t channel, uint8_t controller,
+                                     const CCPolicy& policy) {
+    std::lock_guard<std::mutex> lock(rx_cc_filter_mutex_);
+    rx_cc_filter_.setPolicy(channel, controller, policy);
+    if (policy.active()) has_cc_policies_.store(true, std::memory_order_relaxed);
+}
+
+CCFilter::Stats LibreMidiTransport::ccFilterStats() const {
+    std::lock_guard<std::mutex> lock(rx_cc_filter_mutex_);
+    return rx_cc_filter_.stats();
+}
+
+SysExDedup::Stats LibreMidiTransport::sysExDedupStats() const {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    return tx_dedup_.stats();
+}
+
+void LibreMidiTransport::resyncOutputState() {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    tx_mirror_.beginResync(steadyNowUs());
+}
+
+void LibreMidiTransport::sendBytes(const uint8_t* data, size_t length) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    writeLocked(data, length);
+}
+
+void LibreMidiTransport::sendUmp(const UmpPacket& packet) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
     if (!midi_out_ || !midi_out_->is_port_connected()) return;
 
-    libremidi::message msg;
-    msg.bytes = {
+    if (config_.useUmp) {
+        midi_out_->send_ump(packet.words, packet.wordCount());
+        return;
+    }
+    // Same path as the byte senders: encoder cache and output mirror see it.
+    tx_ump_to_midi1_.convert(packet, [this](const uint8_t* data, size_t length) {
+        writeLocked(data, length);
+    });
+}
+
+void LibreMidiTransport::sendMessage(const uint8_t* data, size_t length) {
+    if (!data || length == 0) return;
+    sendBytes(data, length);
+}
+
+void LibreMidiTransport::sendCC(uint8_t channel, uint8_t cc, uint8_t value) {
+    const uint8_t msg[3] = {
         static_cast<uint8_t>(0xB0 | (channel & 0x0F)),
         static_cast<uint8_t>(cc & 0x7F),
         static_cast<uint8_t>(value & 0x7F)
     };
-    midi_out_->send_message(msg);
+
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    writeLocked(msg, sizeof(msg));
+}
+
+void LibreMidiTransport::sendEncodedLocked(const uint8_t* data, size_t length) {
+    // One CC per call: some backends (WinMM) take a single short message.
+    // Not observed: the encoder already recorded what it wrote, and its
+    // own 99/98 selection would otherwise reset the cache.
+    for (size_t i = 0; i + 3 <= length; i += 3) {
+        emitLocked(data + i, 3);
+    }
+}
+
+void LibreMidiTransport::sendNRPN(uint8_t channel, uint16_t number, uint16_t value) {
+    uint8_t msg[ParameterEncoder::MAX_BYTES];
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    sendEncodedLocked(msg, tx_parameters_.encodeNRPN(channel, number, value, msg));
+}
+
+void LibreMidiTransport::sendRPN(uint8_t channel, uint16_t number, uint16_t value) {
+    uint8_t msg[ParameterEncoder::MAX_BYTES];
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    sendEncodedLocked(msg, tx_parameters_.encodeRPN(channel, number, value, msg));
+}
+
+void LibreMidiTransport::sendCC14(uint8_t channel, uint8_t controller, uint16_t value) {
+    uint8_t msg[ParameterEncoder::MAX_BYTES];
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    sendEncodedLocked(msg, tx_parameters_.encodeCC14(channel, controller, value, msg));
 }
 
 void LibreMidiTransport::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
     if (!midi_out_ || !midi_out_->is_port_connected()) return;
 
     markNoteActive(channel, note);
-    libremidi::message msg;
-    msg.bytes = {
+    const uint8_t msg[3] = {
         static_cast<uint8_t>(0x90 | (channel & 0x0F)),
         static_cast<uint8_t>(note & 0x7F),
         static_cast<uint8_t>(velocity & 0x7F)
     };
-    midi_out_->send_message(msg);
+    sendBytes(msg, sizeof(msg));
 }
 
 void LibreMidiTransport::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
     if (!midi_out_ || !midi_out_->is_port_connected()) return;
 
     markNoteInactive(channel, note);
-    libremidi::message msg;
-    msg.bytes = {
+    const uint8_t msg[3] = {
         static_cast<uint8_t>(0x80 | (channel & 0x0F)),
         static_cast<uint8_t>(note & 0x7F),
         static_cast<uint8_t>(velocity & 0x7F)
     };
-    midi_out_->send_message(msg);
+    sendBytes(msg, sizeof(msg));
+}
+
+bool LibreMidiTransport::passSysExDedup(const uint8_t* data, size_t length) {
+    if (!config_.suppressRedundantSysEx) return true;
+    if (tx_dedup_invalid_.exchange(false, std::memory_order_acquire)) tx_dedup_.invalidate();
+    return tx_dedup_.shouldSend(data, length, steadyNowUs());
+}
+
+void LibreMidiTransport::invalidateSysExCache() {
+    tx_dedup_invalid_.store(true, std::memory_order_release);
 }
 
 void LibreMidiTransport::sendSysEx(const uint8_t* data, size_t length) {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    if (!data || length == 0) return;
 
-    libremidi::message msg;
-    msg.bytes.assign(data, data + length);
-    midi_out_->send_message(msg);
+    // Straight from the caller's buffer. Others hold the lock for one
+    // message (at most the four CCs of a parameter write), so waiting for
+    // it keeps the output in call order.
+    std::lock_guard<std::mutex> lock(output_mutex_);
+    if (!midi_out_ || !midi_out_->is_port_connected()) return;
+    // Only frames that actually leave are recorded as sent.
+    if (!passSysExDedup(data, length)) return;
+    writeLocked(data, length);
 }
 
-void LibreMidiTransport::sendProgramChange(uint8_t channel, uint8_t program) {
+void LibreMidiTransport::sendPackedSysEx(const uint8_t* prefix, size_t prefixLength,
+                                         const uint8_t* payload, size_t payloadLength) {
+    std::lock_guard<std::mutex> lock(output_mutex_);
     if (!midi_out_ || !midi_out_->is_port_connected()) return;
 
-    libremidi::message msg;
-    msg.bytes = {
+    // Grows to the largest message once, then reused.
+    const size_t size = packedSysExMessageSize(prefixLength, payloadLength);
+    if (tx_sysex_buffer_.size() < size) tx_sysex_buffer_.resize(size);
+
+    const size_t length = buildPackedSysEx(prefix, prefixLength, payload, payloadLength,
+                                           tx_sysex_buffer_.data(), tx_sysex_buffer_.size());
+    if (!passSysExDedup(tx_sysex_buffer_.data(), length)) return;
+    writeLocked(tx_sysex_buffer_.data(), length);
+}
+
+void LibreMidiTransport::sendProgramChange(uint8_t channel, uint8_t program) {
+    const uint8_t msg[2] = {
         static_cast<uint8_t>(0xC0 | (channel & 0x0F)),
         static_cast<uint8_t>(program & 0x7F)
     };
-    midi_out_->send_message(msg);
+    sendBytes(msg, sizeof(msg));
 }
 
 void LibreMidiTransport::sendPitchBend(uint8_t channel, int16_t value) {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
     uint16_t bend = static_cast<uint16_t>(value + 8192);
-    libremidi::message msg;
-    msg.bytes = {
+    const uint8_t msg[3] = {
         static_cast<uint8_t>(0xE0 | (channel & 0x0F)),
         static_cast<uint8_t>(bend & 0x7F),
         static_cast<uint8_t>((bend >> 7) & 0x7F)
     };
-    midi_out_->send_message(msg);
+    sendBytes(msg, sizeof(msg));
 }
 
 void LibreMidiTransport::sendChannelPressure(uint8_t channel, uint8_t pressure) {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
-    libremidi::message msg;
-    msg.bytes = {
+    const uint8_t msg[2] = {
         static_cast<uint8_t>(0xD0 | (channel & 0x0F)),
         static_cast<uint8_t>(pressure & 0x7F)
     };
-    midi_out_->send_message(msg);
+    sendBytes(msg, sizeof(msg));
 }
 
 void LibreMidiTransport::sendClock() {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
-    libremidi::message msg;
-    msg.bytes = {0xF8};
-    midi_out_->send_message(msg);
+    const uint8_t msg = 0xF8;
+    sendBytes(&msg, 1);
 }
 
 void LibreMidiTransport::sendStart() {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
-    libremidi::message msg;
-    msg.bytes = {0xFA};
-    midi_out_->send_message(msg);
+    const uint8_t msg = 0xFA;
+    sendBytes(&msg, 1);
 }
 
 void LibreMidiTransport::sendStop() {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
-    libremidi::message msg;
-    msg.bytes = {0xFC};
-    midi_out_->send_message(msg);
+    const uint8_t msg = 0xFC;
+    sendBytes(&msg, 1);
 }
 
 void LibreMidiTransport::sendContinue() {
-    if (!midi_out_ || !midi_out_->is_port_connected()) return;
-
-    libremidi::message msg;
-    msg.bytes = {0xFB};
-    midi_out_->send_message(msg);
+    const uint8_t msg = 0xFB;
+    sendBytes(&msg, 1);
 }
 
 void LibreMidiTransport::allNotesOff() {
@@ -395,14 +879,127 @@ void LibreMidiTransport::allNotesOff() {
     }
 }
 
-void LibreMidiTransport::setOnCC(CCCallback cb) { on_cc_ = std::move(cb); }
-void LibreMidiTransport::setOnNoteOn(NoteCallback cb) { on_note_on_ = std::move(cb); }
-void LibreMidiTransport::setOnNoteOff(NoteCallback cb) { on_note_off_ = std::move(cb); }
-void LibreMidiTransport::setOnSysEx(SysExCallback cb) { on_sysex_ = std::move(cb); }
-void LibreMidiTransport::setOnClock(ClockCallback cb) { on_clock_ = std::move(cb); }
-void LibreMidiTransport::setOnStart(RealtimeCallback cb) { on_start_ = std::move(cb); }
-void LibreMidiTransport::setOnStop(RealtimeCallback cb) { on_stop_ = std::move(cb); }
-void LibreMidiTransport::setOnContinue(RealtimeCallback cb) { on_continue_ = std::move(cb); }
+MidiSubscribers::Id LibreMidiTransport::subscribe(uint32_t typeMask,
+                                                  MidiSubscribers::Subscriber subscriber) {
+    return rx_subscribers_.subscribe(typeMask, std::move(subscriber));
+}
+
+bool LibreMidiTransport::unsubscribe(MidiSubscribers::Id id) {
+    return rx_subscribers_.unsubscribe(id);
+}
+
+void LibreMidiTransport::setOnCC(CCCallback cb) {
+    rx_cc_handlers_.setFallback(std::move(cb));
+    setInterest(MidiEventType::ControlChange, !rx_cc_handlers_.empty());
+}
+
+void LibreMidiTransport::setOnCC(uint8_t channel, uint8_t controller, CCCallback cb) {
+    rx_cc_handlers_.set(channel, controller, std::move(cb));
+    setInterest(MidiEventType::ControlChange, !rx_cc_handlers_.empty());
+}
+
+void LibreMidiTransport::setOnNoteOn(NoteCallback cb) {
+    setInterest(MidiEventType::NoteOn, static_cast<bool>(cb));
+    on_note_on_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnNoteOff(NoteCallback cb) {
+    setInterest(MidiEventType::NoteOff, static_cast<bool>(cb));
+    on_note_off_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnSysEx(SysExCallback cb) {
+    setInterest(MidiEventType::SysEx, static_cast<bool>(cb));
+    on_sysex_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnClock(ClockCallback cb) {
+    setInterest(MidiEventType::Clock, static_cast<bool>(cb));
+    on_clock_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnStart(RealtimeCallback cb) {
+    setInterest(MidiEventType::Start, static_cast<bool>(cb));
+    on_start_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnStop(RealtimeCallback cb) {
+    setInterest(MidiEventType::Stop, static_cast<bool>(cb));
+    on_stop_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnContinue(RealtimeCallback cb) {
+    setInterest(MidiEventType::Continue, static_cast<bool>(cb));
+    on_continue_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnPitchBend(PitchBendCallback cb) {
+    setInterest(MidiEventType::PitchBend, static_cast<bool>(cb));
+    on_pitch_bend_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnProgramChange(ProgramChangeCallback cb) {
+    setInterest(MidiEventType::ProgramChange, static_cast<bool>(cb));
+    on_program_change_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnChannelPressure(ChannelPressureCallback cb) {
+    setInterest(MidiEventType::ChannelPressure, static_cast<bool>(cb));
+    on_channel_pressure_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnPolyPressure(PolyPressureCallback cb) {
+    setInterest(MidiEventType::PolyPressure, static_cast<bool>(cb));
+    on_poly_pressure_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnSongPosition(SongPositionCallback cb) {
+    setInterest(MidiEventType::SongPosition, static_cast<bool>(cb));
+    on_song_position_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnMtcQuarterFrame(MtcQuarterFrameCallback cb) {
+    setInterest(MidiEventType::MtcQuarterFrame, static_cast<bool>(cb));
+    on_mtc_quarter_frame_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnSongSelect(SongSelectCallback cb) {
+    setInterest(MidiEventType::SongSelect, static_cast<bool>(cb));
+    on_song_select_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnTuneRequest(RealtimeCallback cb) {
+    setInterest(MidiEventType::TuneRequest, static_cast<bool>(cb));
+    on_tune_request_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnUmp(UmpType type, UmpDispatcher::Handler handler) {
+    ump_dispatcher_.setHandler(type, std::move(handler));
+}
+
+void LibreMidiTransport::setOnParameter(ParameterCallback cb) {
+    has_parameter_callback_.store(static_cast<bool>(cb), std::memory_order_relaxed);
+    on_parameter_ = std::move(cb);
+}
+
+void LibreMidiTransport::setOnSysExChunk(SysExChunkCallback cb) { on_sysex_chunk_ = std::move(cb); }
+
+bool LibreMidiTransport::addSysExRoute(const uint8_t* prefix, size_t length, SysExCallback cb) {
+    if (initialized_) return false;
+    return sysex_router_.add(prefix, length, std::move(cb));
+}
+
+bool LibreMidiTransport::setTransform(const TransformPipeline& pipeline) {
+    if (initialized_) return false;
+    rx_transform_ = pipeline;
+    return true;
+}
+
+bool LibreMidiTransport::addThruRoute(MidiThru::Route route) {
+    if (initialized_) return false;
+    rx_thru_.add(std::move(route));
+    return true;
+}
 
 // =============================================================================
 // WebMIDI async port handling
@@ -428,17 +1025,7 @@ void LibreMidiTransport::onInputAdded(const libremidi::input_port& port) {
     // Keep timing messages for external clock / transport sync.
     in_config.ignore_timing = false;
     in_config.on_message = [this](libremidi::message&& msg) {
-        if (msg.bytes.empty()) return;
-
-        PendingMessage pending{};
-        pending.timestampUs = nowSteadyUs();
-        pending.bytes = std::move(msg.bytes);
-
-        std::lock_guard<std::mutex> lock(pending_mutex_);
-        if (pending_messages_.size() >= max_pending_messages_) {
-            return;
-        }
-        pending_messages_.push_back(std::move(pending));
+        handleIncoming(std::move(msg));
     };
     
 #ifdef __EMSCRIPTEN__
@@ -469,6 +1056,7 @@ void LibreMidiTransport::onOutputAdded(const libremidi::output_port& port) {
     }
     
     // Create and open output
+    std::lock_guard<std::mutex> lock(output_mutex_);
 #ifdef __EMSCRIPTEN__
     midi_out_ = std::make_unique<libremidi::midi_out>(
         libremidi::output_configuration{},
@@ -478,6 +1066,9 @@ void LibreMidiTransport::onOutputAdded(const libremidi::output_port& port) {
     midi_out_ = std::make_unique<libremidi::midi_out>();
 #endif
     midi_out_->open_port(port);
+    tx_parameters_.invalidate();
+    invalidateSysExCache();  // New device has none of our frames
+    if (config_.mirrorOutputState) tx_mirror_.beginResync(steadyNowUs());
     OC_LOG_INFO("MIDI: Opened output port: {}", name.c_str());
 }
 
@@ -13,6 +13,8 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <memory>
 #include <string>
@@ -21,7 +23,32 @@
 #include <oc/type/Result.hpp>
 #include <oc/interface/IMidi.hpp>
 
+#include "BufferPool.hpp"
+#include "CCFilter.hpp"
+#include "CCHandlerTable.hpp"
+#include "ChannelDispatchPool.hpp"
+#include "ClockThru.hpp"
+#include "ControllerState.hpp"
+#include "InboundQueues.hpp"
+#include "MidiEvent.hpp"
+#include "MidiStreamParser.hpp"
+#include "MidiSubscribers.hpp"
+#include "MidiThru.hpp"
+#include "MtcChaser.hpp"
+#include "OutputMirror.hpp"
+#include "ParameterAssembler.hpp"
+#include "ParameterEncoder.hpp"
+#include "SpscQueue.hpp"
+#include "SysExDedup.hpp"
+#include "SysExRouter.hpp"
+#include "TransformPipeline.hpp"
+#include "Ump.hpp"
+#include "UmpTranslator.hpp"
+
 namespace libremidi {
+struct message;
+struct ump;
+struct input_configuration;
 class midi_in;
 class midi_out;
 class observer;
@@ -60,6 +87,95 @@ struct LibreMidiConfig {
     /// Create virtual MIDI ports (Linux/macOS only)
     /// If false, searches for existing ports matching inputPortName/outputPortName
     bool useVirtualPorts = false;
+
+    /// Largest inbound SysEx accepted, in bytes; larger ones are dropped.
+    /// 0 = no limit (firmware, sample dumps).
+    size_t maxSysExSize = 0;
+
+    /// Inbound SysEx reassembly buffer, allocated once in init(). SysEx
+    /// larger than this (within maxSysExSize) are assembled in a second
+    /// buffer that grows on demand and keeps its capacity. Also sizes the
+    /// UMP SysEx7 translation buffers when maxSysExSize is 0.
+    size_t sysexBufferSize = 64 * 1024;
+
+    /// Chunked SysEx delivery: SysEx larger than this many bytes is passed to
+    /// the setOnSysExChunk() callback in fragments instead of being buffered
+    /// whole (maxSysExSize no longer applies). 0 disables chunking.
+    /// Fragments only reach that callback: thru routes, SysEx routes,
+    /// subscribers and MTC full-frame chasing see whole SysEx only.
+    size_t sysexChunkSize = 0;
+
+    /// Skip outbound SysEx identical to the last one sent with the same key
+    /// (sendSysEx / sendPackedSysEx only; see SysExDedup.hpp)
+    bool suppressRedundantSysEx = false;
+
+    /// Key length, forced refresh interval and table size for suppression
+    SysExDedupConfig sysexDedup;
+
+    /// Assemble 14-bit CC pairs and NRPN / RPN sequences on the receive
+    /// thread; the CCs involved reach setOnParameter() only, not setOnCC()
+    bool assembleParameters = false;
+
+    /// Which sequences to assemble, and their timeout
+    ParameterAssemblerConfig parameterAssembler;
+
+    /// Keep controllerState() up to date from all channel voice input,
+    /// whether or not a callback is registered for it
+    bool trackControllerState = false;
+
+    /// Threads running channel voice callbacks in update(), the calling
+    /// thread included, sharded by channel (order kept within a channel).
+    /// 0 or 1 = serial. Callbacks of different channels then run
+    /// concurrently; subscribers, system messages and SysEx stay on the
+    /// calling thread, which first waits for the channel voice before them.
+    size_t dispatchThreads = 0;
+
+    /// Re-send input clock (F8) and Start / Stop / Continue to the output
+    /// from the receive thread or a scheduling thread, not from update()
+    bool forwardClock = false;
+
+    /// Clock thru mode, division / multiplication and smoothing
+    ClockThruConfig clockThru;
+
+    /// Follow incoming MIDI Time Code (quarter frames and full-frame
+    /// locate) on the receive thread; see mtcChaser()
+    bool chaseMtc = false;
+
+    /// Record outgoing CC / program / pitch bend and replay it when an
+    /// output reconnects, or on resyncOutputState()
+    bool mirrorOutputState = false;
+
+    /// Replay pacing, and whether power-on defaults are left out
+    OutputMirrorConfig outputMirror;
+
+    /// Open desktop ports through the MIDI 2.0 backends: input arrives as
+    /// Universal MIDI Packets, output leaves as UMP (forced off on WebMIDI).
+    /// Only clock thru runs on the receive thread; transform, thru, state
+    /// tracking, MTC chase and the CC filter run in update(), when packets
+    /// are converted, and add up to one update() period to thru latency.
+    bool useUmp = false;
+
+    /// UMP output: MIDI 2.0 channel voice (type 4) instead of MIDI 1.0 (type 2).
+    /// RPN / NRPN writes leave as Registered / Assignable Controller
+    /// messages, one per data entry CC. Bank select (CC 0 / 32) only leaves
+    /// with the next Program Change, as MIDI 2.0 has no standalone form; the
+    /// output mirror still records it and replays it before the program.
+    bool umpMidi2Protocol = false;
+
+    /// UMP group used for output
+    uint8_t umpGroup = 0;
+
+    /// Inbound packet ring (lock-free, allocated once)
+    size_t umpQueueCapacity = 1024;
+
+    /// Inbound queues between the receive thread and update(), one per
+    /// traffic class (realtime, channel voice, SysEx), with their capacity,
+    /// drop policy and drain order. Each keeps a small preallocated ring and
+    /// spills bursts (4096 channel voice messages by default) into an area
+    /// that grows and shrinks back with the watermarks. With sysexChunkSize,
+    /// the SysEx queue always drops newest, so a lost chunk can be reported
+    /// as Abort.
+    InboundQueueConfig inboundQueues;
 };
 
 /**
@@ -79,6 +195,24 @@ class LibreMidiTransport : public interface::IMidi {
 public:
     static constexpr size_t DEFAULT_MAX_ACTIVE_NOTES = 32;
 
+    /// Fragment of a SysEx larger than LibreMidiConfig::sysexChunkSize
+    using SysExChunkCallback =
+        std::function<void(SysExChunkPhase phase, const uint8_t* data, size_t length)>;
+
+    // Inbound messages beyond the IMidi set (pitch bend value is -8192..8191,
+    // same as sendPitchBend(); song position counts MIDI beats)
+    using PitchBendCallback = std::function<void(uint8_t channel, int16_t value)>;
+    using ProgramChangeCallback = std::function<void(uint8_t channel, uint8_t program)>;
+    using ChannelPressureCallback = std::function<void(uint8_t channel, uint8_t pressure)>;
+    using PolyPressureCallback =
+        std::function<void(uint8_t channel, uint8_t note, uint8_t pressure)>;
+    using SongPositionCallback = std::function<void(uint16_t beats)>;
+    using MtcQuarterFrameCallback = std::function<void(uint8_t piece, uint8_t value)>;
+    using SongSelectCallback = std::function<void(uint8_t song)>;
+
+    /// One 14-bit CC / NRPN / RPN change (see ParameterAssembler.hpp)
+    using ParameterCallback = std::function<void(const ParameterEvent& parameter)>;
+
     LibreMidiTransport();
     explicit LibreMidiTransport(const LibreMidiConfig& config);
     ~LibreMidiTransport() override;
@@ -97,6 +231,14 @@ public:
     void sendCC(uint8_t channel, uint8_t cc, uint8_t value) override;
     void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) override;
     void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) override;
+    /**
+     * @brief Send a complete SysEx message (F0 ... F7)
+     *
+     * Sent straight from @p data, without a copy. If another thread is
+     * sending (player, streamer, thru), waits for its current message (at
+     * most the four CCs of a parameter write), so output order follows call
+     * order.
+     */
     void sendSysEx(const uint8_t* data, size_t length) override;
     void sendProgramChange(uint8_t channel, uint8_t program) override;
     void sendPitchBend(uint8_t channel, int16_t value) override;
@@ -107,7 +249,136 @@ public:
     void sendContinue() override;
     void allNotesOff() override;
 
+    /**
+     * @brief Send one complete raw MIDI message (channel, system or SysEx)
+     *
+     * Thread-safe: may be called from player / scheduler threads while the
+     * main thread uses the typed send functions. Does not update the
+     * active-note tracking used by allNotesOff().
+     */
+    void sendMessage(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Send F0 <prefix> <7-in-8 packed payload> F7
+     *
+     * Packs straight into a reused transmit buffer (see SysExPacking.hpp),
+     * so binary payloads need no intermediate vector. Inbound handlers can
+     * decode the same format with unpackSysEx7().
+     */
+    void sendPackedSysEx(const uint8_t* prefix, size_t prefixLength,
+                         const uint8_t* payload, size_t payloadLength);
+
+    /// Counters of the redundant-SysEx stage (all zero when disabled)
+    SysExDedup::Stats sysExDedupStats() const;
+
+    /// Resend every SysEx on its next send (e.g. the device lost its display)
+    void invalidateSysExCache();
+
+    /**
+     * @brief Current CC / note / pressure / pitch bend values of the input
+     *
+     * Updated as input is decoded (before queuing), readable from any thread
+     * without callbacks. Requires LibreMidiConfig::trackControllerState.
+     */
+    const ControllerState& controllerState() const { return rx_state_; }
+
+    /**
+     * @brief Incoming MIDI Time Code position
+     *
+     * Assembled from quarter frames as they are decoded (before queuing);
+     * read mtcChaser().position(steadyNowUs()) from any thread. Requires
+     * LibreMidiConfig::chaseMtc. setOnMtcQuarterFrame() still receives the
+     * raw pieces. To send MTC, feed an MtcGenerator to sendMessage().
+     */
+    const MtcChaser& mtcChaser() const { return rx_mtc_; }
+
+    /**
+     * @brief Filter one inbound controller on the receive thread
+     *
+     * Hysteresis, rate limit and drop-if-unchanged (see CCFilter.hpp),
+     * applied before queuing so filtered values cost no queue traffic or
+     * callback. Rate-limited values are delivered from update(). Meant for
+     * plain 7-bit controllers; controllers that are part of 14-bit or
+     * NRPN / RPN sequences should keep the default (no policy).
+     */
+    void setCCPolicy(uint8_t channel, uint8_t controller, const CCPolicy& policy);
+
+    /// Counters of the inbound CC filter
+    CCFilter::Stats ccFilterStats() const;
+
+    /// Queued / dropped counts and queue latency (receive to dispatch) of one traffic class
+    InboundQueueStats inboundQueueStats(MidiTrafficClass cls) const { return rx_queues_.stats(cls); }
+
+    /**
+     * @brief Replay the last-sent CC / program / pitch bend values
+     *
+     * Only entries actually sent are replayed, paced by
+     * LibreMidiConfig::outputMirror from update(). Called automatically when
+     * an output port is (re)opened; call it when the receiver is known to
+     * have lost its state some other way. Requires mirrorOutputState.
+     */
+    void resyncOutputState();
+
+    /**
+     * @brief Send a 14-bit NRPN / RPN value, or a 14-bit CC pair
+     *
+     * Parameter selection (CC 99/98, 101/100) and MSB (CC 6, or CC n for
+     * sendCC14) are only sent when they differ from what this output last
+     * sent on the channel, so streaming values to one parameter costs one
+     * or two CCs instead of four. The cache is reset when a new output port
+     * opens. CCs sent any other way (sendCC, sendMessage, thru) update it.
+     *
+     * @param controller MSB controller 0-31 (LSB goes to controller + 32)
+     */
+    void sendNRPN(uint8_t channel, uint16_t number, uint16_t value);
+    void sendRPN(uint8_t channel, uint16_t number, uint16_t value);
+    void sendCC14(uint8_t channel, uint8_t controller, uint16_t value);
+
+    /**
+     * @brief Send one Universal MIDI Packet
+     *
+     * Sent as is on UMP ports; translated to MIDI 1.0 bytes otherwise. The
+     * byte-oriented send functions are likewise translated to UMP on UMP
+     * ports.
+     */
+    void sendUmp(const UmpPacket& packet);
+
+    /**
+     * @brief Receive UMP input of one message type as raw packets
+     *
+     * UMP ports only. Packets of a type without a handler are translated to
+     * MIDI 1.0 and reach the usual callbacks. Delivered in update().
+     */
+    void setOnUmp(UmpType type, UmpDispatcher::Handler handler);
+
+    /// UMP packets dropped on the receive thread because the ring was full
+    uint64_t umpPacketsDropped() const { return rx_ump_dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Receive every message of the given types, alongside other subscribers
+     *
+     * All subscribers get the same decoded event and a view of the same
+     * bytes (no per-subscriber copy), in update(), before the single-slot
+     * callbacks. Safe to call, like unsubscribe(), from inside a subscriber.
+     *
+     * @param typeMask OR of midiEventBit() values
+     * @return Id for unsubscribe()
+     */
+    MidiSubscribers::Id subscribe(uint32_t typeMask, MidiSubscribers::Subscriber subscriber);
+    bool unsubscribe(MidiSubscribers::Id id);
+
+    /// Fallback for controllers without a handler of their own (see below)
     void setOnCC(CCCallback cb) override;
+
+    /**
+     * @brief Handle one controller with its own callback
+     *
+     * Stored in a 16 x 128 table: dispatch is one indexed call, and
+     * controllers with neither a handler nor a setOnCC() fallback are
+     * dropped on the receive thread. Pass CCHandlerTable::ANY_CHANNEL to bind
+     * all channels, nullptr to unbind.
+     */
+    void setOnCC(uint8_t channel, uint8_t controller, CCCallback cb);
     void setOnNoteOn(NoteCallback cb) override;
     void setOnNoteOff(NoteCallback cb) override;
     void setOnSysEx(SysExCallback cb) override;
@@ -116,6 +387,81 @@ public:
     void setOnStop(RealtimeCallback cb) override;
     void setOnContinue(RealtimeCallback cb) override;
 
+    void setOnPitchBend(PitchBendCallback cb);
+    void setOnProgramChange(ProgramChangeCallback cb);
+    void setOnChannelPressure(ChannelPressureCallback cb);
+    void setOnPolyPressure(PolyPressureCallback cb);
+    void setOnSongPosition(SongPositionCallback cb);
+    void setOnMtcQuarterFrame(MtcQuarterFrameCallback cb);
+    void setOnSongSelect(SongSelectCallback cb);
+    void setOnTuneRequest(RealtimeCallback cb);
+
+    /// Requires LibreMidiConfig::assembleParameters
+    void setOnParameter(ParameterCallback cb);
+
+    /**
+     * @brief Receive oversized SysEx as Begin / Data... / End fragments
+     *
+     * Requires LibreMidiConfig::sysexChunkSize > 0. Fragments are queued and
+     * delivered in update(), in order with other SysEx; SysEx that fit in
+     * one chunk still go to the setOnSysEx() callback. Fragments are not
+     * thru'd, routed by prefix or passed to subscribers (they are not
+     * complete messages). Fragment buffers are recycled: @p data is only
+     * valid during the call.
+     */
+    void setOnSysExChunk(SysExChunkCallback cb);
+
+    /**
+     * @brief Route inbound SysEx starting with F0 <prefix...> to @p cb
+     *
+     * Prefix bytes follow F0 (manufacturer ID, device ID, sub-IDs;
+     * SysExRouter::ANY matches any byte). The longest matching route wins;
+     * the setOnSysEx() callback only receives unrouted SysEx. With routes
+     * and no setOnSysEx() callback, unrouted SysEx is dropped on the receive
+     * thread. Register routes before init().
+     *
+     * @return false after init() or for an invalid prefix
+     */
+    bool addSysExRoute(const uint8_t* prefix, size_t length, SysExCallback cb);
+
+    /**
+     * @brief Echo selected input to an output on the receive thread
+     *
+     * Matching messages (type mask, channel map; see MidiThru.hpp) are
+     * forwarded as soon as they are framed, from the original bytes,
+     * without going through the queue or update(). A route without a sink
+     * sends to this transport's output, except clock and transport already
+     * sent there by forwardClock. Input is still delivered to the
+     * callbacks as usual. Whole SysEx only (not with sysexChunkSize). UMP
+     * input is forwarded from update(), after translation.
+     * Register routes before init().
+     *
+     * @return false after init()
+     */
+    bool addThruRoute(MidiThru::Route route);
+
+    /**
+     * @brief Transform input as it is decoded (remap, transpose, zones, ...)
+     *
+     * Runs on the receive thread right after framing, before thru routes,
+     * filtering and callbacks, which all see the transformed message.
+     * Messages dropped by a stage go nowhere. Set before init().
+     *
+     * @return false after init()
+     */
+    bool setTransform(const TransformPipeline& pipeline);
+
+    /**
+     * @brief Clock thru state: input period estimate, ticks sent, jitter
+     *
+     * Clock thru takes input clock as it is framed, before the transform
+     * pipeline and thru routes (which should then not forward clock too).
+     * setOnClock() keeps working as usual.
+     *
+     * @return nullptr unless LibreMidiConfig::forwardClock
+     */
+    const ClockThru* clockThru() const { return rx_clock_thru_.get(); }
+
 private:
     struct ActiveNote {
         uint8_t channel;
@@ -123,9 +469,39 @@ private:
         bool active;
     };
 
+    struct PendingMessage {
+        enum class Kind : uint8_t { Message, SysExChunk, Parameter };
+
+        std::vector<uint8_t> bytes;
+        uint64_t timestampUs = 0;
+        Kind kind = Kind::Message;
+        SysExChunkPhase chunkPhase = SysExChunkPhase::Data;
+        ParameterEvent parameter;
+    };
+
     void markNoteActive(uint8_t channel, uint8_t note);
     void markNoteInactive(uint8_t channel, uint8_t note);
     void processMessage(const uint8_t* data, size_t length, uint64_t timestampUs);
+    bool dispatchChannelVoice(const MidiEvent& event);
+    void dispatchPending(std::vector<PendingMessage>& local);
+    void flushDispatchLanes();
+    void handleIncoming(libremidi::message&& msg);
+    void enqueueIncoming(std::vector<uint8_t>&& bytes, uint64_t timestampUs);
+    bool enqueuePending(PendingMessage&& pending);
+    static MidiTrafficClass trafficClassOf(const PendingMessage& pending);
+    bool filterIncoming(const uint8_t* data, size_t length, uint64_t timestampUs);
+    void forwardThru(const uint8_t* data, size_t length);
+    const uint8_t* transformIncoming(const uint8_t* data, size_t length, uint8_t* edited) const;
+    void enqueueParameter(const ParameterEvent& parameter, uint64_t timestampUs);
+    void setInterest(MidiEventType type, bool enabled);
+    void sendBytes(const uint8_t* data, size_t length);
+    void writeLocked(const uint8_t* data, size_t length);
+    void emitLocked(const uint8_t* data, size_t length);
+    void createPorts(const libremidi::input_configuration& inConfig);
+    void handleIncomingUmp(const libremidi::ump& packet);
+    void drainUmp();
+    void sendEncodedLocked(const uint8_t* data, size_t length);
+    bool passSysExDedup(const uint8_t* data, size_t length);
     
     // WebMIDI async port handling
     void onInputAdded(const libremidi::input_port& port);
@@ -136,28 +512,99 @@ private:
     std::unique_ptr<libremidi::midi_in> midi_in_;
     std::unique_ptr<libremidi::midi_out> midi_out_;
 
-    CCCallback on_cc_;
+    CCHandlerTable rx_cc_handlers_;  // Includes the setOnCC() fallback
+    MidiSubscribers rx_subscribers_;
+    MidiThru rx_thru_;  // Read-only once initialized
+    TransformPipeline rx_transform_;  // Read-only once initialized
+    std::unique_ptr<ChannelDispatchPool> rx_dispatch_pool_;  // dispatchThreads > 1
+    std::unique_ptr<ClockThru> rx_clock_thru_;  // forwardClock
     NoteCallback on_note_on_;
     NoteCallback on_note_off_;
     SysExCallback on_sysex_;
+    SysExChunkCallback on_sysex_chunk_;
+    SysExRouter sysex_router_;  // Read-only once init() has run
     ClockCallback on_clock_;
     RealtimeCallback on_start_;
     RealtimeCallback on_stop_;
     RealtimeCallback on_continue_;
+    PitchBendCallback on_pitch_bend_;
+    ProgramChangeCallback on_program_change_;
+    ChannelPressureCallback on_channel_pressure_;
+    PolyPressureCallback on_poly_pressure_;
+    SongPositionCallback on_song_position_;
+    MtcQuarterFrameCallback on_mtc_quarter_frame_;
+    SongSelectCallback on_song_select_;
+    RealtimeCallback on_tune_request_;
+    ParameterCallback on_parameter_;
+
+    // midiEventBit() of every type with a callback. Read on the RX thread
+    // to drop messages nobody handles before they are copied and queued.
+    std::atomic<uint32_t> rx_interest_{0};
+
+    // Serializes access to midi_out_ between the main thread and
+    // scheduling threads (e.g. MidiFilePlayer output).
+    mutable std::mutex output_mutex_;
+    std::vector<uint8_t> tx_sysex_buffer_;  // Guarded by output_mutex_
+    ParameterEncoder tx_parameters_;        // Guarded by output_mutex_
+
+    // Guarded by output_mutex_; cleared on the next send after a new output appears.
+    SysExDedup tx_dedup_;
+    std::atomic<bool> tx_dedup_invalid_{false};
 
     std::vector<ActiveNote> active_notes_;
     bool initialized_ = false;
 
     // libremidi backends may invoke callbacks on a background thread.
     // We buffer incoming messages and process them in update() to keep the
-    // rest of the app single-threaded.
-    std::mutex pending_mutex_;
-    struct PendingMessage {
-        std::vector<uint8_t> bytes;
-        uint64_t timestampUs = 0;
+    // rest of the app single-threaded. One queue per traffic class, so
+    // SysEx or controller floods do not hold up notes and clock.
+    InboundQueues<PendingMessage> rx_queues_;
+    std::vector<PendingMessage> rx_drained_;  // update() only; keeps its capacity
+
+    // RX thread only: frames backend data into complete messages
+    // (running status, interleaved realtime, SysEx split across callbacks).
+    MidiStreamParser rx_parser_;
+    std::vector<uint8_t> rx_sysex_buffer_;
+    std::vector<uint8_t> rx_sysex_large_;  // SysEx beyond rx_sysex_buffer_
+    bool rx_sysex_too_large_ = false;      // Current one exceeds maxSysExSize
+    bool rx_chunk_lost_ = false;  // A fragment of the current SysEx was dropped
+
+    // Fragment buffers: taken on the RX thread, returned after dispatch.
+    std::mutex rx_chunk_pool_mutex_;
+    BufferPool rx_chunk_pool_;
+
+    // UMP input: packets go from the RX thread to update() through a
+    // lock-free ring, then to a per-type handler or the MIDI 1.0 callbacks.
+    struct RxPacket {
+        UmpPacket packet;
+        uint64_t timestampUs;
     };
-    std::vector<PendingMessage> pending_messages_;
-    size_t max_pending_messages_ = 1024;
+    SpscQueue<RxPacket> rx_ump_queue_;
+    std::atomic<uint64_t> rx_ump_dropped_{0};
+    UmpDispatcher ump_dispatcher_;
+    UmpToMidi1 rx_ump_to_midi1_{nullptr, 0};  // Main thread, uses rx_ump_sysex_
+    std::vector<uint8_t> rx_ump_sysex_;
+
+    // UMP output translation, guarded by output_mutex_
+    Midi1ToUmp tx_midi1_to_ump_;
+
+    OutputMirror tx_mirror_;  // Guarded by output_mutex_
+    UmpToMidi1 tx_ump_to_midi1_{nullptr, 0};
+    std::vector<uint8_t> tx_ump_sysex_;
+
+    // CC sequence state; RX thread, plus timeout polling from update().
+    std::mutex rx_assembler_mutex_;
+    ParameterAssembler rx_assembler_;
+    std::atomic<bool> has_parameter_callback_{false};
+
+    // Inbound CC policies; RX thread, plus held values from update().
+    mutable std::mutex rx_cc_filter_mutex_;
+    CCFilter rx_cc_filter_;
+    std::atomic<bool> has_cc_policies_{false};
+
+    // Written by the decode stage only (RX thread, or update() for UMP)
+    ControllerState rx_state_;
+    MtcChaser rx_mtc_;
 };
 
 }  // namespace oc::hal::midi
@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only memory mapping of a file (POSIX mmap / Win32 file mapping)
+ *
+ * Large Standard MIDI Files are decoded straight from the mapping, so only the
+ * pages actually touched by playback are paged in.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace oc::hal::midi {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    // Non-copyable (owns the mapping)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// Map @p path read-only. Empty files open successfully with size() == 0.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return open_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    void swap(MappedFile& other) noexcept;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
+
+}  // namespace oc::hal::midi
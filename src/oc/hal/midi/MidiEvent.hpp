@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file MidiEvent.hpp
+ * @brief Decoded MIDI 1.0 message (channel voice, system common, realtime)
+ *
+ * decodeMidiEvent() turns one complete message, as framed by
+ * MidiStreamParser, into a small POD event. It is cheap enough to run on the
+ * receive thread, where the event type is checked against a mask of the
+ * callbacks actually registered so uninteresting traffic is dropped before
+ * it is queued.
+ *
+ * Conventions:
+ * - Note On with velocity 0 decodes as NoteOff (velocity 0)
+ * - Pitch bend and song position keep their raw 14-bit value in value14;
+ *   pitchBend() gives the signed bend (-8192..8191)
+ * - SysEx is only typed; its bytes stay with the caller
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+enum class MidiEventType : uint8_t {
+    None,
+    // Channel voice
+    NoteOff,
+    NoteOn,
+    PolyPressure,
+    ControlChange,
+    ProgramChange,
+    ChannelPressure,
+    PitchBend,
+    // System common
+    SysEx,
+    MtcQuarterFrame,
+    SongPosition,
+    SongSelect,
+    TuneRequest,
+    // System realtime
+    Clock,
+    Start,
+    Continue,
+    Stop,
+    ActiveSensing,
+    SystemReset
+};
+
+/// Bit of @p type in an event-type mask
+constexpr uint32_t midiEventBit(MidiEventType type) {
+    return 1u << static_cast<uint8_t>(type);
+}
+
+struct MidiEvent {
+    MidiEventType type = MidiEventType::None;
+    uint8_t channel = 0;   ///< Channel voice only (0-15)
+    uint8_t data1 = 0;     ///< Note, controller, program, pressure, song, MTC byte
+    uint8_t data2 = 0;     ///< Velocity, controller value, poly pressure
+    uint16_t value14 = 0;  ///< Pitch bend / song position (0-16383)
+
+    int16_t pitchBend() const { return static_cast<int16_t>(value14 - 8192); }
+};
+
+/**
+ * @brief Decode one complete message
+ * @return false for empty, truncated or undefined (F4, F5, F9, FD) messages
+ */
+inline bool decodeMidiEvent(const uint8_t* data, size_t length, MidiEvent& event) {
+    if (!data || length == 0) return false;
+
+    const uint8_t status = data[0];
+    event = MidiEvent{};
+
+    if (status < 0xF0) {
+        event.channel = status & 0x0F;
+        switch (status & 0xF0) {
+            case 0x80: event.type = MidiEventType::NoteOff; break;
+            case 0x90: event.type = MidiEventType::NoteOn; break;
+            case 0xA0: event.type = MidiEventType::PolyPressure; break;
+            case 0xB0: event.type = MidiEventType::ControlChange; break;
+            case 0xC0: event.type = MidiEventType::ProgramChange; break;
+            case 0xD0: event.type = MidiEventType::ChannelPressure; break;
+            case 0xE0: event.type = MidiEventType::PitchBend; break;
+            default: return false;  // Data byte
+        }
+
+        const size_t needed = (event.type == MidiEventType::ProgramChange ||
+                               event.type == MidiEventType::ChannelPressure) ? 2 : 3;
+        if (length < needed) return false;
+
+        event.data1 = data[1];
+        if (needed == 3) event.data2 = data[2];
+        if (event.type == MidiEventType::PitchBend) {
+            event.value14 = static_cast<uint16_t>(data[1] | (data[2] << 7));
+        } else if (event.type == MidiEventType::NoteOn && event.data2 == 0) {
+            event.type = MidiEventType::NoteOff;
+        }
+        return true;
+    }
+
+    switch (status) {
+        case 0xF0:
+            event.type = MidiEventType::SysEx;
+            return true;
+        case 0xF1:
+            if (length < 2) return false;
+            event.type = MidiEventType::MtcQuarterFrame;
+            event.data1 = data[1];
+            return true;
+        case 0xF2:
+            if (length < 3) return false;
+            event.type = MidiEventType::SongPosition;
+            event.value14 = static_cast<uint16_t>(data[1] | (data[2] << 7));
+            return true;
+        case 0xF3:
+            if (length < 2) return false;
+            event.type = MidiEventType::SongSelect;
+            event.data1 = data[1];
+            return true;
+        case 0xF6: event.type = MidiEventType::TuneRequest; return true;
+        case 0xF8: event.type = MidiEventType::Clock; return true;
+        case 0xFA: event.type = MidiEventType::Start; return true;
+        case 0xFB: event.type = MidiEventType::Continue; return true;
+        case 0xFC: event.type = MidiEventType::Stop; return true;
+        case 0xFE: event.type = MidiEventType::ActiveSensing; return true;
+        case 0xFF: event.type = MidiEventType::SystemReset; return true;
+        default: return false;
+    }
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,253 @@
+#include "MidiFile.hpp"
+
+#include <cstring>
+
+namespace oc::hal::midi {
+
+namespace {
+
+uint32_t readBe32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+uint16_t readBe16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+// SMF variable-length quantity (at most 4 bytes, 28 bits)
+bool readVlq(const uint8_t*& pos, const uint8_t* end, uint32_t& out) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        if (pos >= end) return false;
+        const uint8_t b = *pos++;
+        value = (value << 7) | (b & 0x7F);
+        if ((b & 0x80) == 0) {
+            out = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+// =============================================================================
+// MidiFile
+// =============================================================================
+
+bool MidiFile::open(const std::string& path) {
+    close();
+    if (!mapping_.open(path)) return false;
+    if (!index(mapping_.data(), mapping_.size())) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MidiFile::openMemory(const uint8_t* data, size_t size) {
+    close();
+    if (!index(data, size)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MidiFile::close() {
+    mapping_.close();
+    data_ = nullptr;
+    format_ = 0;
+    division_ = 0;
+    tracks_.clear();
+}
+
+bool MidiFile::index(const uint8_t* data, size_t size) {
+    if (!data || size < 14) return false;
+    if (std::memcmp(data, "MThd", 4) != 0) return false;
+
+    const uint32_t headerLength = readBe32(data + 4);
+    if (headerLength < 6 || 8 + static_cast<size_t>(headerLength) > size) return false;
+
+    format_ = readBe16(data + 8);
+    const uint16_t declaredTracks = readBe16(data + 10);
+    division_ = readBe16(data + 12);
+    if (format_ > 2 || division_ == 0) return false;
+
+    tracks_.clear();
+    tracks_.reserve(declaredTracks);
+
+    const uint8_t* pos = data + 8 + headerLength;
+    const uint8_t* end = data + size;
+    while (end - pos >= 8) {
+        const uint32_t chunkLength = readBe32(pos + 4);
+        const uint8_t* body = pos + 8;
+        // Tolerate a truncated last chunk: decode what is there.
+        const uint8_t* bodyEnd =
+            static_cast<size_t>(end - body) < chunkLength ? end : body + chunkLength;
+
+        if (std::memcmp(pos, "MTrk", 4) == 0) {
+            tracks_.push_back({body, bodyEnd});
+        }
+        pos = bodyEnd;
+    }
+
+    if (tracks_.empty()) return false;
+    data_ = data;
+    return true;
+}
+
+// =============================================================================
+// MidiFileCursor
+// =============================================================================
+
+MidiFileCursor::MidiFileCursor(const MidiFile& file) : file_(file) {
+    rewind();
+}
+
+void MidiFileCursor::rewind() {
+    tracks_.clear();
+    tracks_.reserve(file_.trackCount());
+    for (size_t i = 0; i < file_.trackCount(); ++i) {
+        const auto& t = file_.track(i);
+        TrackState state{t.begin, t.end, 0, 0, false};
+        readDelta(state);
+        tracks_.push_back(state);
+    }
+
+    usPerQuarter_ = DEFAULT_US_PER_QUARTER;
+    tempoTick_ = 0;
+    tempoUs_ = 0;
+}
+
+bool MidiFileCursor::readDelta(TrackState& track) {
+    uint32_t delta = 0;
+    if (!readVlq(track.pos, track.end, delta)) {
+        track.done = true;
+        return false;
+    }
+    track.nextTick += delta;
+    return true;
+}
+
+uint64_t MidiFileCursor::tickToUs(uint32_t tick) const {
+    const uint16_t division = file_.division();
+
+    if (division & 0x8000) {
+        // SMPTE: -frames per second in the high byte, ticks per frame in the low byte.
+        const int fps = -static_cast<int8_t>(division >> 8);
+        const uint64_t ticksPerFrame = division & 0xFF;
+        if (fps <= 0 || ticksPerFrame == 0) return 0;
+        if (fps == 29) {
+            // 29.97 drop-frame
+            return static_cast<uint64_t>(tick) * 1001000000ULL / (30000ULL * ticksPerFrame);
+        }
+        return static_cast<uint64_t>(tick) * 1000000ULL / (static_cast<uint64_t>(fps) * ticksPerFrame);
+    }
+
+    // Computed from the last tempo change, so rounding never accumulates.
+    return tempoUs_ + static_cast<uint64_t>(tick - tempoTick_) * usPerQuarter_ / division;
+}
+
+bool MidiFileCursor::readEvent(TrackState& track, MidiFileEvent& event) {
+    const uint8_t*& pos = track.pos;
+    const uint8_t* end = track.end;
+    if (pos >= end) return false;
+
+    uint8_t status = *pos;
+    if (status & 0x80) {
+        ++pos;
+    } else {
+        if (track.runningStatus == 0) return false;
+        status = track.runningStatus;
+    }
+
+    if (status < 0xF0) {
+        const uint8_t type = status & 0xF0;
+        const uint8_t dataLength = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+        if (end - pos < dataLength) return false;
+
+        track.runningStatus = status;
+        event.kind = MidiFileEvent::Kind::Channel;
+        event.message[0] = status;
+        event.message[1] = pos[0] & 0x7F;
+        event.message[2] = dataLength == 2 ? (pos[1] & 0x7F) : 0;
+        event.messageLength = static_cast<uint8_t>(1 + dataLength);
+        event.payload = nullptr;
+        event.payloadLength = 0;
+        pos += dataLength;
+        return true;
+    }
+
+    // SysEx and meta events cancel running status.
+    track.runningStatus = 0;
+
+    if (status == 0xF0 || status == 0xF7) {
+        uint32_t length = 0;
+        if (!readVlq(pos, end, length) || static_cast<uint32_t>(end - pos) < length) return false;
+        event.kind = status == 0xF0 ? MidiFileEvent::Kind::SysEx : MidiFileEvent::Kind::Escape;
+        event.messageLength = 0;
+        event.payload = pos;
+        event.payloadLength = length;
+        pos += length;
+        return true;
+    }
+
+    if (status == 0xFF) {
+        if (pos >= end) return false;
+        const uint8_t type = *pos++;
+        uint32_t length = 0;
+        if (!readVlq(pos, end, length) || static_cast<uint32_t>(end - pos) < length) return false;
+        event.kind = MidiFileEvent::Kind::Meta;
+        event.messageLength = 0;
+        event.metaType = type;
+        event.payload = pos;
+        event.payloadLength = length;
+        pos += length;
+        return true;
+    }
+
+    // System common / realtime status bytes are not valid SMF events.
+    return false;
+}
+
+bool MidiFileCursor::next(MidiFileEvent& event) {
+    for (;;) {
+        TrackState* earliest = nullptr;
+        for (auto& track : tracks_) {
+            if (!track.done && (!earliest || track.nextTick < earliest->nextTick)) {
+                earliest = &track;
+            }
+        }
+        if (!earliest) return false;
+
+        if (!readEvent(*earliest, event)) {
+            // Malformed data: stop this track, keep playing the others.
+            earliest->done = true;
+            continue;
+        }
+
+        event.track = static_cast<uint16_t>(earliest - tracks_.data());
+        event.tick = earliest->nextTick;
+        event.timeUs = tickToUs(event.tick);
+
+        if (event.kind == MidiFileEvent::Kind::Meta) {
+            if (event.metaType == 0x51 && event.payloadLength == 3) {
+                tempoUs_ = event.timeUs;
+                tempoTick_ = event.tick;
+                usPerQuarter_ = (static_cast<uint32_t>(event.payload[0]) << 16) |
+                                (static_cast<uint32_t>(event.payload[1]) << 8) |
+                                event.payload[2];
+            } else if (event.metaType == 0x2F) {
+                earliest->done = true;
+                return true;
+            }
+        }
+
+        readDelta(*earliest);
+        return true;
+    }
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * @file MidiFile.hpp
+ * @brief Lazy Standard MIDI File (SMF) decoding
+ *
+ * MidiFile validates the header and indexes the MTrk chunks of a mapped file;
+ * no event is decoded at open time. MidiFileCursor then walks all tracks at
+ * once, keeping one read position per track and always yielding the earliest
+ * pending event, so memory use does not depend on the file size.
+ *
+ * Supported: formats 0/1/2, running status, SysEx (F0) and escape (F7)
+ * events, meta events, tempo changes (FF 51) and SMPTE time division.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+namespace oc::hal::midi {
+
+/**
+ * @brief One decoded SMF event
+ *
+ * Channel messages are returned with running status resolved in message[].
+ * SysEx and meta payloads point into the file mapping and stay valid as long
+ * as the MidiFile is open.
+ */
+struct MidiFileEvent {
+    enum class Kind : uint8_t {
+        Channel,  ///< message[0..messageLength)
+        SysEx,    ///< F0 event; payload excludes the leading F0
+        Escape,   ///< F7 event; payload is sent as-is
+        Meta      ///< metaType + payload
+    };
+
+    Kind kind = Kind::Channel;
+    uint16_t track = 0;
+    uint32_t tick = 0;
+    uint64_t timeUs = 0;
+
+    uint8_t message[3] = {0, 0, 0};
+    uint8_t messageLength = 0;
+
+    uint8_t metaType = 0;
+    const uint8_t* payload = nullptr;
+    uint32_t payloadLength = 0;
+};
+
+class MidiFile {
+public:
+    MidiFile() = default;
+
+    /// Map and index a file on disk
+    bool open(const std::string& path);
+
+    /// Index an SMF image owned by the caller (must outlive this object)
+    bool openMemory(const uint8_t* data, size_t size);
+
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    uint16_t format() const { return format_; }
+    uint16_t division() const { return division_; }
+    size_t trackCount() const { return tracks_.size(); }
+
+    struct Track {
+        const uint8_t* begin;
+        const uint8_t* end;
+    };
+    const Track& track(size_t index) const { return tracks_[index]; }
+
+private:
+    bool index(const uint8_t* data, size_t size);
+
+    MappedFile mapping_;
+    const uint8_t* data_ = nullptr;
+    uint16_t format_ = 0;
+    uint16_t division_ = 0;
+    std::vector<Track> tracks_;
+};
+
+/**
+ * @brief Time-ordered iterator over all tracks of a MidiFile
+ *
+ * Events with the same tick are returned in track order, so tempo changes in
+ * the conductor track apply before simultaneous notes in later tracks.
+ * Format 2 files (independent sequences) are merged the same way.
+ */
+class MidiFileCursor {
+public:
+    static constexpr uint32_t DEFAULT_US_PER_QUARTER = 500000;  // 120 BPM
+
+    explicit MidiFileCursor(const MidiFile& file);
+
+    /// Restart from the first event of every track
+    void rewind();
+
+    /// Decode the next event in time order. Returns false at end of file.
+    bool next(MidiFileEvent& event);
+
+    uint32_t usPerQuarter() const { return usPerQuarter_; }
+
+private:
+    struct TrackState {
+        const uint8_t* pos;
+        const uint8_t* end;
+        uint32_t nextTick;
+        uint8_t runningStatus;
+        bool done;
+    };
+
+    bool readDelta(TrackState& track);
+    bool readEvent(TrackState& track, MidiFileEvent& event);
+    uint64_t tickToUs(uint32_t tick) const;
+
+    const MidiFile& file_;
+    std::vector<TrackState> tracks_;
+
+    uint32_t usPerQuarter_ = DEFAULT_US_PER_QUARTER;
+    uint32_t tempoTick_ = 0;
+    uint64_t tempoUs_ = 0;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,123 @@
+#include "MidiFilePlayer.hpp"
+
+#include <cstring>
+
+namespace oc::hal::midi {
+
+MidiFilePlayer::MidiFilePlayer() : MidiFilePlayer(MidiFilePlayerConfig{}) {}
+
+MidiFilePlayer::MidiFilePlayer(const MidiFilePlayerConfig& config) : config_(config) {}
+
+MidiFilePlayer::~MidiFilePlayer() { stop(); }
+
+bool MidiFilePlayer::open(const std::string& path) {
+    stop();
+    return file_.open(path);
+}
+
+bool MidiFilePlayer::openMemory(const uint8_t* data, size_t size) {
+    stop();
+    return file_.openMemory(data, size);
+}
+
+void MidiFilePlayer::setOutput(OutputCallback cb) { output_ = std::move(cb); }
+
+bool MidiFilePlayer::play() {
+    if (!file_.isOpen() || !output_) return false;
+    stop();
+
+    stop_requested_.store(false, std::memory_order_relaxed);
+    events_sent_.store(0, std::memory_order_relaxed);
+    jitter_.reset();
+    std::memset(held_notes_, 0, sizeof(held_notes_));
+
+    playing_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void MidiFilePlayer::stop() {
+    stop_requested_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) thread_.join();
+}
+
+void MidiFilePlayer::wait() {
+    if (thread_.joinable()) thread_.join();
+}
+
+void MidiFilePlayer::run() {
+    if (config_.realtimePriority) raiseThreadPriority();
+
+    MidiFileCursor cursor(file_);
+    MidiFileEvent event;
+    const uint64_t startUs = steadyNowUs() + config_.startDelayUs;
+
+    while (cursor.next(event)) {
+        if (event.kind == MidiFileEvent::Kind::Meta) continue;
+        if (event.kind != MidiFileEvent::Kind::Channel && !config_.sendSysEx) continue;
+
+        const uint64_t deadlineUs = startUs + event.timeUs;
+        if (!sleepUntilUs(deadlineUs, config_.spinUs, &stop_requested_)) break;
+
+        jitter_.record(static_cast<int64_t>(steadyNowUs() - deadlineUs));
+        send(event);
+    }
+
+    releaseHeldNotes();
+    playing_.store(false, std::memory_order_release);
+}
+
+void MidiFilePlayer::send(const MidiFileEvent& event) {
+    switch (event.kind) {
+        case MidiFileEvent::Kind::Channel: {
+            const uint8_t type = event.message[0] & 0xF0;
+            const uint8_t channel = event.message[0] & 0x0F;
+            const uint8_t note = event.message[1];
+            uint16_t& word = held_notes_[channel][note >> 4];
+            const uint16_t bit = static_cast<uint16_t>(1u << (note & 0x0F));
+            if (type == 0x90 && event.message[2] > 0) {
+                word |= bit;
+            } else if (type == 0x80 || type == 0x90) {
+                word &= static_cast<uint16_t>(~bit);
+            }
+            output_(event.message, event.messageLength);
+            break;
+        }
+
+        case MidiFileEvent::Kind::SysEx:
+            // SMF stores F0 events without their status byte.
+            sysex_scratch_.resize(event.payloadLength + 1);
+            sysex_scratch_[0] = 0xF0;
+            if (event.payloadLength) {
+                std::memcpy(sysex_scratch_.data() + 1, event.payload, event.payloadLength);
+            }
+            output_(sysex_scratch_.data(), sysex_scratch_.size());
+            break;
+
+        case MidiFileEvent::Kind::Escape:
+            if (event.payloadLength) output_(event.payload, event.payloadLength);
+            break;
+
+        case MidiFileEvent::Kind::Meta:
+            return;
+    }
+    events_sent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MidiFilePlayer::releaseHeldNotes() {
+    for (uint8_t channel = 0; channel < 16; ++channel) {
+        for (uint8_t group = 0; group < 8; ++group) {
+            uint16_t word = held_notes_[channel][group];
+            for (uint8_t bit = 0; word != 0; ++bit, word >>= 1) {
+                if (word & 1) {
+                    const uint8_t msg[3] = {static_cast<uint8_t>(0x80 | channel),
+                                            static_cast<uint8_t>((group << 4) | bit), 0};
+                    output_(msg, sizeof(msg));
+                }
+            }
+            held_notes_[channel][group] = 0;
+        }
+    }
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file MidiFilePlayer.hpp
+ * @brief Standard MIDI File playback on a high-resolution scheduling thread
+ *
+ * The file is memory-mapped and decoded lazily by MidiFileCursor. Each event
+ * is scheduled against an absolute deadline (start time + event time), so
+ * scheduling errors never accumulate, and the lateness of every event is
+ * recorded in a JitterMeter.
+ *
+ * Usage:
+ *   MidiFilePlayer player;
+ *   player.setOutput([&](const uint8_t* data, size_t length) {
+ *       transport.sendMessage(data, length);
+ *   });
+ *   if (player.open("sequence.mid")) player.play();
+ *   ...
+ *   auto jitter = player.jitter();
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MidiFile.hpp"
+#include "Timing.hpp"
+
+namespace oc::hal::midi {
+
+struct MidiFilePlayerConfig {
+    /// Spin window before each deadline (see sleepUntilUs)
+    uint32_t spinUs = DEFAULT_SPIN_US;
+
+    /// Delay between play() and the first tick, so the thread is warmed up
+    uint32_t startDelayUs = 2000;
+
+    /// Forward SysEx (F0) and escape (F7) events
+    bool sendSysEx = true;
+
+    /// Try to run the scheduling thread with realtime priority
+    bool realtimePriority = true;
+};
+
+class MidiFilePlayer {
+public:
+    /// Receives one complete MIDI message per call, on the playback thread
+    using OutputCallback = std::function<void(const uint8_t* data, size_t length)>;
+
+    MidiFilePlayer();
+    explicit MidiFilePlayer(const MidiFilePlayerConfig& config);
+    ~MidiFilePlayer();
+
+    // Non-copyable, non-movable (owns a thread referencing this)
+    MidiFilePlayer(const MidiFilePlayer&) = delete;
+    MidiFilePlayer& operator=(const MidiFilePlayer&) = delete;
+
+    /// Map an SMF file from disk (stops any running playback)
+    bool open(const std::string& path);
+
+    /// Use an SMF image owned by the caller (stops any running playback)
+    bool openMemory(const uint8_t* data, size_t size);
+
+    /// Must be set before play()
+    void setOutput(OutputCallback cb);
+
+    /// Start playback from the beginning on a new thread
+    bool play();
+
+    /// Stop playback, release held notes and join the thread
+    void stop();
+
+    /// Block until playback reaches the end of the file or is stopped
+    void wait();
+
+    bool isPlaying() const { return playing_.load(std::memory_order_acquire); }
+    uint64_t eventsSent() const { return events_sent_.load(std::memory_order_relaxed); }
+    JitterStats jitter() const { return jitter_.stats(); }
+
+private:
+    void run();
+    void send(const MidiFileEvent& event);
+    void releaseHeldNotes();
+
+    MidiFilePlayerConfig config_;
+    MidiFile file_;
+    OutputCallback output_;
+
+    std::thread thread_;
+    std::atomic<bool> playing_{false};
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<uint64_t> events_sent_{0};
+    JitterMeter jitter_;
+
+    // Playback thread only
+    std::vector<uint8_t> sysex_scratch_;
+    uint16_t held_notes_[16][8] = {};  // 128-bit note bitmap per channel
+};
+
+}  // namespace oc::hal::midi
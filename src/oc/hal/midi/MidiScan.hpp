@@ -0,0 +1,104 @@
+#pragma once
+
+/**
+ * @file MidiScan.hpp
+ * @brief Vectorised search for MIDI status bytes
+ *
+ * findStatusByte() returns the first byte >= 0x80 (status, realtime or the
+ * SysEx F7 terminator) in a range. Data runs inside large SysEx dumps are
+ * skipped 16/32 bytes at a time:
+ * - AVX2 when compiled with -mavx2 / /arch:AVX2
+ * - SSE2 on every x86-64 target
+ * - NEON on AArch64
+ * - Scalar fallback elsewhere
+ *
+ * The implementation is selected at compile time; MIDI_SCAN_ISA names it.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define OC_MIDI_SCAN_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OC_MIDI_SCAN_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define OC_MIDI_SCAN_NEON 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace oc::hal::midi {
+
+#if defined(OC_MIDI_SCAN_AVX2)
+inline constexpr const char* MIDI_SCAN_ISA = "avx2";
+#elif defined(OC_MIDI_SCAN_SSE2)
+inline constexpr const char* MIDI_SCAN_ISA = "sse2";
+#elif defined(OC_MIDI_SCAN_NEON)
+inline constexpr const char* MIDI_SCAN_ISA = "neon";
+#else
+inline constexpr const char* MIDI_SCAN_ISA = "scalar";
+#endif
+
+/// Scalar scan for the next status byte (>= 0x80) in [begin, end)
+inline const uint8_t* findStatusByteScalar(const uint8_t* begin, const uint8_t* end) {
+    while (begin < end && *begin < 0x80) ++begin;
+    return begin;
+}
+
+namespace detail {
+
+inline unsigned countTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+}  // namespace detail
+
+/// Next status byte (>= 0x80) in [begin, end), or end if there is none
+inline const uint8_t* findStatusByte(const uint8_t* begin, const uint8_t* end) {
+    const uint8_t* p = begin;
+
+    // Dense traffic: the very next byte is often the status byte.
+    if (p < end && *p >= 0x80) return p;
+
+#if defined(OC_MIDI_SCAN_AVX2)
+    while (end - p >= 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        // movemask collects the high bit of each byte: exactly "byte >= 0x80".
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(v));
+        if (mask) return p + detail::countTrailingZeros(mask);
+        p += 32;
+    }
+#endif
+
+#if defined(OC_MIDI_SCAN_AVX2) || defined(OC_MIDI_SCAN_SSE2)
+    while (end - p >= 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(v));
+        if (mask) return p + detail::countTrailingZeros(mask);
+        p += 16;
+    }
+#elif defined(OC_MIDI_SCAN_NEON)
+    while (end - p >= 16) {
+        const uint8x16_t v = vld1q_u8(p);
+        if (vmaxvq_u8(v) >= 0x80) return findStatusByteScalar(p, p + 16);
+        p += 16;
+    }
+#endif
+
+    return findStatusByteScalar(p, end);
+}
+
+}  // namespace oc::hal::midi
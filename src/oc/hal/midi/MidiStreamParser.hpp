@@ -0,0 +1,276 @@
+#pragma once
+
+/**
+ * @file MidiStreamParser.hpp
+ * @brief Incremental MIDI 1.0 byte-stream parser (zero allocation)
+ *
+ * Turns an arbitrary byte stream (rawmidi, serial, network, or libremidi
+ * messages) into complete MIDI messages:
+ * - Running status for channel voice messages
+ * - Realtime bytes (F8-FF) delivered immediately, even inside SysEx or
+ *   between the data bytes of a channel message
+ * - SysEx split across any number of parse() calls
+ * - System common messages (F1-F6) cancel running status
+ *
+ * SysEx bodies are accumulated in a caller-provided buffer; the parser itself
+ * never allocates. A SysEx larger than the buffer is dropped and counted.
+ * Inside SysEx, data runs are located with findStatusByte() (SIMD) and
+ * copied in bulk rather than byte by byte.
+ *
+ * Chunked SysEx: when parse() is given a chunk handler, a SysEx that does
+ * not fit in the buffer is delivered in buffer-sized fragments instead of
+ * being dropped (Begin, Data..., End), so the buffer bounds memory use
+ * regardless of dump size. SysEx that fit are still delivered whole
+ * through the message handler.
+ *
+ * Usage:
+ *   std::array<uint8_t, 1024> sysex;
+ *   MidiStreamParser parser(sysex.data(), sysex.size());
+ *   parser.parse(bytes, count, [](const uint8_t* msg, size_t len) { ... });
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "MidiScan.hpp"
+
+namespace oc::hal::midi {
+
+/// Number of data bytes following a status byte (channel voice / system common)
+constexpr uint8_t midiDataLength(uint8_t status) {
+    if (status < 0xF0) {
+        const uint8_t type = status & 0xF0;
+        return (type == 0xC0 || type == 0xD0) ? 1 : 2;
+    }
+    switch (status) {
+        case 0xF1: return 1;  // MTC quarter frame
+        case 0xF2: return 2;  // Song position pointer
+        case 0xF3: return 1;  // Song select
+        default: return 0;
+    }
+}
+
+/// Position of a fragment within a chunked SysEx
+enum class SysExChunkPhase : uint8_t {
+    Begin,  ///< First fragment, starts with F0
+    Data,   ///< Middle fragment
+    End,    ///< Last fragment, ends with F7
+    Abort   ///< SysEx cut by another status byte (no data)
+};
+
+class MidiStreamParser {
+public:
+    struct Stats {
+        uint32_t messages = 0;        ///< Complete messages delivered
+        uint32_t sysexOverflows = 0;  ///< SysEx dropped: larger than the buffer
+        uint32_t sysexAborted = 0;    ///< SysEx cut by a non-realtime status byte
+        uint32_t strayBytes = 0;      ///< Data bytes without status, stray F7
+        uint32_t sysexChunks = 0;     ///< Fragments delivered to a chunk handler
+    };
+
+    MidiStreamParser() = default;
+    MidiStreamParser(uint8_t* sysexBuffer, size_t sysexCapacity)
+        : sysex_(sysexBuffer), sysex_capacity_(sysexCapacity) {}
+
+    /// Replace the SysEx buffer (resets parser state)
+    void setSysExBuffer(uint8_t* buffer, size_t capacity) {
+        sysex_ = buffer;
+        sysex_capacity_ = capacity;
+        reset();
+    }
+
+    /// Forget running status and any partial message
+    void reset() {
+        status_ = 0;
+        expected_ = 0;
+        count_ = 0;
+        in_sysex_ = false;
+        sysex_length_ = 0;
+        sysex_overflow_ = false;
+        sysex_chunked_ = false;
+    }
+
+    bool inSysEx() const { return in_sysex_; }
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+    /**
+     * @brief Consume bytes, calling handler(data, length) per complete message
+     *
+     * The pointer passed to the handler is only valid during the call.
+     * SysEx larger than the buffer is dropped (Stats::sysexOverflows).
+     */
+    template <typename Handler>
+    void parse(const uint8_t* data, size_t length, Handler&& handler) {
+        parse(data, length, handler, NoChunks{});
+    }
+
+    /**
+     * @brief Consume bytes, delivering oversized SysEx in fragments
+     *
+     * chunkHandler(SysExChunkPhase phase, const uint8_t* data, size_t length)
+     * receives each buffer-sized fragment of a SysEx larger than the buffer.
+     */
+    template <typename Handler, typename ChunkHandler>
+    void parse(const uint8_t* data, size_t length, Handler&& handler,
+               ChunkHandler&& chunkHandler) {
+        const uint8_t* p = data;
+        const uint8_t* end = data + length;
+
+        while (p < end) {
+            if (in_sysex_) {
+                // Bulk path: copy the whole data run up to the next status byte.
+                const uint8_t* run = findStatusByte(p, end);
+                appendSysEx(p, static_cast<size_t>(run - p), chunkHandler);
+                p = run;
+                if (p == end) break;
+            }
+
+            const uint8_t b = *p++;
+            if (b >= 0x80) {
+                handleStatus(b, handler, chunkHandler);
+            } else {
+                handleData(b, handler);
+            }
+        }
+    }
+
+private:
+    template <typename Handler>
+    void emit(const uint8_t* data, size_t length, Handler& handler) {
+        ++stats_.messages;
+        handler(data, length);
+    }
+
+    struct NoChunks {
+        void operator()(SysExChunkPhase, const uint8_t*, size_t) const {}
+    };
+
+    template <typename ChunkHandler>
+    void flushChunk(SysExChunkPhase phase, ChunkHandler& chunkHandler) {
+        ++stats_.sysexChunks;
+        chunkHandler(phase, sysex_, sysex_length_);
+        sysex_length_ = 0;
+    }
+
+    template <typename ChunkHandler>
+    void appendSysEx(const uint8_t* data, size_t length, ChunkHandler& chunkHandler) {
+        constexpr bool chunked = !std::is_same_v<std::decay_t<ChunkHandler>, NoChunks>;
+
+        while (length > 0 && !sysex_overflow_) {
+            const size_t room = sysex_capacity_ - sysex_length_;
+            if (length <= room) {
+                std::memcpy(sysex_ + sysex_length_, data, length);
+                sysex_length_ += length;
+                return;
+            }
+            if (!chunked || sysex_capacity_ == 0) {
+                sysex_overflow_ = true;
+                return;
+            }
+
+            // Buffer full: hand it out and keep going.
+            std::memcpy(sysex_ + sysex_length_, data, room);
+            sysex_length_ += room;
+            data += room;
+            length -= room;
+            flushChunk(sysex_chunked_ ? SysExChunkPhase::Data : SysExChunkPhase::Begin,
+                       chunkHandler);
+            sysex_chunked_ = true;
+        }
+    }
+
+    template <typename Handler, typename ChunkHandler>
+    void handleStatus(uint8_t b, Handler& handler, ChunkHandler& chunkHandler) {
+        if (b >= 0xF8) {
+            // Realtime: no effect on running status or SysEx in progress.
+            emit(&b, 1, handler);
+            return;
+        }
+
+        if (b == 0xF7) {
+            if (!in_sysex_) {
+                ++stats_.strayBytes;
+                return;
+            }
+            appendSysEx(&b, 1, chunkHandler);
+            in_sysex_ = false;
+            if (sysex_overflow_) {
+                ++stats_.sysexOverflows;
+            } else if (sysex_chunked_) {
+                flushChunk(SysExChunkPhase::End, chunkHandler);
+            } else {
+                emit(sysex_, sysex_length_, handler);
+            }
+            sysex_chunked_ = false;
+            return;
+        }
+
+        if (in_sysex_) {
+            // Any other status byte terminates an unfinished SysEx.
+            ++stats_.sysexAborted;
+            in_sysex_ = false;
+            if (sysex_chunked_) {
+                sysex_length_ = 0;
+                flushChunk(SysExChunkPhase::Abort, chunkHandler);
+                sysex_chunked_ = false;
+            }
+        }
+
+        if (b == 0xF0) {
+            status_ = 0;
+            in_sysex_ = true;
+            sysex_length_ = 0;
+            sysex_overflow_ = false;
+            sysex_chunked_ = false;
+            appendSysEx(&b, 1, chunkHandler);
+            return;
+        }
+
+        status_ = b;
+        expected_ = midiDataLength(b);
+        count_ = 0;
+        msg_[0] = b;
+
+        if (b >= 0xF0) {
+            // System common: no running status.
+            if (expected_ == 0) {
+                status_ = 0;
+                if (b == 0xF6) emit(msg_, 1, handler);  // Tune request
+            }
+        }
+    }
+
+    template <typename Handler>
+    void handleData(uint8_t b, Handler& handler) {
+        if (status_ == 0) {
+            ++stats_.strayBytes;
+            return;
+        }
+
+        msg_[1 + count_++] = b;
+        if (count_ < expected_) return;
+
+        emit(msg_, 1 + expected_, handler);
+        count_ = 0;
+        if (status_ >= 0xF0) status_ = 0;
+    }
+
+    uint8_t* sysex_ = nullptr;
+    size_t sysex_capacity_ = 0;
+    size_t sysex_length_ = 0;
+    bool in_sysex_ = false;
+    bool sysex_overflow_ = false;
+    bool sysex_chunked_ = false;  // Begin fragment already delivered
+
+    uint8_t status_ = 0;
+    uint8_t expected_ = 0;
+    uint8_t count_ = 0;
+    uint8_t msg_[3] = {0, 0, 0};
+
+    Stats stats_;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,148 @@
+#pragma once
+
+/**
+ * @file MidiSubscribers.hpp
+ * @brief Fan-out of decoded input to any number of subscribers
+ *
+ * Each subscriber gives a mask of MidiEventType bits (midiEventBit()) and
+ * receives, for every matching message, the same decoded MidiEvent and a
+ * view of the original bytes (SysEx included): nothing is copied per
+ * subscriber.
+ *
+ * Subscribers may subscribe or unsubscribe anyone, themselves included,
+ * from inside a dispatch:
+ * - Added subscribers are parked and join after the outermost dispatch
+ *   returns, so the list being iterated never reallocates; the room they
+ *   need is reserved by subscribe(), in a spare list
+ * - Removed subscribers are only marked; they receive nothing more and are
+ *   compacted out after the dispatch
+ *
+ * dispatch() itself never allocates. Main thread only, except
+ * interestMask(), which any thread may read.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "MidiEvent.hpp"
+
+namespace oc::hal::midi {
+
+class MidiSubscribers {
+public:
+    using Subscriber = std::function<void(const MidiEvent& event, const uint8_t* data,
+                                          size_t length, uint64_t timestampUs)>;
+    using Id = uint32_t;
+
+    static constexpr Id INVALID_ID = 0;
+
+    /// @param typeMask OR of midiEventBit() values
+    Id subscribe(uint32_t typeMask, Subscriber subscriber) {
+        if (!subscriber || typeMask == 0) return INVALID_ID;
+        const Id id = next_id_++;
+        Entry entry{id, typeMask, std::move(subscriber)};
+        if (depth_ > 0) {
+            added_.push_back(std::move(entry));
+            // entries_ may not move now (a subscriber in it is running).
+            const size_t needed = entries_.size() + added_.size();
+            if (entries_.capacity() < needed) spare_.reserve(needed);
+        } else {
+            entries_.push_back(std::move(entry));
+        }
+        updateMask();
+        return id;
+    }
+
+    /// @return false if @p id is not subscribed
+    bool unsubscribe(Id id) {
+        for (auto* list : {&entries_, &added_}) {
+            for (auto& entry : *list) {
+                if (entry.id != id || entry.mask == 0) continue;
+                entry.mask = 0;  // Skipped from now on, removed after dispatch
+                removed_ = true;
+                if (depth_ == 0) compact();
+                updateMask();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Any thread: union of all subscriber masks
+    uint32_t interestMask() const { return interest_.load(std::memory_order_relaxed); }
+
+    size_t size() const {
+        size_t count = 0;
+        for (const auto* list : {&entries_, &added_}) {
+            for (const auto& entry : *list) count += entry.mask != 0;
+        }
+        return count;
+    }
+
+    void dispatch(const MidiEvent& event, const uint8_t* data, size_t length,
+                  uint64_t timestampUs) {
+        const uint32_t bit = midiEventBit(event.type);
+        if (!(interestMask() & bit)) return;
+
+        ++depth_;
+        // Index loop: entries_ does not grow while depth_ > 0.
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].mask & bit) entries_[i].subscriber(event, data, length, timestampUs);
+        }
+        if (--depth_ == 0) {
+            if (removed_) compact();
+            if (!added_.empty()) {
+                if (entries_.capacity() < entries_.size() + added_.size()) {
+                    // Move into the room subscribe() reserved instead of growing.
+                    for (auto& entry : entries_) spare_.push_back(std::move(entry));
+                    entries_.swap(spare_);
+                    spare_.clear();
+                }
+                for (auto& entry : added_) {
+                    if (entry.mask) entries_.push_back(std::move(entry));
+                }
+                added_.clear();
+            }
+        }
+    }
+
+private:
+    struct Entry {
+        Id id;
+        uint32_t mask;  ///< 0 = unsubscribed
+        Subscriber subscriber;
+    };
+
+    void compact() {
+        size_t out = 0;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (entries_[i].mask == 0) continue;
+            if (out != i) entries_[out] = std::move(entries_[i]);
+            ++out;
+        }
+        entries_.resize(out);
+        removed_ = false;
+    }
+
+    void updateMask() {
+        uint32_t mask = 0;
+        for (const auto* list : {&entries_, &added_}) {
+            for (const auto& entry : *list) mask |= entry.mask;
+        }
+        interest_.store(mask, std::memory_order_relaxed);
+    }
+
+    std::vector<Entry> entries_;
+    std::vector<Entry> added_;
+    std::vector<Entry> spare_;  ///< Empty; capacity for the next merge
+    std::atomic<uint32_t> interest_{0};
+    Id next_id_ = 1;
+    uint32_t depth_ = 0;
+    bool removed_ = false;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file MidiThru.hpp
+ * @brief Soft MIDI thru: forward selected input straight to outputs
+ *
+ * Runs on the receive thread right after framing, so echoed input skips
+ * the queue, update() and the application round trip. Each route selects
+ * messages by type (midiEventBit() mask) and maps input channels to output
+ * channels (or drops them), then hands the message to its sink:
+ * - Channel unchanged (and every non-channel message): the original bytes
+ *   are forwarded, no copy
+ * - Channel remapped: the (at most 3-byte) message is rewritten on the
+ *   stack
+ *
+ * A route without a sink forwards to the default sink given to forward()
+ * (LibreMidiTransport: its own output). Routes are set up before input
+ * starts; forward() never allocates and only reads the routes.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "MidiEvent.hpp"
+
+namespace oc::hal::midi {
+
+class MidiThru {
+public:
+    using Sink = std::function<void(const uint8_t* data, size_t length)>;
+
+    /// channelMap value dropping the channel
+    static constexpr uint8_t DROP = 0xFF;
+
+    struct Route {
+        /// Types forwarded (OR of midiEventBit(); default: everything)
+        uint32_t typeMask = ~0u;
+
+        /// Output channel per input channel, or DROP (default: identity)
+        uint8_t channelMap[16];
+
+        /// Destination; empty = the default sink of forward()
+        Sink sink;
+
+        Route() {
+            for (uint8_t ch = 0; ch < 16; ++ch) channelMap[ch] = ch;
+        }
+
+        /// Forward input channel @p from only, as channel @p to
+        Route& onlyChannel(uint8_t from, uint8_t to) {
+            for (auto& ch : channelMap) ch = DROP;
+            channelMap[from & 0x0F] = to & 0x0F;
+            return *this;
+        }
+    };
+
+    void add(Route route) { routes_.push_back(std::move(route)); }
+    void clear() { routes_.clear(); }
+    bool empty() const { return routes_.empty(); }
+
+    /**
+     * @brief Forward one complete message through every matching route
+     * @param defaultSink Called as defaultSink(data, length) for routes without a sink
+     * @return Number of sends
+     */
+    template <typename DefaultSink>
+    size_t forward(const uint8_t* data, size_t length, DefaultSink&& defaultSink) const {
+        MidiEvent event;
+        if (routes_.empty() || !decodeMidiEvent(data, length, event)) return 0;
+        const uint32_t bit = midiEventBit(event.type);
+        const bool channelVoice = data[0] < 0xF0;
+
+        size_t sent = 0;
+        for (const auto& route : routes_) {
+            if (!(route.typeMask & bit)) continue;
+
+            const uint8_t* out = data;
+            uint8_t remapped[3];
+            if (channelVoice) {
+                const uint8_t to = route.channelMap[event.channel];
+                if (to == DROP) continue;
+                if (to != event.channel) {
+                    std::memcpy(remapped, data, length < 3 ? length : 3);
+                    remapped[0] = static_cast<uint8_t>((data[0] & 0xF0) | (to & 0x0F));
+                    out = remapped;
+                }
+            }
+
+            if (route.sink) {
+                route.sink(out, length);
+            } else {
+                defaultSink(out, length);
+            }
+            ++sent;
+        }
+        return sent;
+    }
+
+private:
+    std::vector<Route> routes_;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * @file MidiTimecode.hpp
+ * @brief MIDI Time Code positions, frame arithmetic and message encoding
+ *
+ * - MtcTime: hh:mm:ss:ff plus frame rate, as carried by MTC
+ * - mtcToFrames() / mtcFromFrames(): frame count since 00:00:00:00,
+ *   drop-frame aware (29.97 fps skips frames 0 and 1 of every minute
+ *   except every tenth), wrapping at 24 hours
+ * - mtcQuarterFrameData(): data byte of quarter-frame piece 0-7 (F1 xx)
+ * - mtcFullFrame() / mtcParseFullFrame(): the F0 7F <dev> 01 01 ... F7
+ *   full-frame message used to locate
+ *
+ * Eight quarter frames, four per frame, carry one position: the frame at
+ * which piece 0 was sent.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+/// Rate code carried in quarter-frame piece 7 and full-frame hours
+enum class MtcRate : uint8_t {
+    Fps24 = 0,
+    Fps25 = 1,
+    Fps2997Drop = 2,
+    Fps30 = 3
+};
+
+struct MtcTime {
+    uint8_t hours = 0;
+    uint8_t minutes = 0;
+    uint8_t seconds = 0;
+    uint8_t frames = 0;
+    MtcRate rate = MtcRate::Fps25;
+
+    bool operator==(const MtcTime& other) const {
+        return hours == other.hours && minutes == other.minutes &&
+               seconds == other.seconds && frames == other.frames && rate == other.rate;
+    }
+    bool operator!=(const MtcTime& other) const { return !(*this == other); }
+};
+
+/// Frame numbers per second (30 for 29.97 drop-frame)
+inline uint32_t mtcNominalFps(MtcRate rate) {
+    switch (rate) {
+        case MtcRate::Fps24: return 24;
+        case MtcRate::Fps25: return 25;
+        default: return 30;
+    }
+}
+
+/// Real duration of one frame, in microseconds
+inline double mtcFramePeriodUs(MtcRate rate) {
+    return rate == MtcRate::Fps2997Drop ? 1001000000.0 / 30000.0
+                                        : 1000000.0 / mtcNominalFps(rate);
+}
+
+inline uint32_t mtcFramesPerDay(MtcRate rate) {
+    // Drop-frame: 17982 frames per 10 minutes
+    return rate == MtcRate::Fps2997Drop ? 24u * 6u * 17982u : 24u * 3600u * mtcNominalFps(rate);
+}
+
+inline uint32_t mtcToFrames(const MtcTime& time) {
+    const uint32_t fps = mtcNominalFps(time.rate);
+    uint32_t frames =
+        ((time.hours * 60u + time.minutes) * 60u + time.seconds) * fps + time.frames;
+    if (time.rate == MtcRate::Fps2997Drop) {
+        const uint32_t totalMinutes = time.hours * 60u + time.minutes;
+        frames -= 2u * (totalMinutes - totalMinutes / 10u);
+    }
+    return frames;
+}
+
+inline MtcTime mtcFromFrames(uint32_t frames, MtcRate rate) {
+    frames %= mtcFramesPerDay(rate);
+    if (rate == MtcRate::Fps2997Drop) {
+        // Re-insert the dropped frame numbers, then count at 30.
+        const uint32_t tens = frames / 17982u;
+        const uint32_t rest = frames % 17982u;
+        frames += 18u * tens + (rest < 2u ? 0u : 2u * ((rest - 2u) / 1798u));
+    }
+
+    const uint32_t fps = mtcNominalFps(rate);
+    MtcTime time;
+    time.rate = rate;
+    time.frames = static_cast<uint8_t>(frames % fps);
+    const uint32_t seconds = frames / fps;
+    time.seconds = static_cast<uint8_t>(seconds % 60u);
+    time.minutes = static_cast<uint8_t>((seconds / 60u) % 60u);
+    time.hours = static_cast<uint8_t>(seconds / 3600u);
+    return time;
+}
+
+/// Data byte of quarter-frame message @p piece (0-7): piece << 4 | nibble
+inline uint8_t mtcQuarterFrameData(const MtcTime& time, uint8_t piece) {
+    piece &= 0x07;
+    uint8_t nibble = 0;
+    switch (piece) {
+        case 0: nibble = time.frames & 0x0F; break;
+        case 1: nibble = (time.frames >> 4) & 0x01; break;
+        case 2: nibble = time.seconds & 0x0F; break;
+        case 3: nibble = (time.seconds >> 4) & 0x03; break;
+        case 4: nibble = time.minutes & 0x0F; break;
+        case 5: nibble = (time.minutes >> 4) & 0x03; break;
+        case 6: nibble = time.hours & 0x0F; break;
+        case 7:
+            nibble = static_cast<uint8_t>(((time.hours >> 4) & 0x01) |
+                                          (static_cast<uint8_t>(time.rate) << 1));
+            break;
+    }
+    return static_cast<uint8_t>((piece << 4) | nibble);
+}
+
+/// Position carried by the nibbles of pieces 0-7 (index = piece)
+inline MtcTime mtcFromQuarterFrames(const uint8_t nibbles[8]) {
+    MtcTime time;
+    time.frames = static_cast<uint8_t>(nibbles[0] | ((nibbles[1] & 0x01) << 4));
+    time.seconds = static_cast<uint8_t>(nibbles[2] | ((nibbles[3] & 0x03) << 4));
+    time.minutes = static_cast<uint8_t>(nibbles[4] | ((nibbles[5] & 0x03) << 4));
+    time.hours = static_cast<uint8_t>(nibbles[6] | ((nibbles[7] & 0x01) << 4));
+    time.rate = static_cast<MtcRate>((nibbles[7] >> 1) & 0x03);
+    return time;
+}
+
+inline constexpr size_t MTC_FULL_FRAME_SIZE = 10;
+
+/// Write F0 7F 7F 01 01 hh mm ss ff F7 (all devices) to @p out
+inline size_t mtcFullFrame(const MtcTime& time, uint8_t* out) {
+    out[0] = 0xF0;
+    out[1] = 0x7F;
+    out[2] = 0x7F;
+    out[3] = 0x01;
+    out[4] = 0x01;
+    out[5] = static_cast<uint8_t>((static_cast<uint8_t>(time.rate) << 5) | (time.hours & 0x1F));
+    out[6] = time.minutes & 0x3F;
+    out[7] = time.seconds & 0x3F;
+    out[8] = time.frames & 0x1F;
+    out[9] = 0xF7;
+    return MTC_FULL_FRAME_SIZE;
+}
+
+/// @return false unless @p data is a full-frame message (any device ID)
+inline bool mtcParseFullFrame(const uint8_t* data, size_t length, MtcTime& out) {
+    if (length != MTC_FULL_FRAME_SIZE || data[0] != 0xF0 || data[1] != 0x7F ||
+        data[3] != 0x01 || data[4] != 0x01 || data[9] != 0xF7) {
+        return false;
+    }
+    out.rate = static_cast<MtcRate>((data[5] >> 5) & 0x03);
+    out.hours = data[5] & 0x1F;
+    out.minutes = data[6] & 0x3F;
+    out.seconds = data[7] & 0x3F;
+    out.frames = data[8] & 0x1F;
+    return true;
+}
+
+}  // namespace oc::hal::midi
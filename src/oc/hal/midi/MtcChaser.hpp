@@ -0,0 +1,167 @@
+#pragma once
+
+/**
+ * @file MtcChaser.hpp
+ * @brief Follow incoming MIDI Time Code; position readable from any thread
+ *
+ * One writer (the receive path) feeds quarter frames (F1 xx) and full-frame
+ * messages. Every complete run of pieces 0-7 publishes a reference: the
+ * position it carries and the time piece 0 arrived, estimated from the
+ * arrival times of all eight pieces so the jitter of a single message does
+ * not move it. Readers extrapolate from the reference:
+ * - position() is lock-free: a seqlock read of three fields, retried only
+ *   if a new reference is published during the read
+ * - Lock takes one complete run: 2 to 4 frames after quarter frames start
+ * - running turns false when no quarter frame has arrived for 2 frames; the
+ *   position then stays at the last one received
+ * - A full-frame message locates: the position is set, not running
+ *
+ * Pieces arriving out of order (reverse play, lost messages) discard the
+ * current run; the position is kept until the next complete run.
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "MidiTimecode.hpp"
+
+namespace oc::hal::midi {
+
+struct MtcPosition {
+    MtcTime time;          ///< Current frame
+    double frames = 0.0;   ///< Frames since 00:00:00:00, with the fraction
+    bool locked = false;   ///< A position has been received
+    bool running = false;  ///< Quarter frames are arriving
+};
+
+class MtcChaser {
+public:
+    MtcChaser() = default;
+
+    MtcChaser(const MtcChaser&) = delete;
+    MtcChaser& operator=(const MtcChaser&) = delete;
+
+    /// Writer only: data byte of one quarter-frame message
+    /// @return true if it completed a run and published a new position
+    bool applyQuarterFrame(uint8_t data, uint64_t timestampUs) {
+        last_quarter_frame_us_.store(timestampUs, std::memory_order_release);
+
+        const uint8_t piece = (data >> 4) & 0x07;
+        if (piece == 0) {
+            next_piece_ = 0;
+        } else if (piece != next_piece_) {
+            next_piece_ = NO_RUN;
+            return false;
+        }
+        nibbles_[piece] = data & 0x0F;
+        arrivals_[piece] = timestampUs;
+        if (piece != 7) {
+            ++next_piece_;
+            return false;
+        }
+        next_piece_ = NO_RUN;
+
+        const MtcTime time = mtcFromQuarterFrames(nibbles_);
+        const double quarterUs = mtcFramePeriodUs(time.rate) / 4.0;
+        double startUs = 0.0;
+        for (uint8_t i = 0; i < 8; ++i) {
+            startUs += static_cast<double>(arrivals_[i]) - i * quarterUs;
+        }
+        publish(mtcToFrames(time), time.rate, static_cast<uint64_t>(startUs / 8.0 + 0.5));
+        return true;
+    }
+
+    /// Writer only: locate from a full-frame message
+    /// @return true if @p data was one
+    bool applyFullFrame(const uint8_t* data, size_t length, uint64_t timestampUs) {
+        MtcTime time;
+        if (!mtcParseFullFrame(data, length, time)) return false;
+        next_piece_ = NO_RUN;
+        last_quarter_frame_us_.store(0, std::memory_order_release);
+        publish(mtcToFrames(time), time.rate, timestampUs);
+        return true;
+    }
+
+    /// Writer only: forget the position
+    void reset() {
+        next_piece_ = NO_RUN;
+        write([&] { locked_.store(false, std::memory_order_relaxed); });
+        last_quarter_frame_us_.store(0, std::memory_order_release);
+    }
+
+    /// Any thread: position at @p nowUs (steady clock, as message timestamps)
+    MtcPosition position(uint64_t nowUs) const {
+        uint32_t frames;
+        MtcRate rate;
+        uint64_t referenceUs;
+        bool locked;
+        for (;;) {
+            const uint32_t before = sequence_.load(std::memory_order_acquire);
+            if (before & 1u) continue;  // Write in progress
+            frames = frames_.load(std::memory_order_relaxed);
+            rate = static_cast<MtcRate>(rate_.load(std::memory_order_relaxed));
+            referenceUs = reference_us_.load(std::memory_order_relaxed);
+            locked = locked_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) break;
+        }
+
+        MtcPosition out;
+        if (!locked) return out;
+        out.locked = true;
+
+        const double periodUs = mtcFramePeriodUs(rate);
+        const uint64_t lastUs = last_quarter_frame_us_.load(std::memory_order_acquire);
+        out.running = lastUs != 0 && nowUs < lastUs + static_cast<uint64_t>(2.0 * periodUs);
+
+        // Stopped: hold the position of the last quarter frame.
+        const uint64_t atUs = out.running ? nowUs : (lastUs > referenceUs ? lastUs : referenceUs);
+        const double elapsed =
+            atUs > referenceUs ? static_cast<double>(atUs - referenceUs) / periodUs : 0.0;
+        out.frames = frames + elapsed;
+        out.time = mtcFromFrames(static_cast<uint32_t>(std::floor(out.frames)), rate);
+        return out;
+    }
+
+    /// Even, and different after every published position
+    uint32_t version() const { return sequence_.load(std::memory_order_acquire) & ~1u; }
+
+private:
+    static constexpr uint8_t NO_RUN = 0xFF;
+
+    void publish(uint32_t frames, MtcRate rate, uint64_t referenceUs) {
+        write([&] {
+            frames_.store(frames, std::memory_order_relaxed);
+            rate_.store(static_cast<uint8_t>(rate), std::memory_order_relaxed);
+            reference_us_.store(referenceUs, std::memory_order_relaxed);
+            locked_.store(true, std::memory_order_relaxed);
+        });
+    }
+
+    // Seqlock write: odd sequence while the reference is being modified.
+    template <typename Fn>
+    void write(Fn&& fn) {
+        const uint32_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fn();
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Writer only: run being assembled
+    uint8_t nibbles_[8] = {};
+    uint64_t arrivals_[8] = {};
+    uint8_t next_piece_ = NO_RUN;
+
+    // Published reference
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<uint32_t> frames_{0};
+    std::atomic<uint8_t> rate_{0};
+    std::atomic<uint64_t> reference_us_{0};
+    std::atomic<bool> locked_{false};
+    std::atomic<uint64_t> last_quarter_frame_us_{0};
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,65 @@
+#include "MtcGenerator.hpp"
+
+namespace oc::hal::midi {
+
+MtcGenerator::MtcGenerator() : MtcGenerator(MtcGeneratorConfig{}) {}
+
+MtcGenerator::MtcGenerator(const MtcGeneratorConfig& config) : config_(config) {}
+
+MtcGenerator::~MtcGenerator() { stop(); }
+
+void MtcGenerator::setOutput(OutputCallback cb) { output_ = std::move(cb); }
+
+bool MtcGenerator::start(const MtcTime& from) {
+    if (!output_) return false;
+    stop();
+
+    stop_requested_.store(false, std::memory_order_relaxed);
+    sent_.store(0, std::memory_order_relaxed);
+    jitter_.reset();
+    rate_.store(from.rate, std::memory_order_relaxed);
+    frames_.store(mtcToFrames(from), std::memory_order_relaxed);
+
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void MtcGenerator::stop() {
+    stop_requested_.store(true, std::memory_order_relaxed);
+    if (thread_.joinable()) thread_.join();
+}
+
+void MtcGenerator::run() {
+    if (config_.realtimePriority) raiseThreadPriority();
+
+    const uint32_t startFrame = frames_.load(std::memory_order_relaxed);
+    const MtcRate rate = rate_.load(std::memory_order_relaxed);
+    if (config_.sendFullFrame) {
+        uint8_t fullFrame[MTC_FULL_FRAME_SIZE];
+        output_(fullFrame, mtcFullFrame(mtcFromFrames(startFrame, rate), fullFrame));
+    }
+
+    const double quarterUs = mtcFramePeriodUs(rate) / 4.0;
+    const uint64_t startUs = steadyNowUs() + config_.startDelayUs;
+    MtcTime runTime;
+
+    for (uint64_t n = 0;; ++n) {
+        const uint64_t deadlineUs = startUs + static_cast<uint64_t>(n * quarterUs + 0.5);
+        if (!sleepUntilUs(deadlineUs, config_.spinUs, &stop_requested_)) break;
+        jitter_.record(static_cast<int64_t>(steadyNowUs() - deadlineUs));
+
+        // Each run of pieces 0-7 spans two frames and carries the first.
+        const uint8_t piece = static_cast<uint8_t>(n & 7);
+        if (piece == 0) runTime = mtcFromFrames(startFrame + static_cast<uint32_t>(n / 4), rate);
+        const uint8_t msg[2] = {0xF1, mtcQuarterFrameData(runTime, piece)};
+        output_(msg, sizeof(msg));
+
+        sent_.fetch_add(1, std::memory_order_relaxed);
+        frames_.store(startFrame + static_cast<uint32_t>(n / 4), std::memory_order_relaxed);
+    }
+
+    running_.store(false, std::memory_order_release);
+}
+
+}  // namespace oc::hal::midi
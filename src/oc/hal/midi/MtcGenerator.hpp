@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file MtcGenerator.hpp
+ * @brief MIDI Time Code quarter-frame output on a high-resolution timer thread
+ *
+ * Sends four quarter frames per frame (96 per second at 24 fps, 120 at
+ * 30 fps). Each one is scheduled against an absolute deadline (start time
+ * + n quarter-frame periods), like MidiFilePlayer events, so errors never
+ * accumulate over a long run, and its lateness is recorded in a
+ * JitterMeter. Drop-frame 29.97 runs at 30000/1001 frames per second.
+ *
+ * start() first sends a full-frame message (optional) so receivers locate
+ * before the quarter frames begin. To locate while running, start() again.
+ *
+ * Usage:
+ *   MtcGenerator mtc;
+ *   mtc.setOutput([&](const uint8_t* data, size_t length) {
+ *       transport.sendMessage(data, length);
+ *   });
+ *   mtc.start(MtcTime{1, 0, 0, 0, MtcRate::Fps25});
+ *   ...
+ *   auto jitter = mtc.jitter();
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "MidiTimecode.hpp"
+#include "Timing.hpp"
+
+namespace oc::hal::midi {
+
+struct MtcGeneratorConfig {
+    /// Send a full-frame message before the first quarter frame
+    bool sendFullFrame = true;
+
+    /// Delay between start() and the first quarter frame
+    uint32_t startDelayUs = 2000;
+
+    /// Spin window before each deadline (see sleepUntilUs)
+    uint32_t spinUs = DEFAULT_SPIN_US;
+
+    /// Try to run the timer thread with realtime priority
+    bool realtimePriority = true;
+};
+
+class MtcGenerator {
+public:
+    /// Receives one complete MIDI message per call, on the timer thread
+    using OutputCallback = std::function<void(const uint8_t* data, size_t length)>;
+
+    MtcGenerator();
+    explicit MtcGenerator(const MtcGeneratorConfig& config);
+    ~MtcGenerator();
+
+    // Non-copyable, non-movable (owns a thread referencing this)
+    MtcGenerator(const MtcGenerator&) = delete;
+    MtcGenerator& operator=(const MtcGenerator&) = delete;
+
+    /// Must be set before start()
+    void setOutput(OutputCallback cb);
+
+    /// Run from @p from (stops a running generator first)
+    bool start(const MtcTime& from);
+
+    /// Stop sending and join the thread
+    void stop();
+
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /// Frame being sent, as a frame count since 00:00:00:00
+    uint32_t frames() const { return frames_.load(std::memory_order_relaxed); }
+
+    /// Frame being sent
+    MtcTime position() const {
+        return mtcFromFrames(frames(), rate_.load(std::memory_order_relaxed));
+    }
+
+    uint64_t quarterFramesSent() const { return sent_.load(std::memory_order_relaxed); }
+    JitterStats jitter() const { return jitter_.stats(); }
+
+private:
+    void run();
+
+    MtcGeneratorConfig config_;
+    OutputCallback output_;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<uint32_t> frames_{0};
+    std::atomic<uint64_t> sent_{0};
+    JitterMeter jitter_;
+    std::atomic<MtcRate> rate_{MtcRate::Fps25};
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,224 @@
+#pragma once
+
+/**
+ * @file OutputMirror.hpp
+ * @brief Last-sent CC / program / pitch bend per channel, replayed on reconnect
+ *
+ * A device that reconnects (hot-plug, DAW restart) has lost whatever
+ * feedback we sent it. observe() records every outgoing Control Change,
+ * Program Change and Pitch Bend; after beginResync(), resync() replays the
+ * recorded entries that differ from the General MIDI power-on state (a
+ * freshly connected receiver is already there), paced by a token bucket so
+ * the burst does not overrun a DIN-speed link or the receiver's input
+ * buffer.
+ *
+ * Replay order per channel: bank select (CC 0, 32), program, the other
+ * CCs, pitch bend. Controllers that are not state are never recorded:
+ * data entry and parameter selection (6, 38, 96-101; their meaning depends
+ * on the sequence, which ParameterEncoder resends itself) and channel mode
+ * messages (120-127).
+ *
+ * Allocation-free; not thread-safe (LibreMidiTransport uses it under its
+ * output lock).
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+struct OutputMirrorConfig {
+    /// Sustained replay rate (DIN MIDI carries about 1000 3-byte messages/s),
+    /// 0 = replay everything at once
+    uint32_t messagesPerSecond = 1000;
+
+    /// Messages allowed back-to-back before pacing applies
+    uint16_t burst = 32;
+
+    /// Leave out entries at their power-on value: program 0, pitch bend
+    /// center, volume 100, balance and pan 64, expression 127, other CCs 0.
+    /// Turn off for receivers that do not reset to these on reconnect.
+    bool skipDefaults = true;
+};
+
+class OutputMirror {
+public:
+    explicit OutputMirror(const OutputMirrorConfig& config = {}) : config_(config) { clear(); }
+
+    /// Record one outgoing message (non-state messages are ignored)
+    void observe(const uint8_t* data, size_t length) {
+        if (length < 2) return;
+        const uint8_t status = data[0];
+        Channel& ch = channels_[status & 0x0F];
+
+        switch (status & 0xF0) {
+            case 0xB0: {
+                if (length < 3) return;
+                const uint8_t controller = data[1] & 0x7F;
+                if (!isStateController(controller)) return;
+                ch.cc[controller] = data[2] & 0x7F;
+                ch.ccSet[controller >> 6] |= uint64_t{1} << (controller & 63);
+                break;
+            }
+            case 0xC0:
+                ch.program = data[1] & 0x7F;
+                ch.programSet = true;
+                break;
+            case 0xE0:
+                if (length < 3) return;
+                ch.bendLsb = data[1] & 0x7F;
+                ch.bendMsb = data[2] & 0x7F;
+                ch.bendSet = true;
+                break;
+            default:
+                return;
+        }
+        usedChannels_ |= static_cast<uint16_t>(1u << (status & 0x0F));
+    }
+
+    /// Forget everything recorded (and any resync in progress)
+    void clear() {
+        for (auto& ch : channels_) ch = Channel{};
+        usedChannels_ = 0;
+        cursor_ = END;
+    }
+
+    /// Replay everything recorded, starting now with a full burst
+    void beginResync(uint64_t nowUs) {
+        cursor_ = 0;
+        tokens_ = config_.burst;
+        lastRefillUs_ = nowUs;
+    }
+
+    bool resyncPending() const { return cursor_ != END; }
+
+    /**
+     * @brief Replay as many entries as the rate allows
+     * @param emit Called with each message (const uint8_t*, size_t)
+     * @param maxMessages Stop after this many, e.g. 1 to release a lock between them
+     * @return Messages emitted
+     */
+    template <typename Emit>
+    size_t resync(uint64_t nowUs, Emit&& emit, size_t maxMessages = SIZE_MAX) {
+        if (cursor_ == END) return 0;
+        refill(nowUs);
+
+        size_t sent = 0;
+        while (cursor_ < END && tokens_ > 0 && sent < maxMessages) {
+            const uint8_t channel = static_cast<uint8_t>(cursor_ / SLOTS);
+            if (!(usedChannels_ & (1u << channel))) {
+                cursor_ = (channel + 1u) * SLOTS;
+                continue;
+            }
+            uint8_t message[3];
+            const size_t length = slotMessage(channel, cursor_ % SLOTS, message);
+            ++cursor_;
+            if (length == 0) continue;
+            emit(static_cast<const uint8_t*>(message), length);
+            --tokens_;
+            ++sent;
+        }
+        if (cursor_ >= END) cursor_ = END;
+        return sent;
+    }
+
+    /// Recorded entries a full resync sends (defaults left out)
+    size_t entries() const {
+        size_t count = 0;
+        uint8_t message[3];
+        for (uint8_t channel = 0; channel < 16; ++channel) {
+            if (!(usedChannels_ & (1u << channel))) continue;
+            for (uint32_t slot = 0; slot < SLOTS; ++slot) {
+                count += slotMessage(channel, slot, message) > 0;
+            }
+        }
+        return count;
+    }
+
+    static constexpr bool isStateController(uint8_t controller) {
+        return controller != 6 && controller != 38 && (controller < 96 || controller > 101) &&
+               controller < 120;
+    }
+
+private:
+    // Slots per channel: CC 0, CC 32, program, CC 0-127 (0 and 32 skipped), bend
+    static constexpr uint32_t SLOTS = 3 + 128 + 1;
+    static constexpr uint32_t END = 16 * SLOTS;
+
+    struct Channel {
+        uint64_t ccSet[2] = {0, 0};
+        uint8_t cc[128] = {};
+        uint8_t program = 0;
+        uint8_t bendLsb = 0;
+        uint8_t bendMsb = 0;
+        bool programSet = false;
+        bool bendSet = false;
+    };
+
+    static bool hasCC(const Channel& ch, uint8_t controller) {
+        return (ch.ccSet[controller >> 6] >> (controller & 63)) & 1u;
+    }
+
+    static constexpr uint8_t powerOnValue(uint8_t controller) {
+        switch (controller) {
+            case 7: return 100;
+            case 8: case 10: return 64;
+            case 11: return 127;
+            default: return 0;
+        }
+    }
+
+    size_t slotMessage(uint8_t channel, uint32_t slot, uint8_t* out) const {
+        const Channel& ch = channels_[channel];
+        const auto cc = [&](uint8_t controller) -> size_t {
+            if (!hasCC(ch, controller)) return 0;
+            if (config_.skipDefaults && ch.cc[controller] == powerOnValue(controller)) return 0;
+            out[0] = static_cast<uint8_t>(0xB0 | channel);
+            out[1] = controller;
+            out[2] = ch.cc[controller];
+            return 3;
+        };
+
+        if (slot == 0) return cc(0);
+        if (slot == 1) return cc(32);
+        if (slot == 2) {
+            if (!ch.programSet || (config_.skipDefaults && ch.program == 0)) return 0;
+            out[0] = static_cast<uint8_t>(0xC0 | channel);
+            out[1] = ch.program;
+            return 2;
+        }
+        if (slot < 3 + 128) {
+            const uint8_t controller = static_cast<uint8_t>(slot - 3);
+            return controller == 0 || controller == 32 ? 0 : cc(controller);
+        }
+        if (!ch.bendSet) return 0;
+        if (config_.skipDefaults && ch.bendMsb == 0x40 && ch.bendLsb == 0) return 0;
+        out[0] = static_cast<uint8_t>(0xE0 | channel);
+        out[1] = ch.bendLsb;
+        out[2] = ch.bendMsb;
+        return 3;
+    }
+
+    void refill(uint64_t nowUs) {
+        if (config_.messagesPerSecond == 0) {
+            tokens_ = UINT32_MAX;
+            return;
+        }
+        if (nowUs <= lastRefillUs_) return;
+        const uint64_t earned = (nowUs - lastRefillUs_) * config_.messagesPerSecond / 1000000;
+        if (earned == 0) return;
+        // Advance by the time actually converted to tokens, keeping the remainder.
+        lastRefillUs_ += earned * 1000000 / config_.messagesPerSecond;
+        const uint64_t tokens = tokens_ + earned;
+        tokens_ = tokens > config_.burst ? config_.burst : static_cast<uint32_t>(tokens);
+    }
+
+    OutputMirrorConfig config_;
+    Channel channels_[16];
+    uint16_t usedChannels_ = 0;
+    uint32_t cursor_ = END;
+    uint32_t tokens_ = 0;
+    uint64_t lastRefillUs_ = 0;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,259 @@
+#pragma once
+
+/**
+ * @file ParameterAssembler.hpp
+ * @brief 14-bit CC pairs and NRPN / RPN sequences assembled into single events
+ *
+ * High-resolution controllers spread one change over several CCs:
+ * - 14-bit CC: MSB on CC n (0-31), LSB on CC n + 32
+ * - NRPN: CC 99 / 98 select the parameter, CC 6 / 38 carry the value
+ * - RPN:  CC 101 / 100 select the parameter, CC 6 / 38 carry the value
+ * - CC 96 / 97 step the selected parameter by one
+ *
+ * ParameterAssembler keeps per-channel state and turns each sequence into one
+ * ParameterEvent, so consumers see one callback per logical change instead of
+ * two to four CCs. A value is emitted when its LSB arrives. An MSB whose LSB
+ * never comes (7-bit senders) is emitted alone once timeoutUs has elapsed,
+ * either lazily on the next message or from poll(). A selection that stays
+ * incomplete for timeoutUs is forgotten, as is one set to the null
+ * parameter (127 / 127).
+ *
+ * No allocation; state is 16 fixed-size channel records. Not thread-safe.
+ *
+ * Usage:
+ *   ParameterAssembler assembler(config);
+ *   if (!assembler.process(event, nowUs, [](const ParameterEvent& p) { ... })) {
+ *       // Not part of a sequence: handle as a plain CC
+ *   }
+ *   assembler.poll(nowUs, emit);   // Periodically, for timed-out MSBs
+ */
+
+#include <cstdint>
+
+#include "MidiEvent.hpp"
+
+namespace oc::hal::midi {
+
+struct ParameterEvent {
+    enum class Kind : uint8_t {
+        CC14,  ///< number = MSB controller (0-31)
+        NRPN,
+        RPN
+    };
+
+    Kind kind = Kind::CC14;
+    uint8_t channel = 0;
+    uint16_t number = 0;  ///< 14-bit parameter number, or controller
+    uint16_t value = 0;   ///< 14-bit value (MSB << 7 | LSB)
+    bool fine = true;     ///< false if the LSB never arrived (value = MSB << 7)
+};
+
+struct ParameterAssemblerConfig {
+    /// Assemble NRPN (CC 99 / 98) and RPN (CC 101 / 100) sequences
+    bool nrpn = true;
+    bool rpn = true;
+
+    /// Bit n pairs CC n (MSB) with CC n + 32 (LSB) as one 14-bit controller
+    uint32_t cc14Controllers = 0;
+
+    /// Age after which a lone MSB is emitted or a partial selection dropped
+    uint32_t timeoutUs = 50000;
+};
+
+class ParameterAssembler {
+public:
+    static constexpr uint8_t CC_NRPN_MSB = 99;
+    static constexpr uint8_t CC_NRPN_LSB = 98;
+    static constexpr uint8_t CC_RPN_MSB = 101;
+    static constexpr uint8_t CC_RPN_LSB = 100;
+    static constexpr uint8_t CC_DATA_MSB = 6;
+    static constexpr uint8_t CC_DATA_LSB = 38;
+    static constexpr uint8_t CC_DATA_INCREMENT = 96;
+    static constexpr uint8_t CC_DATA_DECREMENT = 97;
+
+    ParameterAssembler() : ParameterAssembler(ParameterAssemblerConfig{}) {}
+    explicit ParameterAssembler(const ParameterAssemblerConfig& config) : config_(config) {}
+
+    /**
+     * @brief Feed one decoded message
+     * @param emit Called with each completed ParameterEvent
+     * @return true if the message was consumed (part of a sequence)
+     */
+    template <typename Emit>
+    bool process(const MidiEvent& event, uint64_t nowUs, Emit&& emit) {
+        if (event.type != MidiEventType::ControlChange) return false;
+
+        Channel& ch = channels_[event.channel];
+        expire(ch, event.channel, nowUs, emit);
+
+        const uint8_t cc = event.data1;
+        const uint8_t value = event.data2 & 0x7F;
+
+        if (cc < 32 && isCC14(cc)) {
+            flushCC14(ch, event.channel, emit);
+            ch.ccMsb[cc] = value;
+            ch.ccPending = cc;
+            ch.ccUs = nowUs;
+            return true;
+        }
+        if (cc >= 32 && cc < 64 && isCC14(cc - 32)) {
+            const uint8_t msb = cc - 32;
+            if (ch.ccPending != NO_CC && ch.ccPending != msb) flushCC14(ch, event.channel, emit);
+            ch.ccPending = NO_CC;
+            emitParameter(emit, ParameterEvent::Kind::CC14, event.channel, msb,
+                          static_cast<uint16_t>((ch.ccMsb[msb] << 7) | value), true);
+            return true;
+        }
+
+        const bool nrpn = config_.nrpn && (cc == CC_NRPN_MSB || cc == CC_NRPN_LSB);
+        const bool rpn = config_.rpn && (cc == CC_RPN_MSB || cc == CC_RPN_LSB);
+        if (nrpn || rpn) {
+            flushData(ch, event.channel, emit);
+            const ParameterEvent::Kind kind = nrpn ? ParameterEvent::Kind::NRPN
+                                                   : ParameterEvent::Kind::RPN;
+            if (ch.selectKind != kind) {
+                ch.selectKind = kind;
+                ch.selectMsb = NONE_7BIT;
+                ch.selectLsb = NONE_7BIT;
+            }
+            if (cc == CC_NRPN_MSB || cc == CC_RPN_MSB) {
+                ch.selectMsb = value;
+            } else {
+                ch.selectLsb = value;
+            }
+            ch.value = 0;
+            ch.selectUs = nowUs;
+            return true;
+        }
+
+        if (!selected(ch)) return false;
+
+        switch (cc) {
+            case CC_DATA_MSB:
+                flushData(ch, event.channel, emit);
+                ch.dataMsb = value;
+                ch.dataPending = true;
+                ch.dataUs = nowUs;
+                return true;
+            case CC_DATA_LSB: {
+                const uint8_t msb = ch.dataPending ? ch.dataMsb
+                                                   : static_cast<uint8_t>(ch.value >> 7);
+                ch.dataPending = false;
+                emitData(ch, event.channel, static_cast<uint16_t>((msb << 7) | value), true, emit);
+                return true;
+            }
+            case CC_DATA_INCREMENT:
+            case CC_DATA_DECREMENT: {
+                flushData(ch, event.channel, emit);
+                uint16_t next = ch.value;
+                if (cc == CC_DATA_INCREMENT && next < 0x3FFF) ++next;
+                if (cc == CC_DATA_DECREMENT && next > 0) --next;
+                emitData(ch, event.channel, next, true, emit);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    /// Emit MSBs and drop selections older than timeoutUs
+    template <typename Emit>
+    void poll(uint64_t nowUs, Emit&& emit) {
+        for (uint8_t c = 0; c < 16; ++c) expire(channels_[c], c, nowUs, emit);
+    }
+
+    /// Forget all selections and pending values
+    void reset() {
+        for (auto& ch : channels_) ch = Channel{};
+    }
+
+private:
+    static constexpr uint8_t NONE_7BIT = 0xFF;
+    static constexpr uint8_t NO_CC = 0xFF;
+
+    struct Channel {
+        // 14-bit CC
+        uint8_t ccMsb[32] = {};
+        uint8_t ccPending = NO_CC;
+        uint64_t ccUs = 0;
+
+        // NRPN / RPN
+        ParameterEvent::Kind selectKind = ParameterEvent::Kind::NRPN;
+        uint8_t selectMsb = NONE_7BIT;
+        uint8_t selectLsb = NONE_7BIT;
+        uint64_t selectUs = 0;
+        uint8_t dataMsb = 0;
+        bool dataPending = false;
+        uint64_t dataUs = 0;
+        uint16_t value = 0;  ///< Last value of the selected parameter
+    };
+
+    bool isCC14(uint8_t cc) const { return (config_.cc14Controllers >> cc) & 1u; }
+
+    static bool selected(const Channel& ch) {
+        if (ch.selectMsb == NONE_7BIT || ch.selectLsb == NONE_7BIT) return false;
+        return !(ch.selectMsb == 0x7F && ch.selectLsb == 0x7F);  // Null parameter
+    }
+
+    template <typename Emit>
+    static void emitParameter(Emit& emit, ParameterEvent::Kind kind, uint8_t channel,
+                              uint16_t number, uint16_t value, bool fine) {
+        ParameterEvent out;
+        out.kind = kind;
+        out.channel = channel;
+        out.number = number;
+        out.value = value;
+        out.fine = fine;
+        emit(static_cast<const ParameterEvent&>(out));
+    }
+
+    template <typename Emit>
+    static void emitData(Channel& ch, uint8_t channel, uint16_t value, bool fine, Emit& emit) {
+        ch.value = value;
+        emitParameter(emit, ch.selectKind, channel,
+                      static_cast<uint16_t>((ch.selectMsb << 7) | ch.selectLsb), value, fine);
+    }
+
+    template <typename Emit>
+    static void flushCC14(Channel& ch, uint8_t channel, Emit& emit) {
+        if (ch.ccPending == NO_CC) return;
+        const uint8_t cc = ch.ccPending;
+        ch.ccPending = NO_CC;
+        emitParameter(emit, ParameterEvent::Kind::CC14, channel, cc,
+                      static_cast<uint16_t>(ch.ccMsb[cc] << 7), false);
+    }
+
+    template <typename Emit>
+    static void flushData(Channel& ch, uint8_t channel, Emit& emit) {
+        if (!ch.dataPending) return;
+        ch.dataPending = false;
+        emitData(ch, channel, static_cast<uint16_t>(ch.dataMsb << 7), false, emit);
+    }
+
+    // Saturating: a timestamp newer than nowUs (another thread's clock
+    // read) counts as no time elapsed, not as a wrapped-around age.
+    static uint64_t elapsedUs(uint64_t nowUs, uint64_t sinceUs) {
+        return nowUs > sinceUs ? nowUs - sinceUs : 0;
+    }
+
+    template <typename Emit>
+    void expire(Channel& ch, uint8_t channel, uint64_t nowUs, Emit& emit) {
+        const uint64_t timeout = config_.timeoutUs;
+        if (ch.ccPending != NO_CC && elapsedUs(nowUs, ch.ccUs) >= timeout) {
+            flushCC14(ch, channel, emit);
+        }
+        if (ch.dataPending && elapsedUs(nowUs, ch.dataUs) >= timeout) flushData(ch, channel, emit);
+
+        // Half-selected parameter that never completed
+        const bool partial = (ch.selectMsb == NONE_7BIT) != (ch.selectLsb == NONE_7BIT);
+        if (partial && elapsedUs(nowUs, ch.selectUs) >= timeout) {
+            ch.selectMsb = NONE_7BIT;
+            ch.selectLsb = NONE_7BIT;
+        }
+    }
+
+    ParameterAssemblerConfig config_;
+    Channel channels_[16];
+};
+
+}  // namespace oc::hal::midi
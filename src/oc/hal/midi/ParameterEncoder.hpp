@@ -0,0 +1,147 @@
+#pragma once
+
+/**
+ * @file ParameterEncoder.hpp
+ * @brief NRPN / RPN / 14-bit CC output with parameter-number and MSB caching
+ *
+ * A full NRPN write is four CCs (99, 98, 6, 38). When automation streams
+ * values to one parameter most of them are redundant. ParameterEncoder
+ * remembers, per channel, what the receiver has already been told and only
+ * writes what changed:
+ * - Parameter selection (99/98 or 101/100): only when kind or number changes
+ * - Data MSB (6) or 14-bit CC MSB (n): only when it differs from the last
+ *   one sent for that parameter / controller
+ * - LSB (38 or n + 32): always, as it completes the value
+ *
+ * Steady streaming to one parameter therefore costs one CC per value instead
+ * of four, or two when the MSB moves. CC 6 is both the Data Entry MSB and
+ * the MSB of 14-bit controller 6, so writing it through either path updates
+ * both cache entries. Receivers apply an LSB to the last MSB
+ * (MIDI 1.0 convention), which ParameterAssembler also follows.
+ *
+ * The encoder writes complete 3-byte CC messages into a caller buffer of
+ * MAX_BYTES. One instance per output; call invalidate() when the receiver
+ * may have lost its state (reconnect) and observeCC() for CCs sent around
+ * the encoder. Not thread-safe.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+class ParameterEncoder {
+public:
+    /// Largest output of one encode call (four CC messages)
+    static constexpr size_t MAX_BYTES = 12;
+
+    ParameterEncoder() { invalidate(); }
+
+    /// @return Bytes written (multiple of 3)
+    size_t encodeNRPN(uint8_t channel, uint16_t number, uint16_t value, uint8_t* out) {
+        return encodeParameter(Select::NRPN, channel, number, value, out);
+    }
+
+    size_t encodeRPN(uint8_t channel, uint16_t number, uint16_t value, uint8_t* out) {
+        return encodeParameter(Select::RPN, channel, number, value, out);
+    }
+
+    /// @param controller MSB controller 0-31 (LSB goes to controller + 32)
+    size_t encodeCC14(uint8_t channel, uint8_t controller, uint16_t value, uint8_t* out) {
+        channel &= 0x0F;
+        controller &= 0x1F;
+        const uint8_t msb = static_cast<uint8_t>((value >> 7) & 0x7F);
+        Channel& ch = channels_[channel];
+
+        uint8_t* o = out;
+        if (ch.ccMsb[controller] != msb) {
+            o = writeCC(o, channel, controller, msb);
+            ch.ccMsb[controller] = msb;
+            if (controller == 6) ch.dataMsb = msb;
+        }
+        o = writeCC(o, channel, static_cast<uint8_t>(controller + 32), value & 0x7F);
+        return static_cast<size_t>(o - out);
+    }
+
+    /**
+     * @brief Keep the cache right when a CC is sent without the encoder
+     *
+     * Anything that changes what the receiver has selected or latched as
+     * MSB updates or drops the matching cache entry.
+     */
+    void observeCC(uint8_t channel, uint8_t controller, uint8_t value) {
+        Channel& ch = channels_[channel & 0x0F];
+        if (controller < 32) ch.ccMsb[controller] = value & 0x7F;
+        switch (controller) {
+            case 99: case 98: case 101: case 100:
+                ch.select = Select::Unknown;
+                break;
+            case 6:
+                ch.dataMsb = value & 0x7F;
+                break;
+            case 96: case 97:
+                ch.dataMsb = UNKNOWN;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /// Forget everything: the next write of each parameter is sent in full
+    void invalidate() {
+        for (auto& ch : channels_) {
+            ch.select = Select::Unknown;
+            ch.number = 0;
+            ch.dataMsb = UNKNOWN;
+            for (auto& msb : ch.ccMsb) msb = UNKNOWN;
+        }
+    }
+
+private:
+    enum class Select : uint8_t { Unknown, NRPN, RPN };
+
+    static constexpr uint8_t UNKNOWN = 0xFF;
+
+    struct Channel {
+        Select select;
+        uint16_t number;
+        uint8_t dataMsb;
+        uint8_t ccMsb[32];
+    };
+
+    static uint8_t* writeCC(uint8_t* o, uint8_t channel, uint8_t controller, uint8_t value) {
+        o[0] = static_cast<uint8_t>(0xB0 | channel);
+        o[1] = controller;
+        o[2] = value;
+        return o + 3;
+    }
+
+    size_t encodeParameter(Select kind, uint8_t channel, uint16_t number, uint16_t value,
+                           uint8_t* out) {
+        channel &= 0x0F;
+        number &= 0x3FFF;
+        const uint8_t msb = static_cast<uint8_t>((value >> 7) & 0x7F);
+        Channel& ch = channels_[channel];
+
+        uint8_t* o = out;
+        if (ch.select != kind || ch.number != number) {
+            const bool nrpn = kind == Select::NRPN;
+            o = writeCC(o, channel, nrpn ? 99 : 101, static_cast<uint8_t>(number >> 7));
+            o = writeCC(o, channel, nrpn ? 98 : 100, number & 0x7F);
+            ch.select = kind;
+            ch.number = number;
+            ch.dataMsb = UNKNOWN;
+        }
+        if (ch.dataMsb != msb) {
+            o = writeCC(o, channel, 6, msb);
+            ch.dataMsb = msb;
+            ch.ccMsb[6] = msb;
+        }
+        o = writeCC(o, channel, 38, value & 0x7F);
+        return static_cast<size_t>(o - out);
+    }
+
+    Channel channels_[16];
+};
+
+}  // namespace oc::hal::midi
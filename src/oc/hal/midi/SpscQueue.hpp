@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file SpscQueue.hpp
+ * @brief Bounded lock-free single-producer / single-consumer ring
+ *
+ * Fixed array of T, allocated once; capacity is rounded up to a power of
+ * two. push() runs on one thread (e.g. the backend receive callback) and
+ * pop() on another (update()), without locks or allocation. Head and tail
+ * indices sit on separate cache lines.
+ *
+ * Usage:
+ *   SpscQueue<UmpPacket> queue(1024);
+ *   queue.push(packet);          // producer
+ *   while (queue.pop(packet)) {} // consumer
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace oc::hal::midi {
+
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /// Producer only. @return false when full (item dropped)
+    bool push(const T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_) return false;
+        slots_[tail & mask_] = item;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer only. @return false when empty
+    bool pop(T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        item = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Approximate when called concurrently with push() / pop()
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace oc::hal::midi
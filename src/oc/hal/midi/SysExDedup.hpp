@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file SysExDedup.hpp
+ * @brief Suppression of repeated outbound SysEx (display / LED feedback)
+ *
+ * Feedback layers often resend the same frame (text line, LED map) on every
+ * refresh. SysExDedup remembers, per key, a hash of the last SysEx actually
+ * sent and tells the caller to skip an identical one:
+ * - Key: the first keyLength bytes after F0 (e.g. manufacturer + command),
+ *   so each display line or LED bank is tracked separately
+ * - Content: FNV-1a hash of the whole message plus its length
+ * - A frame identical to the last one is still sent once refreshIntervalUs
+ *   has elapsed, so a device that missed or lost it recovers
+ *
+ * Keys live in a flat table of maxKeys entries allocated in the constructor;
+ * when full, the least recently sent key is evicted. One instance per
+ * destination, not thread-safe.
+ *
+ * Usage:
+ *   SysExDedup dedup(config);
+ *   if (dedup.shouldSend(data, length, steadyNowUs())) output(data, length);
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace oc::hal::midi {
+
+struct SysExDedupConfig {
+    static constexpr size_t MAX_KEY_LENGTH = 16;
+
+    /// Bytes after F0 identifying what a frame updates (clamped to MAX_KEY_LENGTH)
+    size_t keyLength = 4;
+
+    /// Resend identical content after this long (0 = suppress until it changes)
+    uint32_t refreshIntervalUs = 1000000;
+
+    /// Distinct keys remembered
+    size_t maxKeys = 64;
+};
+
+class SysExDedup {
+public:
+    struct Stats {
+        uint32_t sent = 0;        ///< Frames passed (new, changed or refreshed)
+        uint32_t suppressed = 0;  ///< Identical frames skipped
+        uint32_t refreshed = 0;   ///< Identical frames passed by the refresh interval
+        uint32_t evicted = 0;     ///< Keys dropped because the table was full
+    };
+
+    SysExDedup() : SysExDedup(SysExDedupConfig{}) {}
+
+    explicit SysExDedup(const SysExDedupConfig& config) : config_(config) {
+        if (config_.keyLength > SysExDedupConfig::MAX_KEY_LENGTH) {
+            config_.keyLength = SysExDedupConfig::MAX_KEY_LENGTH;
+        }
+        if (config_.maxKeys == 0) config_.maxKeys = 1;
+        entries_.resize(config_.maxKeys);
+    }
+
+    /**
+     * @brief Decide whether @p data must go out, and remember it if so
+     * @param data Complete SysEx (F0 ... F7)
+     * @return false if identical to the last frame sent for its key
+     */
+    bool shouldSend(const uint8_t* data, size_t length, uint64_t nowUs) {
+        const uint8_t* key = length > 1 ? data + 1 : data;
+        size_t keyLength = length > 1 ? length - 1 : 0;
+        if (keyLength > config_.keyLength) keyLength = config_.keyLength;
+        const uint64_t hash = fnv1a(data, length);
+
+        Entry* slot = nullptr;
+        Entry* oldest = &entries_[0];
+        for (auto& entry : entries_) {
+            if (!entry.used) {
+                if (!slot) slot = &entry;
+                continue;
+            }
+            if (entry.keyLength == keyLength &&
+                std::memcmp(entry.key, key, keyLength) == 0) {
+                return update(entry, hash, length, nowUs);
+            }
+            if (entry.lastSentUs < oldest->lastSentUs) oldest = &entry;
+        }
+
+        if (!slot) {
+            slot = oldest;
+            ++stats_.evicted;
+        }
+        slot->used = true;
+        slot->keyLength = static_cast<uint8_t>(keyLength);
+        std::memcpy(slot->key, key, keyLength);
+        slot->hash = hash;
+        slot->length = length;
+        slot->lastSentUs = nowUs;
+        ++stats_.sent;
+        return true;
+    }
+
+    /// Forget all frames (e.g. after the device reconnects), so everything resends
+    void invalidate() {
+        for (auto& entry : entries_) entry.used = false;
+    }
+
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = {}; }
+
+private:
+    struct Entry {
+        uint64_t hash = 0;
+        uint64_t lastSentUs = 0;
+        size_t length = 0;
+        uint8_t key[SysExDedupConfig::MAX_KEY_LENGTH] = {};
+        uint8_t keyLength = 0;
+        bool used = false;
+    };
+
+    static uint64_t fnv1a(const uint8_t* data, size_t length) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ data[i]) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    bool update(Entry& entry, uint64_t hash, size_t length, uint64_t nowUs) {
+        if (entry.hash == hash && entry.length == length) {
+            if (config_.refreshIntervalUs == 0 ||
+                nowUs - entry.lastSentUs < config_.refreshIntervalUs) {
+                ++stats_.suppressed;
+                return false;
+            }
+            ++stats_.refreshed;
+        }
+        entry.hash = hash;
+        entry.length = length;
+        entry.lastSentUs = nowUs;
+        ++stats_.sent;
+        return true;
+    }
+
+    SysExDedupConfig config_;
+    std::vector<Entry> entries_;
+    Stats stats_;
+};
+
+}  // namespace oc::hal::midi
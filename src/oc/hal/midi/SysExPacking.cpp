@@ -0,0 +1,186 @@
+#include "SysExPacking.hpp"
+
+#include <cstring>
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#define OC_SYSEX_PACK_SSSE3 1
+#endif
+
+#if defined(_WIN32) || \
+    (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define OC_SYSEX_PACK_SWAR 1
+#endif
+
+namespace oc::hal::midi {
+
+namespace {
+
+// Header byte of a (possibly partial) group of raw bytes
+uint8_t packHeaderScalar(const uint8_t* in, size_t count) {
+    uint8_t header = 0;
+    for (size_t i = 0; i < count; ++i) {
+        header |= static_cast<uint8_t>((in[i] >> 7) << i);
+    }
+    return header;
+}
+
+#if defined(OC_SYSEX_PACK_SWAR)
+
+constexpr uint64_t LOW7_MASK = 0x007F7F7F7F7F7F7FULL;
+
+// One full group: 7 raw bytes -> 8 packed bytes. Reads 8 bytes of input.
+inline void packGroupSwar(const uint8_t* in, uint8_t* out) {
+    uint64_t x = 0;
+    std::memcpy(&x, in, 8);
+    x &= 0x00FFFFFFFFFFFFFFULL;
+    // Move bit 7 of byte n to bit 56 + n, then read the top byte.
+    const uint64_t high = (x >> 7) & 0x0001010101010101ULL;
+    const uint64_t header = ((high * 0x0102040810204000ULL) >> 56) & 0x7F;
+    const uint64_t packed = ((x & LOW7_MASK) << 8) | header;
+    std::memcpy(out, &packed, 8);
+}
+
+// One full group: 8 packed bytes -> 7 raw bytes. Writes 8 bytes of output.
+inline void unpackGroupSwar(const uint8_t* in, uint8_t* out) {
+    uint64_t x = 0;
+    std::memcpy(&x, in, 8);
+    // Spread header bit n to bit 8n + 7 (all products land on distinct bits).
+    const uint64_t high = ((x & 0x7F) * 0x0002040810204080ULL) & 0x0080808080808080ULL;
+    const uint64_t raw = ((x >> 8) & LOW7_MASK) | high;
+    std::memcpy(out, &raw, 8);
+}
+
+#endif
+
+}  // namespace
+
+// =============================================================================
+// Scalar reference
+// =============================================================================
+
+size_t packSysEx7Scalar(const uint8_t* in, size_t length, uint8_t* out) {
+    uint8_t* o = out;
+    for (size_t i = 0; i < length; i += 7) {
+        const size_t count = length - i < 7 ? length - i : 7;
+        *o++ = packHeaderScalar(in + i, count);
+        for (size_t j = 0; j < count; ++j) {
+            *o++ = in[i + j] & 0x7F;
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+size_t unpackSysEx7Scalar(const uint8_t* in, size_t length, uint8_t* out) {
+    uint8_t* o = out;
+    for (size_t i = 0; i < length; i += 8) {
+        const size_t count = length - i < 8 ? length - i : 8;
+        const uint8_t header = in[i];
+        for (size_t j = 1; j < count; ++j) {
+            *o++ = static_cast<uint8_t>((in[i + j] & 0x7F) | (((header >> (j - 1)) & 1) << 7));
+        }
+    }
+    return static_cast<size_t>(o - out);
+}
+
+// =============================================================================
+// Vectorised
+// =============================================================================
+
+size_t packSysEx7(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t i = 0;
+    uint8_t* o = out;
+
+#if defined(OC_SYSEX_PACK_SSSE3)
+    // Two groups per step: 14 raw bytes -> 16 packed bytes (16-byte load).
+    const __m128i spread = _mm_setr_epi8(
+        -128, 0, 1, 2, 3, 4, 5, 6, -128, 7, 8, 9, 10, 11, 12, 13);
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    while (length - i >= 16) {
+        const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i shuffled = _mm_shuffle_epi8(raw, spread);
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(shuffled));
+        const __m128i headers = _mm_set_epi64x(static_cast<int64_t>((mask >> 9) & 0x7F),
+                                               static_cast<int64_t>((mask >> 1) & 0x7F));
+        const __m128i packed = _mm_or_si128(_mm_and_si128(shuffled, low7), headers);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o), packed);
+        i += 14;
+        o += 16;
+    }
+#endif
+
+#if defined(OC_SYSEX_PACK_SWAR)
+    while (length - i >= 8) {
+        packGroupSwar(in + i, o);
+        i += 7;
+        o += 8;
+    }
+#endif
+
+    return static_cast<size_t>(o - out) + packSysEx7Scalar(in + i, length - i, o);
+}
+
+size_t unpackSysEx7(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t i = 0;
+    uint8_t* o = out;
+
+    // Vector stores spill past the group, so stop while too few output bytes remain.
+    const uint8_t* outEnd = out + sysEx7UnpackedSize(length);
+    (void)outEnd;
+
+#if defined(OC_SYSEX_PACK_SSSE3)
+    // Two groups per step: 16 packed bytes -> 14 raw bytes (16-byte store).
+    const __m128i bodies = _mm_setr_epi8(
+        1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 13, 14, 15, -128, -128);
+    const __m128i headerIndex = _mm_setr_epi8(
+        0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, -128, -128);
+    const __m128i bitSelect = _mm_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, 1, 2, 4, 8, 16, 32, 64, 0, 0);
+    const __m128i highBit = _mm_setr_epi8(
+        -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, 0);
+    const __m128i low7 = _mm_set1_epi8(0x7F);
+    while (length - i >= 16 && outEnd - o >= 16) {
+        const __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i body = _mm_and_si128(_mm_shuffle_epi8(packed, bodies), low7);
+        const __m128i header = _mm_shuffle_epi8(packed, headerIndex);
+        const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(header, bitSelect), bitSelect);
+        const __m128i raw = _mm_or_si128(body, _mm_and_si128(set, highBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(o), raw);
+        i += 16;
+        o += 14;
+    }
+#endif
+
+#if defined(OC_SYSEX_PACK_SWAR)
+    while (length - i >= 8 && outEnd - o >= 8) {
+        unpackGroupSwar(in + i, o);
+        i += 8;
+        o += 7;
+    }
+#endif
+
+    return static_cast<size_t>(o - out) + unpackSysEx7Scalar(in + i, length - i, o);
+}
+
+// =============================================================================
+// Message builder
+// =============================================================================
+
+size_t buildPackedSysEx(const uint8_t* prefix, size_t prefixLength,
+                        const uint8_t* payload, size_t payloadLength,
+                        uint8_t* out, size_t capacity) {
+    const size_t total = packedSysExMessageSize(prefixLength, payloadLength);
+    if (!out || capacity < total) return 0;
+
+    uint8_t* o = out;
+    *o++ = 0xF0;
+    if (prefixLength) {
+        std::memcpy(o, prefix, prefixLength);
+        o += prefixLength;
+    }
+    o += packSysEx7(payload, payloadLength, o);
+    *o++ = 0xF7;
+    return static_cast<size_t>(o - out);
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * @file SysExPacking.hpp
+ * @brief 7-in-8 packing of binary data for SysEx payloads
+ *
+ * Every group of up to 7 data bytes is sent as one header byte holding the
+ * stripped high bits, followed by the 7-bit bodies:
+ *
+ *   [h] [d0 & 7F] [d1 & 7F] ... [d6 & 7F]     bit n of h = bit 7 of dn
+ *
+ * A trailing partial group of k bytes is packed to k + 1 bytes.
+ *
+ * packSysEx7 / unpackSysEx7 use SSSE3 shuffles (two groups per step) when
+ * compiled with SSSE3 or AVX2, and 64-bit SWAR (one group per step)
+ * elsewhere. The *Scalar variants are the byte-by-byte reference.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace oc::hal::midi {
+
+/// Packed length of @p length raw bytes
+constexpr size_t sysEx7PackedSize(size_t length) {
+    return length + (length + 6) / 7;
+}
+
+/// Raw length encoded by @p packedLength packed bytes
+constexpr size_t sysEx7UnpackedSize(size_t packedLength) {
+    return (packedLength / 8) * 7 + (packedLength % 8 ? packedLength % 8 - 1 : 0);
+}
+
+/**
+ * @brief Pack raw bytes into 7-bit SysEx data
+ * @param out Must hold sysEx7PackedSize(length) bytes
+ * @return Bytes written
+ */
+size_t packSysEx7(const uint8_t* in, size_t length, uint8_t* out);
+
+/**
+ * @brief Unpack 7-bit SysEx data into raw bytes
+ * @param out Must hold sysEx7UnpackedSize(length) bytes
+ * @return Bytes written
+ */
+size_t unpackSysEx7(const uint8_t* in, size_t length, uint8_t* out);
+
+size_t packSysEx7Scalar(const uint8_t* in, size_t length, uint8_t* out);
+size_t unpackSysEx7Scalar(const uint8_t* in, size_t length, uint8_t* out);
+
+/**
+ * @brief Build a complete SysEx message in place: F0 <prefix> <packed payload> F7
+ *
+ * The prefix (manufacturer ID, device, command...) is copied unchanged and
+ * must already be 7-bit. Writes straight into @p out, so no intermediate
+ * buffer is needed before sending.
+ *
+ * @return Message length, or 0 if @p capacity is too small
+ */
+size_t buildPackedSysEx(const uint8_t* prefix, size_t prefixLength,
+                        const uint8_t* payload, size_t payloadLength,
+                        uint8_t* out, size_t capacity);
+
+/// Size needed by buildPackedSysEx()
+constexpr size_t packedSysExMessageSize(size_t prefixLength, size_t payloadLength) {
+    return 2 + prefixLength + sysEx7PackedSize(payloadLength);
+}
+
+}  // namespace oc::hal::midi
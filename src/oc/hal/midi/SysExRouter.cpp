@@ -0,0 +1,123 @@
+#include "SysExRouter.hpp"
+
+namespace oc::hal::midi {
+
+namespace {
+
+constexpr size_t ROOT_ANY = 128;
+
+size_t rootIndex(uint8_t byte) { return byte == SysExRouter::ANY ? ROOT_ANY : byte; }
+
+}  // namespace
+
+SysExRouter::SysExRouter() { roots_.fill(NONE); }
+
+bool SysExRouter::add(const uint8_t* prefix, size_t length, Handler handler) {
+    if (!prefix || length == 0 || length > MAX_PREFIX_LENGTH || !handler) return false;
+    for (size_t i = 0; i < length; ++i) {
+        if (prefix[i] > 0x7F && prefix[i] != ANY) return false;
+    }
+
+    uint32_t& root = roots_[rootIndex(prefix[0])];
+    if (root == NONE) {
+        root = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back(Node{});
+        nodes_.back().byte = prefix[0];
+    }
+
+    uint32_t node = root;
+    for (size_t i = 1; i < length; ++i) {
+        node = insertChild(node, prefix[i]);
+    }
+
+    if (nodes_[node].handler == NONE) {
+        nodes_[node].handler = static_cast<uint32_t>(handlers_.size());
+        handlers_.push_back(std::move(handler));
+    } else {
+        handlers_[nodes_[node].handler] = std::move(handler);
+    }
+    return true;
+}
+
+void SysExRouter::clear() {
+    roots_.fill(NONE);
+    nodes_.clear();
+    handlers_.clear();
+}
+
+uint32_t SysExRouter::child(uint32_t node, uint8_t byte) const {
+    for (uint32_t c = nodes_[node].firstChild; c != NONE; c = nodes_[c].nextSibling) {
+        if (nodes_[c].byte == byte) return c;
+        if (nodes_[c].byte > byte) break;  // Sorted
+    }
+    return NONE;
+}
+
+uint32_t SysExRouter::insertChild(uint32_t node, uint8_t byte) {
+    uint32_t prev = NONE;
+    uint32_t c = nodes_[node].firstChild;
+    while (c != NONE && nodes_[c].byte < byte) {
+        prev = c;
+        c = nodes_[c].nextSibling;
+    }
+    if (c != NONE && nodes_[c].byte == byte) return c;
+
+    const uint32_t created = static_cast<uint32_t>(nodes_.size());
+    Node fresh{};
+    fresh.byte = byte;
+    fresh.nextSibling = c;
+    nodes_.push_back(fresh);
+    if (prev == NONE) {
+        nodes_[node].firstChild = created;
+    } else {
+        nodes_[prev].nextSibling = created;
+    }
+    return created;
+}
+
+// Deepest handler below @p node for the remaining bytes: both the exact
+// child and the ANY child (always the last sibling) are followed, and the
+// longer match wins; on a tie the exact route is kept.
+SysExRouter::Match SysExRouter::findFrom(uint32_t node, const uint8_t* data, size_t length,
+                                         uint32_t depth) const {
+    Match best{nodes_[node].handler, depth};
+    if (length == 0 || data[0] > 0x7F) return best;
+
+    const uint32_t next[2] = {child(node, data[0]), child(node, ANY)};
+    for (uint32_t c : next) {
+        if (c == NONE) continue;
+        const Match found = findFrom(c, data + 1, length - 1, depth + 1);
+        if (found.handler != NONE && (best.handler == NONE || found.depth > best.depth)) {
+            best = found;
+        }
+    }
+    return best;
+}
+
+uint32_t SysExRouter::find(const uint8_t* data, size_t length) const {
+    if (length < 2 || data[0] != 0xF0 || data[1] > 0x7F) return NONE;
+
+    Match best{NONE, 0};
+    const uint32_t roots[2] = {roots_[data[1]], roots_[ROOT_ANY]};
+    for (uint32_t root : roots) {
+        if (root == NONE) continue;
+        const Match found = findFrom(root, data + 2, length - 2, 1);
+        if (found.handler != NONE && (best.handler == NONE || found.depth > best.depth)) {
+            best = found;
+        }
+    }
+    return best.handler;
+}
+
+bool SysExRouter::matches(const uint8_t* data, size_t length) const {
+    return find(data, length) != NONE;
+}
+
+bool SysExRouter::dispatch(const uint8_t* data, size_t length) const {
+    const uint32_t handler = find(data, length);
+    if (handler == NONE) return false;
+    handlers_[handler](data, length);
+    return true;
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,93 @@
+#pragma once
+
+/**
+ * @file SysExRouter.hpp
+ * @brief Prefix-routed SysEx handlers (manufacturer / device / sub-IDs)
+ *
+ * Replaces a chain of memcmp()s in a single SysEx callback with a trie of
+ * the bytes following F0. Each registered prefix ends at a node holding its
+ * handler; dispatch() walks the message once and calls the handler of the
+ * longest matching prefix, in O(prefix length) (each ANY level adds one
+ * alternative branch).
+ *
+ * - Nodes are stored in one flat array (first child / next sibling indices,
+ *   siblings sorted by byte); the root level is a direct 128-entry table on
+ *   the first byte (manufacturer ID or 7E / 7F)
+ * - ANY matches any single byte, e.g. the device ID of universal SysEx:
+ *   {0x7E, ANY, 0x06, 0x02} routes identity replies from every device.
+ *   Between an exact and an ANY route of the same length, exact wins
+ * - matches() answers the same question without calling anything, so the
+ *   receive thread can drop SysEx nobody listens to before queuing it
+ *
+ * Routes are added up front; lookups never allocate and are safe to run
+ * concurrently with each other, but not with add() or clear().
+ *
+ * Usage:
+ *   SysExRouter router;
+ *   const uint8_t identity[] = {0x7E, SysExRouter::ANY, 0x06, 0x02};
+ *   router.add(identity, sizeof(identity), onIdentityReply);
+ *   router.dispatch(data, length);   // data starts with F0
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace oc::hal::midi {
+
+class SysExRouter {
+public:
+    using Handler = std::function<void(const uint8_t* data, size_t length)>;
+
+    /// Prefix byte matching any data byte (not a valid MIDI data value)
+    static constexpr uint8_t ANY = 0xFF;
+
+    /// Longest prefix accepted by add()
+    static constexpr size_t MAX_PREFIX_LENGTH = 16;
+
+    SysExRouter();
+
+    /**
+     * @brief Route SysEx starting with F0 <prefix...> to @p handler
+     * @param prefix Data bytes after F0 (or ANY); replaces an existing route
+     * @return false if the prefix is empty, too long or not 7-bit / ANY
+     */
+    bool add(const uint8_t* prefix, size_t length, Handler handler);
+
+    void clear();
+    bool empty() const { return handlers_.empty(); }
+
+    /// True if dispatch() would reach a handler for this message
+    bool matches(const uint8_t* data, size_t length) const;
+
+    /// Call the handler of the longest matching prefix; false if none
+    bool dispatch(const uint8_t* data, size_t length) const;
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+
+    struct Node {
+        uint32_t firstChild = NONE;
+        uint32_t nextSibling = NONE;
+        uint32_t handler = NONE;  ///< Index into handlers_
+        uint8_t byte = 0;
+    };
+
+    struct Match {
+        uint32_t handler;
+        uint32_t depth;
+    };
+
+    uint32_t child(uint32_t node, uint8_t byte) const;
+    uint32_t insertChild(uint32_t node, uint8_t byte);
+    uint32_t find(const uint8_t* data, size_t length) const;
+    Match findFrom(uint32_t node, const uint8_t* data, size_t length, uint32_t depth) const;
+
+    std::array<uint32_t, 129> roots_;  ///< First byte 00-7F, then ANY
+    std::vector<Node> nodes_;
+    std::vector<Handler> handlers_;
+};
+
+}  // namespace oc::hal::midi
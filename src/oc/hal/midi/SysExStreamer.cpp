@@ -0,0 +1,225 @@
+#include "SysExStreamer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "Timing.hpp"
+
+namespace oc::hal::midi {
+
+SysExStreamer::SysExStreamer() : SysExStreamer(SysExStreamerConfig{}) {}
+
+SysExStreamer::SysExStreamer(const SysExStreamerConfig& config) : config_(config) {
+    if (config_.chunkSize == 0) config_.chunkSize = 1;
+}
+
+SysExStreamer::~SysExStreamer() { cancel(); }
+
+void SysExStreamer::setOutput(OutputCallback cb) { output_ = std::move(cb); }
+void SysExStreamer::setOnProgress(ProgressCallback cb) { on_progress_ = std::move(cb); }
+
+bool SysExStreamer::start(const uint8_t* data, size_t length) {
+    if (!data || state() == State::Running) return false;
+    if (thread_.joinable()) thread_.join();
+
+    span_ = data;
+    span_length_ = length;
+    span_offset_ = 0;
+    reader_ = nullptr;
+    total_bytes_ = length;
+    return launch();
+}
+
+bool SysExStreamer::start(ReaderCallback reader, size_t totalBytes) {
+    if (!reader || state() == State::Running) return false;
+    if (thread_.joinable()) thread_.join();
+
+    span_ = nullptr;
+    span_length_ = 0;
+    span_offset_ = 0;
+    reader_ = std::move(reader);
+    total_bytes_ = totalBytes;
+
+    // Reader data is staged in one buffer, sized once per stream (and
+    // grown to the largest message when messages are kept whole).
+    chunk_.resize(config_.chunkSize);
+    buffered_ = 0;
+    reader_done_ = false;
+    return launch();
+}
+
+bool SysExStreamer::launch() {
+    if (!output_) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancel_requested_ = false;
+        acks_ = 0;
+    }
+    bytes_sent_.store(0, std::memory_order_relaxed);
+    state_.store(State::Running, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void SysExStreamer::acknowledge() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++acks_;
+    }
+    cv_.notify_all();
+}
+
+void SysExStreamer::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancel_requested_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
+
+void SysExStreamer::wait() {
+    if (thread_.joinable()) thread_.join();
+}
+
+void SysExStreamer::fill() {
+    while (!reader_done_ && buffered_ < chunk_.size()) {
+        const size_t n = reader_(chunk_.data() + buffered_, chunk_.size() - buffered_);
+        if (n == 0) {
+            reader_done_ = true;
+            break;
+        }
+        buffered_ += std::min(n, chunk_.size() - buffered_);
+    }
+}
+
+bool SysExStreamer::next(const uint8_t*& base, size_t& length) {
+    if (span_) {
+        base = span_ + span_offset_;
+        length = span_length_ - span_offset_;
+        if (config_.splitMessages) {
+            length = std::min(config_.chunkSize, length);
+        } else if (const void* eox = std::memchr(base, 0xF7, length)) {
+            length = static_cast<size_t>(static_cast<const uint8_t*>(eox) - base) + 1;
+        }
+        return length > 0 && withinLimit(length);
+    }
+
+    fill();
+    if (config_.splitMessages) {
+        base = chunk_.data();
+        length = buffered_;
+        return length > 0;
+    }
+
+    // Whole message: read on (growing the buffer) until its F7 is staged.
+    size_t scanned = 0;
+    for (;;) {
+        const void* eox = std::memchr(chunk_.data() + scanned, 0xF7, buffered_ - scanned);
+        if (eox) {
+            length = static_cast<size_t>(static_cast<const uint8_t*>(eox) - chunk_.data()) + 1;
+            break;
+        }
+        scanned = buffered_;
+        if (reader_done_) {
+            length = buffered_;  // Unterminated tail: sent as is
+            break;
+        }
+        if (!withinLimit(chunk_.size() + 1)) return false;
+        size_t grown = chunk_.size() * 2;
+        if (config_.maxMessageSize) grown = std::min(grown, config_.maxMessageSize);
+        chunk_.resize(grown);
+        fill();
+    }
+    base = chunk_.data();
+    return length > 0 && withinLimit(length);
+}
+
+bool SysExStreamer::withinLimit(size_t length) {
+    if (config_.splitMessages || config_.maxMessageSize == 0 ||
+        length <= config_.maxMessageSize) {
+        return true;
+    }
+    state_.store(State::TooLarge, std::memory_order_release);
+    return false;
+}
+
+void SysExStreamer::consume(size_t length) {
+    if (span_) {
+        span_offset_ += length;
+        return;
+    }
+    buffered_ -= length;
+    if (buffered_) std::memmove(chunk_.data(), chunk_.data() + length, buffered_);
+}
+
+bool SysExStreamer::pace(uint64_t lastSendUs) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (config_.pacing == SysExStreamerConfig::Pacing::Handshake) {
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::microseconds(config_.handshakeTimeoutUs);
+        if (!cv_.wait_until(lock, deadline, [this] { return cancel_requested_ || acks_ > 0; })) {
+            state_.store(State::TimedOut, std::memory_order_release);
+            return false;
+        }
+        if (cancel_requested_) {
+            state_.store(State::Cancelled, std::memory_order_release);
+            return false;
+        }
+        --acks_;
+        return true;
+    }
+
+    // Delay pacing: absolute deadline from the previous send.
+    const uint64_t deadlineUs = lastSendUs + config_.interChunkDelayUs;
+    const uint64_t nowUs = steadyNowUs();
+    if (deadlineUs > nowUs) {
+        cv_.wait_for(lock, std::chrono::microseconds(deadlineUs - nowUs),
+                     [this] { return cancel_requested_; });
+    }
+    if (cancel_requested_) {
+        state_.store(State::Cancelled, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+void SysExStreamer::run() {
+    uint64_t lastSendUs = 0;
+    bool first = true;
+
+    for (;;) {
+        const uint8_t* base;
+        size_t length;
+        if (!next(base, length)) {
+            if (state() == State::TooLarge) return;
+            break;
+        }
+
+        // Pacing gates the next chunk, so the last one is never waited on.
+        if (!first && !pace(lastSendUs)) return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (cancel_requested_) {
+                state_.store(State::Cancelled, std::memory_order_release);
+                return;
+            }
+        }
+
+        output_(base, length);
+        lastSendUs = steadyNowUs();
+        first = false;
+        consume(length);
+
+        const size_t sent = bytes_sent_.fetch_add(length, std::memory_order_relaxed) + length;
+        if (on_progress_) on_progress_(sent, total_bytes_);
+    }
+
+    state_.store(State::Completed, std::memory_order_release);
+}
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file SysExStreamer.hpp
+ * @brief Background, flow-controlled SysEx transmission (firmware / dumps)
+ *
+ * Streams a SysEx byte source to an output from a dedicated thread:
+ * - Source: a caller-owned span, or a reader callback (file, generator...)
+ * - Chunks: one complete SysEx message (F0 ... F7) per output call, as
+ *   message-oriented outputs (LibreMidiTransport::sendMessage(), WinMM,
+ *   UMP translation) require; or, for byte-stream outputs only (serial,
+ *   rawmidi), fixed chunkSize fragments cut anywhere (splitMessages)
+ * - Pacing between chunks: fixed delay, or handshake (wait for
+ *   acknowledge() of the previous chunk from the receiver's reply handler,
+ *   with timeout). Nothing is awaited after the last chunk
+ * - Progress reported after every chunk
+ *
+ * Reader data is staged in one buffer allocated in start(); it grows once
+ * to the largest message, and nothing is allocated per chunk. A message
+ * longer than maxMessageSize ends the stream (State::TooLarge) before it is
+ * sent, which bounds that buffer and keeps one write from holding the
+ * output unpaced for the whole of a malformed image.
+ *
+ * Usage:
+ *   SysExStreamer streamer;
+ *   streamer.setOutput([&](const uint8_t* data, size_t length) {
+ *       transport.sendMessage(data, length);
+ *   });
+ *   streamer.start(image.data(), image.size());
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oc::hal::midi {
+
+struct SysExStreamerConfig {
+    enum class Pacing : uint8_t {
+        Delay,     ///< Wait interChunkDelayUs after each chunk
+        Handshake  ///< Wait for acknowledge() after each chunk
+    };
+
+    /// Bytes per fragment with splitMessages; initial reader staging size otherwise
+    size_t chunkSize = 256;
+
+    /// Largest whole message (without splitMessages); 0 = no limit
+    size_t maxMessageSize = 64 * 1024;
+
+    /// Cut the stream into chunkSize fragments regardless of message
+    /// boundaries. Only for outputs that take raw bytes: a message-oriented
+    /// output would see SysEx without F0 or F7.
+    bool splitMessages = false;
+
+    Pacing pacing = Pacing::Delay;
+
+    /// Gap between chunks (Delay pacing), measured from the previous send
+    uint32_t interChunkDelayUs = 0;
+
+    /// Give up if no acknowledge() arrives in time (Handshake pacing)
+    uint32_t handshakeTimeoutUs = 1000000;
+};
+
+class SysExStreamer {
+public:
+    enum class State : uint8_t {
+        Idle,
+        Running,
+        Completed,
+        Cancelled,
+        TimedOut,  ///< Handshake not acknowledged in time
+        TooLarge   ///< A message exceeded maxMessageSize; nothing of it was sent
+    };
+
+    /// Receives one chunk per call (one whole message unless splitMessages),
+    /// on the streaming thread
+    using OutputCallback = std::function<void(const uint8_t* data, size_t length)>;
+
+    /// Fills up to @p capacity bytes, returns count (0 = end of source)
+    using ReaderCallback = std::function<size_t(uint8_t* buffer, size_t capacity)>;
+
+    /// bytesSent so far and totalBytes (0 when the reader length is unknown)
+    using ProgressCallback = std::function<void(size_t bytesSent, size_t totalBytes)>;
+
+    SysExStreamer();
+    explicit SysExStreamer(const SysExStreamerConfig& config);
+    ~SysExStreamer();
+
+    SysExStreamer(const SysExStreamer&) = delete;
+    SysExStreamer& operator=(const SysExStreamer&) = delete;
+
+    void setOutput(OutputCallback cb);
+    void setOnProgress(ProgressCallback cb);
+
+    /// Stream a caller-owned buffer (must stay valid until the stream ends)
+    bool start(const uint8_t* data, size_t length);
+
+    /// Stream from a reader; @p totalBytes is only used for progress reports
+    bool start(ReaderCallback reader, size_t totalBytes = 0);
+
+    /// Receiver accepted the last chunk (Handshake pacing). Thread-safe.
+    void acknowledge();
+
+    /// Stop after the current chunk and join the thread
+    void cancel();
+
+    /// Block until the stream ends
+    void wait();
+
+    State state() const { return state_.load(std::memory_order_acquire); }
+    size_t bytesSent() const { return bytes_sent_.load(std::memory_order_relaxed); }
+
+private:
+    bool launch();
+    void run();
+    bool next(const uint8_t*& base, size_t& length);
+    bool withinLimit(size_t length);  // Sets State::TooLarge when not
+    void fill();
+    void consume(size_t length);
+    bool pace(uint64_t lastSendUs);
+
+    SysExStreamerConfig config_;
+    OutputCallback output_;
+    ProgressCallback on_progress_;
+
+    // Source (one of span / reader)
+    const uint8_t* span_ = nullptr;
+    size_t span_length_ = 0;
+    size_t span_offset_ = 0;
+    ReaderCallback reader_;
+    size_t total_bytes_ = 0;
+
+    std::vector<uint8_t> chunk_;
+    size_t buffered_ = 0;
+    bool reader_done_ = false;
+
+    std::thread thread_;
+    std::atomic<State> state_{State::Idle};
+    std::atomic<size_t> bytes_sent_{0};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool cancel_requested_ = false;
+    uint32_t acks_ = 0;
+};
+
+}  // namespace oc::hal::midi
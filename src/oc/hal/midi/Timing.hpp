@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file Timing.hpp
+ * @brief High-resolution timing helpers shared by the MIDI schedulers
+ *
+ * - steadyNowUs(): monotonic microsecond clock used for every MIDI timestamp
+ * - sleepUntilUs(): absolute-deadline wait (coarse sleep + short spin tail)
+ * - JitterMeter: lateness statistics for scheduled output
+ * - raiseThreadPriority(): best-effort realtime priority for timer threads
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
+
+namespace oc::hal::midi {
+
+/// Microseconds on the steady clock (same time base as incoming MIDI timestamps)
+inline uint64_t steadyNowUs() {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+/// Spin window before a deadline; OS sleeps are only trusted up to this margin
+inline constexpr uint32_t DEFAULT_SPIN_US = 500;
+
+/**
+ * @brief Wait until an absolute steady-clock deadline
+ *
+ * Sleeps in bounded slices until @p spinUs before the deadline, then yields
+ * until it is reached. Absolute deadlines keep errors from accumulating over
+ * long sequences. If @p cancel is set, the wait returns early.
+ *
+ * @return false if cancelled before the deadline
+ */
+inline bool sleepUntilUs(uint64_t deadlineUs,
+                         uint32_t spinUs = DEFAULT_SPIN_US,
+                         const std::atomic<bool>* cancel = nullptr) {
+    static constexpr uint64_t MAX_SLICE_US = 10000;
+
+    for (;;) {
+        if (cancel && cancel->load(std::memory_order_relaxed)) return false;
+        const uint64_t now = steadyNowUs();
+        if (now >= deadlineUs) return true;
+
+        const uint64_t remaining = deadlineUs - now;
+        if (remaining > spinUs) {
+            const uint64_t slice = std::min<uint64_t>(remaining - spinUs, MAX_SLICE_US);
+            std::this_thread::sleep_for(std::chrono::microseconds(slice));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/**
+ * @brief Best-effort realtime priority for the calling thread
+ *
+ * Uses SCHED_FIFO on POSIX (usually needs rtprio rights) and
+ * THREAD_PRIORITY_TIME_CRITICAL on Windows.
+ *
+ * @return true if the priority was raised
+ */
+bool raiseThreadPriority();  // Timing.cpp: keeps OS headers out of this one
+
+/**
+ * @brief Snapshot of scheduling lateness (actual - deadline), in microseconds
+ */
+struct JitterStats {
+    uint64_t count = 0;
+    double meanUs = 0.0;
+    double stddevUs = 0.0;
+    int64_t minUs = 0;
+    int64_t maxUs = 0;
+};
+
+/**
+ * @brief Lateness accumulator for one scheduling thread
+ *
+ * record() is called by a single timer thread; stats() may be called from
+ * any thread. Fields are read independently, so a snapshot taken while the
+ * timer runs can mix two consecutive samples.
+ */
+class JitterMeter {
+public:
+    JitterMeter() { reset(); }
+
+    void reset() {
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        sumSq_.store(0.0, std::memory_order_relaxed);
+        min_.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+        max_.store(std::numeric_limits<int64_t>::min(), std::memory_order_relaxed);
+    }
+
+    void record(int64_t lateUs) {
+        count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        sum_.store(sum_.load(std::memory_order_relaxed) + lateUs, std::memory_order_relaxed);
+        const double late = static_cast<double>(lateUs);
+        sumSq_.store(sumSq_.load(std::memory_order_relaxed) + late * late,
+                     std::memory_order_relaxed);
+        if (lateUs < min_.load(std::memory_order_relaxed)) {
+            min_.store(lateUs, std::memory_order_relaxed);
+        }
+        if (lateUs > max_.load(std::memory_order_relaxed)) {
+            max_.store(lateUs, std::memory_order_relaxed);
+        }
+    }
+
+    JitterStats stats() const {
+        JitterStats s{};
+        s.count = count_.load(std::memory_order_relaxed);
+        if (s.count == 0) return s;
+
+        const double n = static_cast<double>(s.count);
+        s.meanUs = static_cast<double>(sum_.load(std::memory_order_relaxed)) / n;
+        const double variance = sumSq_.load(std::memory_order_relaxed) / n - s.meanUs * s.meanUs;
+        s.stddevUs = variance > 0.0 ? std::sqrt(variance) : 0.0;
+        s.minUs = min_.load(std::memory_order_relaxed);
+        s.maxUs = max_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::atomic<uint64_t> count_{0};
+    std::atomic<int64_t> sum_{0};
+    std::atomic<double> sumSq_{0.0};
+    std::atomic<int64_t> min_{0};
+    std::atomic<int64_t> max_{0};
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file TransformPipeline.hpp
+ * @brief Channel remap, transpose, velocity scaling and key zones as a stage chain
+ *
+ * Each transform is a small stage type with an inline apply() that edits a
+ * channel voice message (at most 3 bytes) in place and returns false to
+ * drop it. Stages leave messages they do not concern untouched; system
+ * messages only meet FilterTypes.
+ *
+ * Two ways to chain them:
+ * - TransformPipeline: built at run time (from configuration) into a flat
+ *   array of at most MAX_STAGES stages, no allocation; each step is one
+ *   std::visit over the stage variant
+ * - StaticTransform<Stages...>: chain fixed at compile time; the compiler
+ *   inlines the whole chain
+ *
+ * Usage:
+ *   TransformPipeline pipeline;
+ *   pipeline.add(transform::KeyZone{0, 59, 1});    // split: lower half -> ch 2
+ *   pipeline.add(transform::Transpose{12});
+ *   pipeline.add(transform::ScaleVelocity{192});   // x0.75
+ *   if (pipeline.apply(bytes, length)) send(bytes, length);
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <variant>
+
+#include "MidiEvent.hpp"
+
+namespace oc::hal::midi {
+
+namespace transform {
+
+inline bool isChannelVoice(const uint8_t* m) { return m[0] >= 0x80 && m[0] < 0xF0; }
+
+/// Note On, Note Off or Poly Pressure: data1 is a note number
+inline bool isNoteMessage(const uint8_t* m) {
+    const uint8_t type = m[0] & 0xF0;
+    return type == 0x80 || type == 0x90 || type == 0xA0;
+}
+
+inline MidiEventType eventType(const uint8_t* m, size_t length) {
+    MidiEvent event;
+    decodeMidiEvent(m, length, event);
+    return event.type;
+}
+
+/// Keep only these message types (OR of midiEventBit())
+struct FilterTypes {
+    uint32_t mask = ~0u;
+
+    bool apply(uint8_t* m, size_t length) const {
+        return (mask & midiEventBit(eventType(m, length))) != 0;
+    }
+};
+
+/// Keep channel voice messages of these channels only (bit n = channel n)
+struct FilterChannels {
+    uint16_t mask = 0xFFFF;
+
+    bool apply(uint8_t* m, size_t) const {
+        return !isChannelVoice(m) || ((mask >> (m[0] & 0x0F)) & 1u);
+    }
+};
+
+/// Output channel per input channel, or DROP
+struct MapChannel {
+    static constexpr uint8_t DROP = 0xFF;
+    uint8_t map[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
+    bool apply(uint8_t* m, size_t) const {
+        if (!isChannelVoice(m)) return true;
+        const uint8_t to = map[m[0] & 0x0F];
+        if (to == DROP) return false;
+        m[0] = static_cast<uint8_t>((m[0] & 0xF0) | (to & 0x0F));
+        return true;
+    }
+};
+
+/// Shift note numbers; notes leaving 0-127 are dropped
+struct Transpose {
+    int8_t semitones = 0;
+
+    bool apply(uint8_t* m, size_t) const {
+        if (!isNoteMessage(m)) return true;
+        const int note = m[1] + semitones;
+        if (note < 0 || note > 127) return false;
+        m[1] = static_cast<uint8_t>(note);
+        return true;
+    }
+};
+
+/// Note On velocity * scale / 256 + offset, clamped to [min, max] (never 0)
+struct ScaleVelocity {
+    uint16_t scale = 256;  ///< 8.8 fixed point: 256 = x1
+    int8_t offset = 0;
+    uint8_t min = 1;
+    uint8_t max = 127;
+
+    bool apply(uint8_t* m, size_t) const {
+        if ((m[0] & 0xF0) != 0x90 || m[2] == 0) return true;  // Velocity 0 is a Note Off
+        int v = ((m[2] * scale) >> 8) + offset;
+        const int lo = min ? min : 1;
+        if (v < lo) v = lo;
+        if (v > max) v = max;
+        m[2] = static_cast<uint8_t>(v);
+        return true;
+    }
+};
+
+/// Notes in [low, high] go to @p channel (one stage per keyboard zone)
+struct KeyZone {
+    uint8_t low = 0;
+    uint8_t high = 127;
+    uint8_t channel = 0;
+
+    bool apply(uint8_t* m, size_t) const {
+        if (isNoteMessage(m) && m[1] >= low && m[1] <= high) {
+            m[0] = static_cast<uint8_t>((m[0] & 0xF0) | (channel & 0x0F));
+        }
+        return true;
+    }
+};
+
+}  // namespace transform
+
+/// Stage chain fixed at compile time
+template <typename... Stages>
+class StaticTransform {
+public:
+    explicit StaticTransform(Stages... stages) : stages_(stages...) {}
+
+    bool apply(uint8_t* message, size_t length) const {
+        return std::apply(
+            [&](const Stages&... stage) { return (stage.apply(message, length) && ...); },
+            stages_);
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+};
+
+/// Stage chain built at run time into a fixed array
+class TransformPipeline {
+public:
+    using Stage = std::variant<transform::FilterTypes, transform::FilterChannels,
+                               transform::MapChannel, transform::Transpose,
+                               transform::ScaleVelocity, transform::KeyZone>;
+
+    static constexpr size_t MAX_STAGES = 16;
+
+    /// @return false if the pipeline is full
+    bool add(const Stage& stage) {
+        if (count_ == MAX_STAGES) return false;
+        stages_[count_++] = stage;
+        return true;
+    }
+
+    void clear() { count_ = 0; }
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    /**
+     * @brief Run the chain on one message of at most 3 bytes, in place
+     * @return false if a stage dropped it
+     */
+    bool apply(uint8_t* message, size_t length) const {
+        for (size_t i = 0; i < count_; ++i) {
+            const bool keep =
+                std::visit([&](const auto& stage) { return stage.apply(message, length); },
+                           stages_[i]);
+            if (!keep) return false;
+        }
+        return true;
+    }
+
+    /// Whether messages of @p type survive the type filters (for SysEx,
+    /// which the other stages never edit)
+    bool passes(MidiEventType type) const {
+        for (size_t i = 0; i < count_; ++i) {
+            const auto* filter = std::get_if<transform::FilterTypes>(&stages_[i]);
+            if (filter && !(filter->mask & midiEventBit(type))) return false;
+        }
+        return true;
+    }
+
+private:
+    std::array<Stage, MAX_STAGES> stages_;
+    size_t count_ = 0;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * @file Ump.hpp
+ * @brief MIDI 2.0 Universal MIDI Packets (UMP) and per-type dispatch
+ *
+ * A UMP is one to four 32-bit words; the message type in the top nibble of
+ * the first word fixes the size. UmpPacket always reserves four words so
+ * packets can live by value in fixed arrays and lock-free queues, with no
+ * allocation and no variable-length framing on the hot path.
+ *
+ * UmpDispatcher routes packets through a 16-entry table indexed by message
+ * type (one load and an indirect call, no status-byte switch).
+ *
+ * Translation to and from MIDI 1.0 byte messages is in UmpTranslator.hpp.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace oc::hal::midi {
+
+/// UMP message types (top nibble of word 0)
+enum class UmpType : uint8_t {
+    Utility = 0x0,
+    System = 0x1,             ///< System common / realtime (32 bit)
+    Midi1ChannelVoice = 0x2,  ///< MIDI 1.0 channel voice (32 bit)
+    Data64 = 0x3,             ///< SysEx 7-bit (64 bit)
+    Midi2ChannelVoice = 0x4,  ///< MIDI 2.0 channel voice (64 bit)
+    Data128 = 0x5,            ///< SysEx 8-bit / mixed data (128 bit)
+    FlexData = 0xD,
+    Stream = 0xF
+};
+
+/// Words in a packet of message type @p type (0-15)
+constexpr uint8_t umpWordCount(uint8_t type) {
+    constexpr uint8_t WORDS[16] = {1, 1, 1, 2, 2, 4, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4};
+    return WORDS[type & 0x0F];
+}
+
+/// Status nibble of a 64-bit SysEx7 packet
+enum class UmpSysExStatus : uint8_t {
+    Complete = 0x0,
+    Start = 0x1,
+    Continue = 0x2,
+    End = 0x3
+};
+
+struct UmpPacket {
+    uint32_t words[4] = {};
+
+    uint8_t type() const { return static_cast<uint8_t>(words[0] >> 28); }
+    uint8_t group() const { return static_cast<uint8_t>((words[0] >> 24) & 0x0F); }
+
+    /// Status byte of system / channel voice packets (includes the channel)
+    uint8_t status() const { return static_cast<uint8_t>((words[0] >> 16) & 0xFF); }
+    uint8_t channel() const { return static_cast<uint8_t>((words[0] >> 16) & 0x0F); }
+
+    size_t wordCount() const { return umpWordCount(type()); }
+};
+
+class UmpDispatcher {
+public:
+    using Handler = std::function<void(const UmpPacket& packet)>;
+
+    void setHandler(UmpType type, Handler handler) {
+        handlers_[static_cast<uint8_t>(type) & 0x0F] = std::move(handler);
+    }
+
+    bool hasHandler(uint8_t type) const { return static_cast<bool>(handlers_[type & 0x0F]); }
+
+    /// @return false if no handler is registered for the packet's type
+    bool dispatch(const UmpPacket& packet) const {
+        const Handler& handler = handlers_[packet.type()];
+        if (!handler) return false;
+        handler(packet);
+        return true;
+    }
+
+private:
+    std::array<Handler, 16> handlers_;
+};
+
+}  // namespace oc::hal::midi
@@ -0,0 +1,424 @@
+#pragma once
+
+/**
+ * @file UmpTranslator.hpp
+ * @brief MIDI 1.0 byte messages <-> Universal MIDI Packets
+ *
+ * Midi1ToUmp turns one complete MIDI 1.0 message (as framed by
+ * MidiStreamParser) into packets:
+ * - System common / realtime -> type 1
+ * - Channel voice -> type 2 (MIDI 1.0 protocol), or type 4 (MIDI 2.0
+ *   protocol) with values upscaled by the MIDI 2.0 min-centre-max rule.
+ *   In MIDI 2.0 mode, CC 0 / 32 are held per channel and sent as the bank
+ *   of the next Program Change, as the translation rules require; a bank
+ *   select without a following Program Change has no MIDI 2.0 form and is
+ *   not sent. RPN / NRPN selections (CC 101/100, 99/98) are held too, and
+ *   each Data Entry CC 6 or 38 under one becomes a Registered / Assignable
+ *   Controller message carrying the current 14-bit value (LSB 0 on CC 6,
+ *   so 7-bit senders still get through). Increment / decrement (96 / 97)
+ *   and data entry without a selection stay CCs
+ * - SysEx -> type 3 packets of up to 6 data bytes (F0 / F7 stripped)
+ *
+ * UmpToMidi1 goes the other way for types 1-4, reassembling SysEx7 into a
+ * caller buffer and turning MIDI 2.0 Program Change (with bank) and
+ * RPN / NRPN into the equivalent CC sequences. Other types are ignored.
+ *
+ * Both are allocation-free and emit through a callback; neither is
+ * thread-safe (keep one per direction and port).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "MidiStreamParser.hpp"
+#include "Ump.hpp"
+
+namespace oc::hal::midi {
+
+/// MIDI 2.0 value upscaling (min-centre-max preserving), @p dstBits <= 32
+constexpr uint32_t umpScaleUp(uint32_t value, uint8_t srcBits, uint8_t dstBits) {
+    const uint8_t scaleBits = static_cast<uint8_t>(dstBits - srcBits);
+    uint64_t shifted = static_cast<uint64_t>(value) << scaleBits;
+    const uint32_t center = 1u << (srcBits - 1);
+    if (value <= center) return static_cast<uint32_t>(shifted);
+
+    const uint8_t repeatBits = static_cast<uint8_t>(srcBits - 1);
+    uint64_t repeat = value & ((1u << repeatBits) - 1);
+    if (scaleBits > repeatBits) {
+        repeat <<= scaleBits - repeatBits;
+    } else {
+        repeat >>= repeatBits - scaleBits;
+    }
+    while (repeat != 0) {
+        shifted |= repeat;
+        repeat >>= repeatBits;
+    }
+    return static_cast<uint32_t>(shifted);
+}
+
+/// MIDI 2.0 value downscaling (drop low bits)
+constexpr uint32_t umpScaleDown(uint32_t value, uint8_t srcBits, uint8_t dstBits) {
+    return value >> (srcBits - dstBits);
+}
+
+class Midi1ToUmp {
+public:
+    explicit Midi1ToUmp(uint8_t group = 0, bool midi2Protocol = false)
+        : group_(group & 0x0F), midi2_(midi2Protocol) {
+        reset();
+    }
+
+    void setGroup(uint8_t group) { group_ = group & 0x0F; }
+    void setMidi2Protocol(bool enabled) { midi2_ = enabled; }
+
+    /// Forget held bank and parameter selects
+    void reset() {
+        for (auto& bank : banks_) bank = Bank{};
+        for (auto& parameter : parameters_) parameter = Parameter{};
+    }
+
+    /**
+     * @brief Convert one complete MIDI 1.0 message
+     * @param emit Called with each UmpPacket
+     * @return Packets emitted
+     */
+    template <typename Emit>
+    size_t convert(const uint8_t* data, size_t length, Emit&& emit) {
+        if (!data || length == 0) return 0;
+        const uint8_t status = data[0];
+
+        if (status == 0xF0) return convertSysEx(data, length, emit);
+        if (status < 0x80) return 0;
+
+        const size_t needed = 1 + midiDataLength(status);
+        if (status >= 0xF0) {
+            if (status == 0xF7 || length < needed) return 0;
+            emitWord(emit, 0x1, status, needed > 1 ? data[1] : 0, needed > 2 ? data[2] : 0);
+            return 1;
+        }
+        if (length < needed) return 0;
+        const uint8_t d1 = data[1] & 0x7F;
+        const uint8_t d2 = needed > 2 ? data[2] & 0x7F : 0;
+
+        if (!midi2_) {
+            emitWord(emit, 0x2, status, d1, d2);
+            return 1;
+        }
+        return convertMidi2(status, d1, d2, emit);
+    }
+
+private:
+    struct Bank {
+        uint8_t msb = 0;
+        uint8_t lsb = 0;
+        bool valid = false;
+    };
+
+    struct Parameter {
+        uint8_t status = 0;  // 0x20 RPN, 0x30 NRPN (type 4 opcode), 0 none
+        uint8_t msb = 0x7F;  // Selected number; 127 / 127 is the null parameter
+        uint8_t lsb = 0x7F;
+        uint8_t dataMsb = 0;
+
+        bool selected() const { return status != 0 && !(msb == 0x7F && lsb == 0x7F); }
+    };
+
+    template <typename Emit>
+    void emitWord(Emit& emit, uint8_t type, uint8_t status, uint8_t d1, uint8_t d2) {
+        UmpPacket packet;
+        packet.words[0] = (static_cast<uint32_t>(type) << 28) |
+                          (static_cast<uint32_t>(group_) << 24) |
+                          (static_cast<uint32_t>(status) << 16) |
+                          (static_cast<uint32_t>(d1) << 8) | d2;
+        emit(static_cast<const UmpPacket&>(packet));
+    }
+
+    template <typename Emit>
+    void emitMidi2(Emit& emit, uint8_t status, uint8_t index1, uint8_t index2, uint32_t data) {
+        UmpPacket packet;
+        packet.words[0] = (0x4u << 28) | (static_cast<uint32_t>(group_) << 24) |
+                          (static_cast<uint32_t>(status) << 16) |
+                          (static_cast<uint32_t>(index1) << 8) | index2;
+        packet.words[1] = data;
+        emit(static_cast<const UmpPacket&>(packet));
+    }
+
+    void selectParameter(Parameter& parameter, uint8_t controller, uint8_t value) {
+        const uint8_t status = controller >= 100 ? 0x20 : 0x30;
+        if (parameter.status != status) parameter = Parameter{status};
+        (controller == 101 || controller == 99 ? parameter.msb : parameter.lsb) = value;
+        parameter.dataMsb = 0;
+    }
+
+    template <typename Emit>
+    size_t convertMidi2(uint8_t status, uint8_t d1, uint8_t d2, Emit& emit) {
+        const uint8_t type = status & 0xF0;
+        const uint8_t channel = status & 0x0F;
+        Bank& bank = banks_[channel];
+        Parameter& parameter = parameters_[channel];
+
+        switch (type) {
+            case 0x90:
+                if (d2 == 0) {  // MIDI 1.0 Note On velocity 0 is a Note Off
+                    emitMidi2(emit, static_cast<uint8_t>(0x80 | (status & 0x0F)), d1, 0,
+                              umpScaleUp(0x40, 7, 16) << 16);
+                    return 1;
+                }
+                emitMidi2(emit, status, d1, 0, umpScaleUp(d2, 7, 16) << 16);
+                return 1;
+            case 0x80:
+                emitMidi2(emit, status, d1, 0, umpScaleUp(d2, 7, 16) << 16);
+                return 1;
+            case 0xA0:
+                emitMidi2(emit, status, d1, 0, umpScaleUp(d2, 7, 32));
+                return 1;
+            case 0xB0:
+                if (d1 == 0 || d1 == 32) {
+                    (d1 == 0 ? bank.msb : bank.lsb) = d2;
+                    bank.valid = true;
+                    return 0;
+                }
+                if (d1 >= 98 && d1 <= 101) {
+                    selectParameter(parameter, d1, d2);
+                    return 0;
+                }
+                if ((d1 == 6 || d1 == 38) && parameter.selected()) {
+                    uint8_t lsb = 0;
+                    if (d1 == 6) {
+                        parameter.dataMsb = d2;
+                    } else {
+                        lsb = d2;
+                    }
+                    emitMidi2(emit, static_cast<uint8_t>(parameter.status | channel),
+                              parameter.msb, parameter.lsb,
+                              umpScaleUp(static_cast<uint32_t>((parameter.dataMsb << 7) | lsb),
+                                         14, 32));
+                    return 1;
+                }
+                emitMidi2(emit, status, d1, 0, umpScaleUp(d2, 7, 32));
+                return 1;
+            case 0xC0:
+                emitMidi2(emit, status, 0, bank.valid ? 0x01 : 0x00,
+                          (static_cast<uint32_t>(d1) << 24) |
+                              (static_cast<uint32_t>(bank.msb) << 8) | bank.lsb);
+                bank.valid = false;
+                return 1;
+            case 0xD0:
+                emitMidi2(emit, status, 0, 0, umpScaleUp(d1, 7, 32));
+                return 1;
+            case 0xE0:
+                emitMidi2(emit, status, 0, 0,
+                          umpScaleUp(static_cast<uint32_t>(d1 | (d2 << 7)), 14, 32));
+                return 1;
+            default:
+                return 0;
+        }
+    }
+
+    template <typename Emit>
+    size_t convertSysEx(const uint8_t* data, size_t length, Emit& emit) {
+        const uint8_t* payload = data + 1;
+        size_t remaining = length - 1;
+        if (remaining > 0 && payload[remaining - 1] == 0xF7) --remaining;
+
+        size_t packets = 0;
+        bool first = true;
+        do {
+            const size_t count = remaining < 6 ? remaining : 6;
+            const bool last = remaining <= 6;
+            UmpSysExStatus phase = UmpSysExStatus::Continue;
+            if (first && last) {
+                phase = UmpSysExStatus::Complete;
+            } else if (first) {
+                phase = UmpSysExStatus::Start;
+            } else if (last) {
+                phase = UmpSysExStatus::End;
+            }
+
+            uint8_t bytes[6] = {};
+            if (count) std::memcpy(bytes, payload, count);
+
+            UmpPacket packet;
+            packet.words[0] = (0x3u << 28) | (static_cast<uint32_t>(group_) << 24) |
+                              (static_cast<uint32_t>(phase) << 20) |
+                              (static_cast<uint32_t>(count) << 16) |
+                              (static_cast<uint32_t>(bytes[0]) << 8) | bytes[1];
+            packet.words[1] = (static_cast<uint32_t>(bytes[2]) << 24) |
+                              (static_cast<uint32_t>(bytes[3]) << 16) |
+                              (static_cast<uint32_t>(bytes[4]) << 8) | bytes[5];
+            emit(static_cast<const UmpPacket&>(packet));
+
+            payload += count;
+            remaining -= count;
+            first = false;
+            ++packets;
+        } while (remaining > 0);
+        return packets;
+    }
+
+    uint8_t group_;
+    bool midi2_;
+    Bank banks_[16];
+    Parameter parameters_[16];
+};
+
+class UmpToMidi1 {
+public:
+    /// @param sysexBuffer Holds one reassembled SysEx (F0 ... F7)
+    UmpToMidi1(uint8_t* sysexBuffer, size_t capacity)
+        : sysex_(sysexBuffer), capacity_(capacity) {}
+
+    void setSysExBuffer(uint8_t* sysexBuffer, size_t capacity) {
+        sysex_ = sysexBuffer;
+        capacity_ = capacity;
+        sysexLength_ = 0;
+        inSysEx_ = false;
+    }
+
+    /// SysEx dropped because they did not fit the buffer
+    uint32_t sysexOverflows() const { return overflows_; }
+
+    /**
+     * @brief Convert one packet
+     * @param emit Called with each complete MIDI 1.0 message
+     * @return Messages emitted
+     */
+    template <typename Emit>
+    size_t convert(const UmpPacket& packet, Emit&& emit) {
+        const uint8_t status = packet.status();
+        switch (packet.type()) {
+            case 0x1:
+            case 0x2: {
+                if (status < 0x80 || status == 0xF0 || status == 0xF7) return 0;
+                const uint8_t bytes[3] = {status,
+                                          static_cast<uint8_t>((packet.words[0] >> 8) & 0x7F),
+                                          static_cast<uint8_t>(packet.words[0] & 0x7F)};
+                emit(static_cast<const uint8_t*>(bytes), static_cast<size_t>(1 + midiDataLength(status)));
+                return 1;
+            }
+            case 0x3:
+                return convertSysEx(packet, emit);
+            case 0x4:
+                return convertMidi2(packet, emit);
+            default:
+                return 0;
+        }
+    }
+
+private:
+    template <typename Emit>
+    static void emit3(Emit& emit, uint8_t status, uint8_t d1, uint8_t d2) {
+        const uint8_t bytes[3] = {status, static_cast<uint8_t>(d1 & 0x7F),
+                                  static_cast<uint8_t>(d2 & 0x7F)};
+        emit(static_cast<const uint8_t*>(bytes), static_cast<size_t>(1 + midiDataLength(status)));
+    }
+
+    template <typename Emit>
+    size_t convertMidi2(const UmpPacket& packet, Emit& emit) {
+        const uint8_t status = packet.status();
+        const uint8_t channel = status & 0x0F;
+        const uint8_t index1 = static_cast<uint8_t>((packet.words[0] >> 8) & 0x7F);
+        const uint8_t index2 = static_cast<uint8_t>(packet.words[0] & 0xFF);
+        const uint32_t data = packet.words[1];
+        const uint8_t cc = static_cast<uint8_t>(0xB0 | channel);
+
+        switch (status & 0xF0) {
+            case 0x80:
+                emit3(emit, status, index1, static_cast<uint8_t>(umpScaleDown(data >> 16, 16, 7)));
+                return 1;
+            case 0x90: {
+                // MIDI 2.0 velocity 0 is a real Note On: send the smallest 7-bit velocity
+                uint8_t velocity = static_cast<uint8_t>(umpScaleDown(data >> 16, 16, 7));
+                if (velocity == 0) velocity = 1;
+                emit3(emit, status, index1, velocity);
+                return 1;
+            }
+            case 0xA0:
+                emit3(emit, status, index1, static_cast<uint8_t>(umpScaleDown(data, 32, 7)));
+                return 1;
+            case 0xB0:
+                emit3(emit, status, index1, static_cast<uint8_t>(umpScaleDown(data, 32, 7)));
+                return 1;
+            case 0xC0: {
+                size_t count = 1;
+                if (index2 & 0x01) {  // Bank valid
+                    emit3(emit, cc, 0, static_cast<uint8_t>(data >> 8));
+                    emit3(emit, cc, 32, static_cast<uint8_t>(data));
+                    count += 2;
+                }
+                emit3(emit, status, static_cast<uint8_t>(data >> 24), 0);
+                return count;
+            }
+            case 0xD0:
+                emit3(emit, status, static_cast<uint8_t>(umpScaleDown(data, 32, 7)), 0);
+                return 1;
+            case 0xE0: {
+                const uint32_t bend = umpScaleDown(data, 32, 14);
+                emit3(emit, status, static_cast<uint8_t>(bend & 0x7F),
+                      static_cast<uint8_t>(bend >> 7));
+                return 1;
+            }
+            case 0x20:    // Registered controller (RPN)
+            case 0x30: {  // Assignable controller (NRPN)
+                const bool rpn = (status & 0xF0) == 0x20;
+                const uint32_t value = umpScaleDown(data, 32, 14);
+                emit3(emit, cc, rpn ? 101 : 99, index1);
+                emit3(emit, cc, rpn ? 100 : 98, index2 & 0x7F);
+                emit3(emit, cc, 6, static_cast<uint8_t>(value >> 7));
+                emit3(emit, cc, 38, static_cast<uint8_t>(value & 0x7F));
+                return 4;
+            }
+            default:
+                return 0;  // Per-note and relative messages have no MIDI 1.0 form
+        }
+    }
+
+    template <typename Emit>
+    size_t convertSysEx(const UmpPacket& packet, Emit& emit) {
+        const auto phase = static_cast<UmpSysExStatus>((packet.words[0] >> 20) & 0x0F);
+        size_t count = (packet.words[0] >> 16) & 0x0F;
+        if (count > 6) count = 6;
+        const uint8_t bytes[6] = {static_cast<uint8_t>(packet.words[0] >> 8),
+                                  static_cast<uint8_t>(packet.words[0]),
+                                  static_cast<uint8_t>(packet.words[1] >> 24),
+                                  static_cast<uint8_t>(packet.words[1] >> 16),
+                                  static_cast<uint8_t>(packet.words[1] >> 8),
+                                  static_cast<uint8_t>(packet.words[1])};
+
+        if (phase == UmpSysExStatus::Complete || phase == UmpSysExStatus::Start) {
+            inSysEx_ = true;
+            sysexLength_ = 0;
+            append(0xF0);
+        } else if (!inSysEx_) {
+            return 0;  // Continue / End without Start
+        }
+        for (size_t i = 0; i < count; ++i) append(bytes[i] & 0x7F);
+
+        if (phase == UmpSysExStatus::Complete || phase == UmpSysExStatus::End) {
+            inSysEx_ = false;
+            append(0xF7);
+            if (sysexLength_ > capacity_) {
+                ++overflows_;
+                return 0;
+            }
+            emit(static_cast<const uint8_t*>(sysex_), sysexLength_);
+            return 1;
+        }
+        return 0;
+    }
+
+    void append(uint8_t byte) {
+        // Past capacity only the length advances, so overflow is detected at the end.
+        if (sysexLength_ < capacity_) sysex_[sysexLength_] = byte;
+        ++sysexLength_;
+    }
+
+    uint8_t* sysex_;
+    size_t capacity_;
+    size_t sysexLength_ = 0;
+    bool inSysEx_ = false;
+    uint32_t overflows_ = 0;
+};
+
+}  // namespace oc::hal::midi
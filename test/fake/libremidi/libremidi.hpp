@@ -0,0 +1,236 @@
+#pragma once
+
+/**
+ * @file libremidi.hpp
+ * @brief In-process test double of the libremidi subset used by the transport
+ *
+ * One input and one output port ("Fake IN" / "Fake OUT"). Tests inject
+ * input with fake::receive() (on the calling thread, as a backend thread
+ * would) and read what the transport sent from fake::sent().
+ *
+ * Usage:
+ *   libremidi::fake::reset();
+ *   transport.init();
+ *   libremidi::fake::receive({0x90, 60, 100});
+ *   transport.update();
+ *   auto out = libremidi::fake::sent();
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace libremidi {
+
+struct message {
+    std::vector<unsigned char> bytes;
+    int64_t timestamp = 0;
+};
+
+struct ump {
+    uint32_t data[4] = {};
+    int64_t timestamp = 0;
+};
+
+struct input_port {
+    std::string display_name;
+};
+
+struct output_port {
+    std::string display_name;
+};
+
+enum class API { UNSPECIFIED, WEBMIDI };
+
+struct input_configuration {
+    std::function<void(message&&)> on_message;
+    bool ignore_timing = true;
+    bool ignore_sysex = false;
+    bool ignore_sensing = true;
+};
+
+struct ump_input_configuration {
+    std::function<void(ump&&)> on_message;
+    bool ignore_timing = true;
+    bool ignore_sysex = false;
+    bool ignore_sensing = true;
+};
+
+struct output_configuration {};
+
+struct observer_configuration {
+    std::function<void(const input_port&)> input_added;
+    std::function<void(const input_port&)> input_removed;
+    std::function<void(const output_port&)> output_added;
+    std::function<void(const output_port&)> output_removed;
+    bool track_hardware = false;
+    bool track_virtual = false;
+};
+
+class midi_in;
+
+namespace fake {
+
+struct Backend {
+    std::mutex mutex;
+    midi_in* input = nullptr;
+    bool outputConnected = true;  ///< is_port_connected() of the open output
+    std::vector<std::vector<uint8_t>> sent;
+    std::vector<std::vector<uint32_t>> sentUmp;
+};
+
+inline Backend& backend() {
+    static Backend instance;
+    return instance;
+}
+
+}  // namespace fake
+
+class observer {
+public:
+    explicit observer(observer_configuration = {}) {}
+    template <typename Api>
+    observer(observer_configuration, Api) {}
+
+    std::vector<input_port> get_input_ports() const { return {{"Fake IN"}}; }
+    std::vector<output_port> get_output_ports() const { return {{"Fake OUT"}}; }
+};
+
+class midi_in {
+public:
+    explicit midi_in(input_configuration config) : on_message_(std::move(config.on_message)) {}
+    explicit midi_in(ump_input_configuration config) : on_ump_(std::move(config.on_message)) {}
+    template <typename Api>
+    midi_in(input_configuration config, Api) : midi_in(std::move(config)) {}
+    template <typename Api>
+    midi_in(ump_input_configuration config, Api) : midi_in(std::move(config)) {}
+
+    ~midi_in() {
+        std::lock_guard<std::mutex> lock(fake::backend().mutex);
+        if (fake::backend().input == this) fake::backend().input = nullptr;
+    }
+
+    midi_in(const midi_in&) = delete;
+    midi_in& operator=(const midi_in&) = delete;
+
+    void open_port(const input_port&) { open(); }
+    void open_virtual_port(const std::string&) { open(); }
+    bool is_port_connected() const { return open_; }
+
+    void deliver(message&& msg) {
+        if (on_message_) on_message_(std::move(msg));
+    }
+    void deliver(ump&& packet) {
+        if (on_ump_) on_ump_(std::move(packet));
+    }
+
+private:
+    void open() {
+        std::lock_guard<std::mutex> lock(fake::backend().mutex);
+        fake::backend().input = this;
+        open_ = true;
+    }
+
+    std::function<void(message&&)> on_message_;
+    std::function<void(ump&&)> on_ump_;
+    bool open_ = false;
+};
+
+class midi_out {
+public:
+    midi_out() = default;
+    explicit midi_out(output_configuration) {}
+    template <typename Api>
+    midi_out(output_configuration, Api) {}
+
+    void open_port(const output_port&) { open_ = true; }
+    void open_virtual_port(const std::string&) { open_ = true; }
+    void close_port() { open_ = false; }
+
+    bool is_port_connected() const {
+        std::lock_guard<std::mutex> lock(fake::backend().mutex);
+        return open_ && fake::backend().outputConnected;
+    }
+
+    void send_message(const unsigned char* data, size_t length) {
+        std::lock_guard<std::mutex> lock(fake::backend().mutex);
+        fake::backend().sent.emplace_back(data, data + length);
+    }
+    void send_message(const message& msg) { send_message(msg.bytes.data(), msg.bytes.size()); }
+
+    void send_ump(const uint32_t* words, size_t count) {
+        std::lock_guard<std::mutex> lock(fake::backend().mutex);
+        fake::backend().sentUmp.emplace_back(words, words + count);
+    }
+
+private:
+    bool open_ = false;
+};
+
+namespace midi2 {
+
+struct api_configuration {};
+inline api_configuration in_default_configuration() { return {}; }
+inline api_configuration out_default_configuration() { return {}; }
+inline api_configuration observer_default_configuration() { return {}; }
+
+}  // namespace midi2
+
+inline API midi_in_configuration_for(API api) { return api; }
+inline API observer_configuration_for(API api) { return api; }
+
+namespace fake {
+
+/// Forget sent messages and reconnect the output
+inline void reset() {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().outputConnected = true;
+    backend().sent.clear();
+    backend().sentUmp.clear();
+}
+
+/// Deliver one backend callback to the open input
+inline void receive(std::vector<uint8_t> bytes) {
+    midi_in* input;
+    {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        input = backend().input;
+    }
+    if (input) input->deliver(message{std::move(bytes), 0});
+}
+
+/// Deliver one Universal MIDI Packet to the open (UMP) input
+inline void receiveUmp(const uint32_t* words, size_t count) {
+    midi_in* input;
+    {
+        std::lock_guard<std::mutex> lock(backend().mutex);
+        input = backend().input;
+    }
+    ump packet;
+    for (size_t i = 0; i < count && i < 4; ++i) packet.data[i] = words[i];
+    if (input) input->deliver(std::move(packet));
+}
+
+/// Unplug / replug the output port
+inline void setOutputConnected(bool connected) {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    backend().outputConnected = connected;
+}
+
+/// Messages sent so far (copy)
+inline std::vector<std::vector<uint8_t>> sent() {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    return backend().sent;
+}
+
+inline std::vector<std::vector<uint32_t>> sentUmp() {
+    std::lock_guard<std::mutex> lock(backend().mutex);
+    return backend().sentUmp;
+}
+
+}  // namespace fake
+}  // namespace libremidi
@@ -0,0 +1,52 @@
+#pragma once
+
+/**
+ * @file IMidi.hpp
+ * @brief Test double of the framework MIDI interface (what the transport implements)
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <oc/type/Result.hpp>
+
+namespace oc::interface {
+
+class IMidi {
+public:
+    using CCCallback = std::function<void(uint8_t channel, uint8_t cc, uint8_t value)>;
+    using NoteCallback = std::function<void(uint8_t channel, uint8_t note, uint8_t velocity)>;
+    using SysExCallback = std::function<void(const uint8_t* data, size_t length)>;
+    using ClockCallback = std::function<void(uint64_t timestampUs)>;
+    using RealtimeCallback = std::function<void()>;
+
+    virtual ~IMidi() = default;
+
+    virtual oc::type::Result<void> init() = 0;
+    virtual void update() = 0;
+
+    virtual void sendCC(uint8_t channel, uint8_t cc, uint8_t value) = 0;
+    virtual void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) = 0;
+    virtual void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) = 0;
+    virtual void sendSysEx(const uint8_t* data, size_t length) = 0;
+    virtual void sendProgramChange(uint8_t channel, uint8_t program) = 0;
+    virtual void sendPitchBend(uint8_t channel, int16_t value) = 0;
+    virtual void sendChannelPressure(uint8_t channel, uint8_t pressure) = 0;
+    virtual void sendClock() = 0;
+    virtual void sendStart() = 0;
+    virtual void sendStop() = 0;
+    virtual void sendContinue() = 0;
+    virtual void allNotesOff() = 0;
+
+    virtual void setOnCC(CCCallback cb) = 0;
+    virtual void setOnNoteOn(NoteCallback cb) = 0;
+    virtual void setOnNoteOff(NoteCallback cb) = 0;
+    virtual void setOnSysEx(SysExCallback cb) = 0;
+    virtual void setOnClock(ClockCallback cb) = 0;
+    virtual void setOnStart(RealtimeCallback cb) = 0;
+    virtual void setOnStop(RealtimeCallback cb) = 0;
+    virtual void setOnContinue(RealtimeCallback cb) = 0;
+};
+
+}  // namespace oc::interface
@@ -0,0 +1,25 @@
+#pragma once
+
+/**
+ * @file Result.hpp
+ * @brief Test double of the framework Result type (what the transport uses)
+ */
+
+namespace oc::type {
+
+enum class ErrorCode { HARDWARE_INIT_FAILED };
+
+template <typename T>
+class Result {
+public:
+    static Result ok() { return Result(true); }
+    static Result err(ErrorCode) { return Result(false); }
+
+    bool isOk() const { return ok_; }
+
+private:
+    explicit Result(bool ok) : ok_(ok) {}
+    bool ok_;
+};
+
+}  // namespace oc::type
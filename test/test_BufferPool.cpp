@@ -0,0 +1,109 @@
+/**
+ * @file test_BufferPool.cpp
+ * @brief Unit tests for BufferPool
+ *
+ * Checks that released buffers are reused with their capacity, that the
+ * best-fitting buffer is picked, and that the pool stays bounded.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/BufferPool.hpp>
+
+using oc::hal::midi::BufferPool;
+
+namespace test {
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_AcquireCopiesData() {
+    BufferPool pool(2, 16);
+    const uint8_t sysex[] = {0xF0, 0x7D, 0x01, 0x02, 0xF7};
+
+    auto buffer = pool.acquire(sysex, sizeof(sysex));
+    assert(buffer == std::vector<uint8_t>(sysex, sysex + sizeof(sysex)));
+    assert(buffer.capacity() >= 16);
+    assert(pool.available() == 1);
+    assert(pool.stats().allocations == 0);
+
+    std::cout << "[PASS] test_AcquireCopiesData\n";
+}
+
+void test_ReleasedBufferReused() {
+    BufferPool pool(1);
+    std::vector<uint8_t> frame(200, 0x10);
+
+    auto first = pool.acquire(frame.data(), frame.size());
+    const uint8_t* storage = first.data();
+    assert(pool.stats().allocations == 1);
+    pool.release(std::move(first));
+
+    // Same storage comes back, no new allocation for a same-size frame
+    auto second = pool.acquire(frame.data(), frame.size());
+    assert(second.data() == storage);
+    assert(pool.stats().acquired == 2);
+    assert(pool.stats().allocations == 1);
+
+    std::cout << "[PASS] test_ReleasedBufferReused\n";
+}
+
+void test_BestFitSelected() {
+    BufferPool pool(3);
+    std::vector<uint8_t> small(8), medium(64), large(512);
+
+    auto a = pool.acquire(large.data(), large.size());
+    auto b = pool.acquire(small.data(), small.size());
+    auto c = pool.acquire(medium.data(), medium.size());
+    const uint8_t* mediumStorage = c.data();
+    pool.release(std::move(a));
+    pool.release(std::move(b));
+    pool.release(std::move(c));
+
+    auto fit = pool.acquire(medium.data(), 40);
+    assert(fit.data() == mediumStorage);
+
+    // Nothing fits: the largest buffer is grown
+    std::vector<uint8_t> huge(1024);
+    auto grown = pool.acquire(huge.data(), huge.size());
+    assert(grown.size() == 1024);
+    assert(pool.stats().allocations == 4);
+
+    std::cout << "[PASS] test_BestFitSelected\n";
+}
+
+void test_PoolBounded() {
+    BufferPool pool(1);
+    const uint8_t byte = 0xF8;
+
+    auto a = pool.acquire(&byte, 1);
+    auto b = pool.acquire(&byte, 1);
+    pool.release(std::move(a));
+    pool.release(std::move(b));
+    assert(pool.available() == 1);
+
+    std::cout << "[PASS] test_PoolBounded\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "BufferPool Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_AcquireCopiesData();
+    test::test_ReleasedBufferReused();
+    test::test_BestFitSelected();
+    test::test_PoolBounded();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file test_CCFilter.cpp
+ * @brief Unit tests for CCFilter
+ *
+ * Checks hysteresis against one-step jitter, rate limiting with delivery
+ * of the final value (also with a poll clock older than the last
+ * delivery), drop-if-unchanged, and that unconfigured controllers
+ * pass untouched.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/CCFilter.hpp>
+
+using oc::hal::midi::CCFilter;
+using oc::hal::midi::CCPolicy;
+
+namespace test {
+
+struct Delivered {
+    uint8_t channel;
+    uint8_t controller;
+    uint8_t value;
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_NoPolicyPasses() {
+    CCFilter filter;
+    for (int i = 0; i < 10; ++i) {
+        const bool passed = filter.accept(0, 7, 64, 0);
+        assert(passed);
+    }
+    assert(filter.stats().passed == 0);
+    std::cout << "[PASS] test_NoPolicyPasses\n";
+}
+
+void test_HysteresisRejectsJitter() {
+    CCFilter filter;
+    CCPolicy policy;
+    policy.deadband = 1;
+    filter.setPolicy(2, 74, policy);
+
+    bool passed = filter.accept(2, 74, 64, 0);
+    assert(passed);
+    passed = filter.accept(2, 74, 65, 0);
+    assert(!passed);  // No direction yet: needs > 1
+    passed = filter.accept(2, 74, 63, 0);
+    assert(!passed);
+    passed = filter.accept(2, 74, 64, 0);
+    assert(!passed);  // Unchanged
+    passed = filter.accept(2, 74, 66, 0);
+    assert(passed);
+    passed = filter.accept(2, 74, 67, 0);
+    assert(passed);  // Same direction: any step
+    passed = filter.accept(2, 74, 66, 0);
+    assert(!passed);  // Reversal by 1
+    passed = filter.accept(2, 74, 67, 0);
+    assert(!passed);
+    passed = filter.accept(2, 74, 65, 0);
+    assert(passed);  // Reversal by 2
+    passed = filter.accept(2, 74, 127, 0);
+    assert(passed);
+    passed = filter.accept(2, 74, 126, 0);
+    assert(!passed);
+    passed = filter.accept(2, 74, 0, 0);
+    assert(passed);  // Ends always pass
+
+    // Other channels are unaffected
+    passed = filter.accept(3, 74, 64, 0);
+    assert(passed);
+    passed = filter.accept(3, 74, 65, 0);
+    assert(passed);
+    std::cout << "[PASS] test_HysteresisRejectsJitter\n";
+}
+
+void test_RateLimitDeliversFinalValue() {
+    CCFilter filter;
+    CCPolicy policy;
+    policy.maxRateHz = 100;  // 10 ms
+    filter.setPolicy(0, 1, policy);
+
+    std::vector<Delivered> delivered;
+    auto poll = [&](uint64_t nowUs) {
+        filter.poll(nowUs, [&](uint8_t channel, uint8_t controller, uint8_t value) {
+            delivered.push_back({channel, controller, value});
+        });
+    };
+
+    bool passed = filter.accept(0, 1, 10, 0);
+    assert(passed);
+    passed = filter.accept(0, 1, 11, 2000);
+    assert(!passed);
+    passed = filter.accept(0, 1, 12, 4000);
+    assert(!passed);
+    assert(filter.hasPending());
+    poll(9000);
+    assert(delivered.empty());
+    poll(10000);
+    assert(delivered.size() == 1 && delivered[0].controller == 1 && delivered[0].value == 12);
+    assert(!filter.hasPending());
+
+    passed = filter.accept(0, 1, 13, 15000);
+    assert(!passed);  // Interval restarts at the poll delivery
+    passed = filter.accept(0, 1, 14, 20000);
+    assert(passed);
+    assert(!filter.hasPending());
+    assert(filter.stats().held == 3);
+    std::cout << "[PASS] test_RateLimitDeliversFinalValue\n";
+}
+
+void test_ReturnToLastCancelsHeld() {
+    CCFilter filter;
+    CCPolicy policy;
+    policy.maxRateHz = 100;
+    policy.dropUnchanged = true;
+    filter.setPolicy(0, 1, policy);
+
+    bool passed = filter.accept(0, 1, 10, 0);
+    assert(passed);
+    passed = filter.accept(0, 1, 11, 1000);
+    assert(!passed);
+    passed = filter.accept(0, 1, 10, 2000);
+    assert(!passed);
+    assert(!filter.hasPending());
+    std::cout << "[PASS] test_ReturnToLastCancelsHeld\n";
+}
+
+void test_PollOlderThanDeliveryHolds() {
+    CCFilter filter;
+    CCPolicy policy;
+    policy.maxRateHz = 100;  // 10 ms
+    filter.setPolicy(0, 1, policy);
+
+    int emitted = 0;
+    auto poll = [&](uint64_t nowUs) {
+        filter.poll(nowUs, [&](uint8_t, uint8_t, uint8_t) { ++emitted; });
+    };
+
+    // The receive thread stamps after the poller read its clock.
+    bool passed = filter.accept(0, 1, 10, 50000);
+    assert(passed);
+    passed = filter.accept(0, 1, 20, 50000);
+    assert(!passed);
+    poll(49990);
+    assert(emitted == 0 && filter.hasPending());
+    passed = filter.accept(0, 1, 30, 49995);
+    assert(!passed);  // Older stamp: still inside the interval
+    poll(60000);
+    assert(emitted == 1 && !filter.hasPending());
+    std::cout << "[PASS] test_PollOlderThanDeliveryHolds\n";
+}
+
+void test_DropUnchangedAndClear() {
+    CCFilter filter;
+    CCPolicy policy;
+    policy.dropUnchanged = true;
+    filter.setPolicy(64, policy);  // Every channel
+
+    bool passed = filter.accept(9, 64, 127, 0);
+    assert(passed);
+    passed = filter.accept(9, 64, 127, 1);
+    assert(!passed);
+    passed = filter.accept(9, 64, 0, 2);
+    assert(passed);
+    filter.reset();
+    passed = filter.accept(9, 64, 0, 3);
+    assert(passed);
+    filter.setPolicy(64, CCPolicy{});
+    passed = filter.accept(9, 64, 0, 4);
+    assert(passed);
+    passed = filter.accept(9, 64, 0, 5);
+    assert(passed);
+    std::cout << "[PASS] test_DropUnchangedAndClear\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "CCFilter Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_NoPolicyPasses();
+    test::test_HysteresisRejectsJitter();
+    test::test_RateLimitDeliversFinalValue();
+    test::test_ReturnToLastCancelsHeld();
+    test::test_PollOlderThanDeliveryHolds();
+    test::test_DropUnchangedAndClear();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_CCHandlerTable.cpp
+ * @brief Unit tests for CCHandlerTable
+ *
+ * Checks targeted dispatch, the fallback, ANY_CHANNEL binding, unbinding
+ * and the receive-side wants() filter.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+
+#include <oc/hal/midi/CCHandlerTable.hpp>
+
+using oc::hal::midi::CCHandlerTable;
+
+namespace test {
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_TargetedDispatch() {
+    CCHandlerTable table;
+    assert(table.empty());
+
+    int cutoff = -1;
+    table.set(2, 74, [&](uint8_t channel, uint8_t controller, uint8_t value) {
+        assert(channel == 2 && controller == 74);
+        cutoff = value;
+    });
+    assert(!table.empty());
+    assert(table.wants(2, 74));
+    assert(!table.wants(2, 75) && !table.wants(3, 74));
+
+    bool handled = table.dispatch(2, 74, 99);
+    assert(handled && cutoff == 99);
+    handled = table.dispatch(3, 74, 1);
+    assert(!handled);
+    assert(cutoff == 99);
+    std::cout << "[PASS] test_TargetedDispatch\n";
+}
+
+void test_Fallback() {
+    CCHandlerTable table;
+    int mapped = 0;
+    int fallback = 0;
+    table.set(0, 1, [&](uint8_t, uint8_t, uint8_t) { ++mapped; });
+    table.setFallback([&](uint8_t, uint8_t, uint8_t) { ++fallback; });
+
+    assert(table.wants(5, 100));
+    table.dispatch(0, 1, 0);
+    table.dispatch(0, 2, 0);
+    table.dispatch(15, 127, 0);
+    assert(mapped == 1 && fallback == 2);
+
+    table.setFallback(nullptr);
+    assert(!table.wants(5, 100) && table.wants(0, 1));
+    std::cout << "[PASS] test_Fallback\n";
+}
+
+void test_AnyChannelAndUnbind() {
+    CCHandlerTable table;
+    int calls = 0;
+    table.set(CCHandlerTable::ANY_CHANNEL, 64, [&](uint8_t, uint8_t, uint8_t) { ++calls; });
+    for (uint8_t ch = 0; ch < 16; ++ch) {
+        assert(table.wants(ch, 64));
+        table.dispatch(ch, 64, 127);
+    }
+    assert(calls == 16);
+
+    table.set(7, 64, nullptr);
+    assert(!table.wants(7, 64) && table.wants(8, 64));
+    table.set(CCHandlerTable::ANY_CHANNEL, 64, nullptr);
+    assert(table.empty());
+    std::cout << "[PASS] test_AnyChannelAndUnbind\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "CCHandlerTable Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_TargetedDispatch();
+    test::test_Fallback();
+    test::test_AnyChannelAndUnbind();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+/**
+ * @file test_ClockThru.cpp
+ * @brief Unit tests for ClockDll and ClockThru
+ *
+ * Checks DLL period tracking and jitter reduction on synthetic tick times,
+ * division aligned to Start, transport forwarding, and the scheduling
+ * thread (smoothed mode, multiplication, pending ticks dropped on Stop).
+ */
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/ClockThru.hpp>
+
+using oc::hal::midi::ClockDll;
+using oc::hal::midi::ClockThru;
+using oc::hal::midi::ClockThruConfig;
+using oc::hal::midi::ClockThruMode;
+using oc::hal::midi::sleepUntilUs;
+using oc::hal::midi::steadyNowUs;
+
+namespace test {
+
+struct Capture {
+    std::mutex mutex;
+    std::vector<uint8_t> statuses;
+
+    ClockThru::Sink sink() {
+        return [this](const uint8_t* data, size_t length) {
+            assert(length == 1);
+            std::lock_guard<std::mutex> lock(mutex);
+            statuses.push_back(data[0]);
+        };
+    }
+
+    std::vector<uint8_t> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return statuses;
+    }
+};
+
+const uint8_t CLOCK = 0xF8;
+const uint8_t START = 0xFA;
+const uint8_t STOP = 0xFC;
+
+double stddev(const std::vector<double>& values) {
+    double mean = 0.0;
+    for (double v : values) mean += v;
+    mean /= values.size();
+    double sq = 0.0;
+    for (double v : values) sq += (v - mean) * (v - mean);
+    return std::sqrt(sq / values.size());
+}
+
+bool waitForTicks(const ClockThru& thru, uint64_t ticks) {
+    const uint64_t deadline = steadyNowUs() + 2000000;
+    while (thru.ticksSent() < ticks) {
+        if (steadyNowUs() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_DllTracksPeriod() {
+    ClockDll dll(1.0);
+    assert(!dll.locked());
+    assert(dll.periodUs() == 0.0);
+
+    uint64_t t = 1000000;
+    for (int i = 0; i < 100; ++i, t += 20833) dll.update(t);
+    assert(dll.locked());
+    assert(std::fabs(dll.periodUs() - 20833.0) < 1.0);
+    assert(std::fabs(dll.nextUs() - static_cast<double>(t)) < 2.0);
+    std::cout << "[PASS] test_DllTracksPeriod\n";
+}
+
+void test_DllReducesJitter() {
+    ClockDll dll(1.0);
+    const double period = 20833.0;
+    uint32_t seed = 12345;
+    std::vector<double> inputIntervals;
+    std::vector<double> filteredIntervals;
+    double lastInput = 0.0;
+    double lastFiltered = 0.0;
+
+    for (int i = 0; i < 600; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const double jitter = static_cast<double>(seed >> 20) / 4096.0 * 3000.0 - 1500.0;
+        const double input = 1000000.0 + i * period + jitter;
+        const double filtered = dll.update(static_cast<uint64_t>(input));
+        if (i >= 200) {  // After settling
+            inputIntervals.push_back(input - lastInput);
+            filteredIntervals.push_back(filtered - lastFiltered);
+        }
+        lastInput = input;
+        lastFiltered = filtered;
+    }
+
+    assert(std::fabs(dll.periodUs() - period) < period * 0.01);
+    assert(stddev(filteredIntervals) * 5.0 < stddev(inputIntervals));
+    std::cout << "[PASS] test_DllReducesJitter\n";
+}
+
+void test_DllRestartsAfterDropout() {
+    ClockDll dll(1.0);
+    uint64_t t = 0;
+    for (int i = 0; i < 10; ++i, t += 10000) dll.update(t);
+    assert(dll.locked());
+
+    // Clock paused for a second: restart instead of chasing the gap.
+    t += 1000000;
+    const double restarted = dll.update(t);
+    assert(restarted == static_cast<double>(t));
+    assert(!dll.locked());
+    dll.update(t + 5000);
+    assert(dll.locked());
+    assert(dll.periodUs() == 5000.0);
+    std::cout << "[PASS] test_DllRestartsAfterDropout\n";
+}
+
+void test_ImmediateDivideAlignedToStart() {
+    ClockThruConfig config;
+    config.divide = 3;
+    Capture out;
+    ClockThru thru(config, out.sink());
+
+    uint64_t t = 0;
+    for (int i = 0; i < 9; ++i) {
+        const bool handled = thru.handle(&CLOCK, 1, t += 10000);
+        assert(handled);
+    }
+    assert(thru.ticksSent() == 3);
+
+    thru.handle(&CLOCK, 1, t += 10000);  // Tick 9: sent
+    thru.handle(&CLOCK, 1, t += 10000);
+    thru.handle(&START, 1, t += 1000);
+    thru.handle(&CLOCK, 1, t += 9000);  // First tick after Start: sent
+    thru.handle(&CLOCK, 1, t += 10000);
+    assert(thru.ticksSent() == 5);
+    assert((out.snapshot() ==
+            std::vector<uint8_t>{CLOCK, CLOCK, CLOCK, CLOCK, START, CLOCK}));
+
+    const uint8_t note[3] = {0x90, 60, 100};
+    const bool handled = thru.handle(note, 3, t);
+    assert(!handled);
+    std::cout << "[PASS] test_ImmediateDivideAlignedToStart\n";
+}
+
+void test_TransportNotForwarded() {
+    ClockThruConfig config;
+    config.forwardTransport = false;
+    Capture out;
+    ClockThru thru(config, out.sink());
+
+    bool handled = thru.handle(&START, 1, 0);
+    assert(handled);
+    thru.handle(&CLOCK, 1, 10000);
+    handled = thru.handle(&STOP, 1, 20000);
+    assert(handled);
+    assert((out.snapshot() == std::vector<uint8_t>{CLOCK}));
+    std::cout << "[PASS] test_TransportNotForwarded\n";
+}
+
+void test_SmoothedSendsEveryTickInOrder() {
+    ClockThruConfig config;
+    config.mode = ClockThruMode::Smoothed;
+    config.latencyUs = 1000;
+    config.realtimePriority = false;
+    Capture out;
+    ClockThru thru(config, out.sink());
+
+    uint64_t t = steadyNowUs();
+    thru.handle(&START, 1, t);
+    for (int i = 0; i < 20; ++i) {
+        t += 2000;
+        sleepUntilUs(t);
+        thru.handle(&CLOCK, 1, t);
+    }
+    thru.handle(&STOP, 1, t);
+    const bool ticked = waitForTicks(thru, 20);
+    assert(ticked);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    const auto statuses = out.snapshot();
+    assert(statuses.size() == 22);
+    assert(statuses.front() == START);
+    assert(statuses.back() == STOP);
+    assert(std::fabs(thru.periodUs() - 2000.0) < 500.0);
+    assert(thru.jitter().count == 22);
+    std::cout << "[PASS] test_SmoothedSendsEveryTickInOrder\n";
+}
+
+void test_MultiplySpreadsTicks() {
+    ClockThruConfig config;
+    config.multiply = 4;
+    config.realtimePriority = false;
+    Capture out;
+    ClockThru thru(config, out.sink());
+
+    // First tick: no period yet, sent alone; then 4 per tick.
+    uint64_t t = steadyNowUs();
+    for (int i = 0; i < 6; ++i) {
+        sleepUntilUs(t);
+        thru.handle(&CLOCK, 1, t);  // Ideal times: keep the DLL locked
+        t += 10000;
+    }
+    const bool ticked = waitForTicks(thru, 21);
+    assert(ticked);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    assert(thru.ticksSent() == 21);
+
+    // Stop right after a tick: the extra ticks not yet due are dropped.
+    sleepUntilUs(t);
+    thru.handle(&CLOCK, 1, t);
+    thru.handle(&STOP, 1, t);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    assert(thru.ticksSent() == 22);
+    assert(out.snapshot().back() == STOP);
+    std::cout << "[PASS] test_MultiplySpreadsTicks\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "ClockThru Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_DllTracksPeriod();
+    test::test_DllReducesJitter();
+    test::test_DllRestartsAfterDropout();
+    test::test_ImmediateDivideAlignedToStart();
+    test::test_TransportNotForwarded();
+    test::test_SmoothedSendsEveryTickInOrder();
+    test::test_MultiplySpreadsTicks();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
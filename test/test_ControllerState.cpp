@@ -0,0 +1,163 @@
+/**
+ * @file test_ControllerState.cpp
+ * @brief Unit tests for ControllerState
+ *
+ * Checks state updates for each channel voice message, note release by
+ * All Notes Off / System Reset, version changes, and snapshot consistency
+ * against a concurrent writer.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/ControllerState.hpp>
+
+using oc::hal::midi::ChannelState;
+using oc::hal::midi::ControllerState;
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::decodeMidiEvent;
+
+namespace test {
+
+void apply(ControllerState& state, std::vector<uint8_t> bytes) {
+    MidiEvent event;
+    const bool decoded = decodeMidiEvent(bytes.data(), bytes.size(), event);
+    assert(decoded);
+    state.apply(event);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_Defaults() {
+    ControllerState state;
+    assert(state.cc(0, 7) == 0);
+    assert(state.pitchBend(5) == ControllerState::PITCH_BEND_CENTER);
+    assert(state.program(15) == ControllerState::NO_PROGRAM);
+    assert(!state.noteHeld(0, 60));
+    std::cout << "[PASS] test_Defaults\n";
+}
+
+void test_ChannelVoiceUpdates() {
+    ControllerState state;
+    apply(state, {0xB3, 74, 100});
+    apply(state, {0x93, 60, 90});
+    apply(state, {0xA3, 60, 33});
+    apply(state, {0xD3, 44});
+    apply(state, {0xE3, 0x00, 0x60});
+    apply(state, {0xC3, 12});
+
+    assert(state.cc(3, 74) == 100);
+    assert(state.cc(2, 74) == 0);
+    assert(state.noteVelocity(3, 60) == 90);
+    assert(state.polyPressure(3, 60) == 33);
+    assert(state.channelPressure(3) == 44);
+    assert(state.pitchBend(3) == 0x3000);
+    assert(state.program(3) == 12);
+
+    apply(state, {0x93, 60, 0});  // Note On velocity 0 releases
+    assert(!state.noteHeld(3, 60));
+    apply(state, {0x93, 61, 1});
+    apply(state, {0x83, 61, 64});
+    assert(!state.noteHeld(3, 61));
+    std::cout << "[PASS] test_ChannelVoiceUpdates\n";
+}
+
+void test_AllNotesOffAndReset() {
+    ControllerState state;
+    apply(state, {0x90, 60, 100});
+    apply(state, {0x90, 64, 100});
+    apply(state, {0x91, 60, 100});
+    apply(state, {0xB0, 123, 0});
+    assert(!state.noteHeld(0, 60) && !state.noteHeld(0, 64));
+    assert(state.noteHeld(1, 60));
+
+    apply(state, {0xB1, 1, 50});
+    apply(state, {0xFF});
+    assert(!state.noteHeld(1, 60));
+    assert(state.cc(1, 1) == 0);
+    std::cout << "[PASS] test_AllNotesOffAndReset\n";
+}
+
+void test_VersionAndSnapshot() {
+    ControllerState state;
+    const uint32_t v0 = state.version(2);
+    apply(state, {0xB2, 10, 64});
+    const uint32_t v1 = state.version(2);
+    assert(v1 != v0 && (v1 & 1u) == 0);
+    assert(state.version(3) == state.version(4));
+
+    // Realtime does not touch controller state
+    MidiEvent clock;
+    const uint8_t f8 = 0xF8;
+    decodeMidiEvent(&f8, 1, clock);
+    const bool changed = state.apply(clock);
+    assert(!changed);
+    assert(state.version(2) == v1);
+
+    ChannelState snapshot;
+    state.snapshot(2, snapshot);
+    assert(snapshot.cc[10] == 64);
+    assert(snapshot.pitchBend == ControllerState::PITCH_BEND_CENTER);
+    assert(snapshot.program == ControllerState::NO_PROGRAM);
+    std::cout << "[PASS] test_VersionAndSnapshot\n";
+}
+
+void test_SnapshotIsConsistent() {
+    ControllerState state;
+    std::atomic<bool> done{false};
+
+    // Every Note On is followed by All Notes Off: a consistent snapshot
+    // never shows more than one held note.
+    std::thread writer([&] {
+        MidiEvent on;
+        on.type = oc::hal::midi::MidiEventType::NoteOn;
+        on.data2 = 100;
+        MidiEvent off;
+        off.type = oc::hal::midi::MidiEventType::ControlChange;
+        off.data1 = 123;
+        for (uint32_t i = 0; i < 20000; ++i) {
+            on.data1 = static_cast<uint8_t>(i & 0x7F);
+            state.apply(on);
+            state.apply(off);
+            if ((i & 63) == 0) std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    ChannelState snapshot;
+    while (!done) {
+        state.snapshot(0, snapshot);
+        int held = 0;
+        for (int n = 0; n < 128; ++n) held += snapshot.noteHeld(static_cast<uint8_t>(n));
+        assert(held <= 1);
+        std::this_thread::yield();
+    }
+    writer.join();
+    std::cout << "[PASS] test_SnapshotIsConsistent\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "ControllerState Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_Defaults();
+    test::test_ChannelVoiceUpdates();
+    test::test_AllNotesOffAndReset();
+    test::test_VersionAndSnapshot();
+    test::test_SnapshotIsConsistent();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file test_InboundQueues.cpp
+ * @brief Unit tests for InboundQueues
+ *
+ * Checks classification, priority-ordered draining with per-class order
+ * kept, both drop policies, force() past capacity, counters and latency,
+ * the fallback for an invalid drain order, and the spill area: bursts past
+ * the ring, reserve growth and shrink-back, and a bounded spill while a
+ * DropOldest queue is saturated.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/InboundQueues.hpp>
+
+using oc::hal::midi::InboundQueueConfig;
+using oc::hal::midi::InboundQueues;
+using oc::hal::midi::MidiTrafficClass;
+using oc::hal::midi::QueueDropPolicy;
+using oc::hal::midi::midiTrafficClass;
+
+namespace test {
+
+using Queues = InboundQueues<int>;
+
+std::vector<int> drainAll(Queues& queues) {
+    std::vector<int> out;
+    queues.drain(out);
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_Classification() {
+    assert(midiTrafficClass(0x90) == MidiTrafficClass::ChannelVoice);
+    assert(midiTrafficClass(0xEF) == MidiTrafficClass::ChannelVoice);
+    assert(midiTrafficClass(0xF0) == MidiTrafficClass::SysEx);
+    assert(midiTrafficClass(0xF7) == MidiTrafficClass::SysEx);
+    assert(midiTrafficClass(0xF1) == MidiTrafficClass::Realtime);
+    assert(midiTrafficClass(0xF8) == MidiTrafficClass::Realtime);
+    assert(midiTrafficClass(0xFF) == MidiTrafficClass::Realtime);
+    std::cout << "[PASS] test_Classification\n";
+}
+
+void test_DrainsByPriorityKeepingClassOrder() {
+    Queues queues(InboundQueueConfig{});
+    // Arrival: SysEx 1, note 2, clock 3, SysEx 4, note 5, clock 6
+    queues.push(MidiTrafficClass::SysEx, 1);
+    queues.push(MidiTrafficClass::ChannelVoice, 2);
+    queues.push(MidiTrafficClass::Realtime, 3);
+    queues.push(MidiTrafficClass::SysEx, 4);
+    queues.push(MidiTrafficClass::ChannelVoice, 5);
+    queues.push(MidiTrafficClass::Realtime, 6);
+    auto drained = drainAll(queues);
+    assert((drained == std::vector<int>{3, 6, 2, 5, 1, 4}));
+    drained = drainAll(queues);
+    assert(drained.empty());
+
+    InboundQueueConfig config;
+    config.order = {MidiTrafficClass::SysEx, MidiTrafficClass::Realtime,
+                    MidiTrafficClass::ChannelVoice};
+    Queues custom(config);
+    custom.push(MidiTrafficClass::ChannelVoice, 1);
+    custom.push(MidiTrafficClass::Realtime, 2);
+    custom.push(MidiTrafficClass::SysEx, 3);
+    drained = drainAll(custom);
+    assert((drained == std::vector<int>{3, 2, 1}));
+    std::cout << "[PASS] test_DrainsByPriorityKeepingClassOrder\n";
+}
+
+void test_DropPolicies() {
+    InboundQueueConfig config;
+    config.channelVoice = {3, QueueDropPolicy::DropNewest};
+    config.realtime = {3, QueueDropPolicy::DropOldest};
+    Queues queues(config);
+
+    for (int i = 1; i <= 5; ++i) {
+        const bool accepted = queues.push(MidiTrafficClass::ChannelVoice, 10 + i);
+        assert(accepted == (i <= 3));
+        const bool pushed = queues.push(MidiTrafficClass::Realtime, int{i});
+        assert(pushed);
+    }
+    auto drained = drainAll(queues);
+    assert((drained == std::vector<int>{3, 4, 5, 11, 12, 13}));
+
+    const auto voice = queues.stats(MidiTrafficClass::ChannelVoice);
+    assert(voice.queued == 3 && voice.dropped == 2 && voice.highWater == 3);
+    const auto realtime = queues.stats(MidiTrafficClass::Realtime);
+    assert(realtime.queued == 5 && realtime.dropped == 2 && realtime.highWater == 3);
+
+    // Wrapped ring keeps working after a drain.
+    for (int i = 0; i < 3; ++i) queues.push(MidiTrafficClass::Realtime, 20 + i);
+    drained = drainAll(queues);
+    assert((drained == std::vector<int>{20, 21, 22}));
+    std::cout << "[PASS] test_DropPolicies\n";
+}
+
+void test_ForcePastCapacity() {
+    InboundQueueConfig config;
+    config.sysex = {2};
+    Queues queues(config);
+    queues.push(MidiTrafficClass::SysEx, 1);
+    queues.push(MidiTrafficClass::SysEx, 2);
+    bool accepted = queues.push(MidiTrafficClass::SysEx, 3);
+    assert(!accepted);
+    queues.force(MidiTrafficClass::SysEx, 4);  // End marker
+    queues.force(MidiTrafficClass::SysEx, 5);
+    const auto drained = drainAll(queues);
+    assert((drained == std::vector<int>{1, 2, 4, 5}));
+
+    // Capacity is unchanged by the growth.
+    queues.push(MidiTrafficClass::SysEx, 6);
+    queues.push(MidiTrafficClass::SysEx, 7);
+    accepted = queues.push(MidiTrafficClass::SysEx, 8);
+    assert(!accepted);
+    std::cout << "[PASS] test_ForcePastCapacity\n";
+}
+
+void test_LatencyPerClass() {
+    Queues queues(InboundQueueConfig{});
+    queues.recordLatency(MidiTrafficClass::ChannelVoice, 100);
+    queues.recordLatency(MidiTrafficClass::ChannelVoice, 300);
+    queues.recordLatency(MidiTrafficClass::SysEx, 5000);
+
+    const auto voice = queues.stats(MidiTrafficClass::ChannelVoice).latency;
+    assert(voice.count == 2 && voice.meanUs == 200.0);
+    assert(voice.minUs == 100 && voice.maxUs == 300);
+    assert(queues.stats(MidiTrafficClass::SysEx).latency.maxUs == 5000);
+    assert(queues.stats(MidiTrafficClass::Realtime).latency.count == 0);
+    std::cout << "[PASS] test_LatencyPerClass\n";
+}
+
+void test_BurstSpillsPastRing() {
+    InboundQueueConfig config;
+    config.channelVoice = {4096, QueueDropPolicy::DropNewest, 64};
+    Queues queues(config);
+
+    // Preset recall: 2000 CCs between two updates.
+    size_t accepted = 0;
+    for (int i = 0; i < 2000; ++i) accepted += queues.push(MidiTrafficClass::ChannelVoice, int{i});
+    assert(accepted == 2000);
+    const std::vector<int> out = drainAll(queues);
+    assert(out.size() == 2000);
+    for (int i = 0; i < 2000; ++i) assert(out[i] == i);
+
+    const auto stats = queues.stats(MidiTrafficClass::ChannelVoice);
+    assert(stats.queued == 2000 && stats.dropped == 0);
+    assert(stats.spilled == 2000 - 64 && stats.highWater == 2000);
+    // Reserve grown ahead of the next burst of that size.
+    assert(stats.spillReserve >= 2000 - 64);
+
+    // Order is kept across ring and spill when both wrap and drop.
+    config.realtime = {6, QueueDropPolicy::DropOldest, 2};
+    Queues small(config);
+    for (int i = 1; i <= 9; ++i) small.push(MidiTrafficClass::Realtime, int{i});
+    auto drained = drainAll(small);
+    assert((drained == std::vector<int>{4, 5, 6, 7, 8, 9}));
+    small.push(MidiTrafficClass::Realtime, 10);
+    drained = drainAll(small);
+    assert((drained == std::vector<int>{10}));
+    std::cout << "[PASS] test_BurstSpillsPastRing\n";
+}
+
+void test_SaturatedDropOldestStaysBounded() {
+    InboundQueueConfig config;
+    config.realtime = {8, QueueDropPolicy::DropOldest, 2};
+    Queues queues(config);
+
+    // No drain for a long time: only the newest 8 are kept, in order, and
+    // the spill (live items plus those not yet compacted) stays within
+    // twice the capacity.
+    for (int i = 0; i < 10000; ++i) queues.push(MidiTrafficClass::Realtime, int{i});
+    assert(queues.stats(MidiTrafficClass::Realtime).spillReserve <= 2 * 8);
+    const std::vector<int> out = drainAll(queues);
+    assert(out.size() == 8);
+    for (int i = 0; i < 8; ++i) assert(out[i] == 10000 - 8 + i);
+    std::cout << "[PASS] test_SaturatedDropOldestStaysBounded\n";
+}
+
+void test_SpillShrinksBack() {
+    InboundQueueConfig config;
+    config.channelVoice = {4096, QueueDropPolicy::DropNewest, 16};
+    config.spillShrinkAfter = 4;
+    Queues queues(config);
+    auto reserve = [&] { return queues.stats(MidiTrafficClass::ChannelVoice).spillReserve; };
+
+    for (int i = 0; i < 1000; ++i) queues.push(MidiTrafficClass::ChannelVoice, int{i});
+    drainAll(queues);
+    const size_t grown = reserve();
+    assert(grown >= 1000 - 16);
+
+    // Steady traffic fits the ring: the reserve halves every 4 quiet drains.
+    size_t previous = grown;
+    for (int drains = 0; drains < 64 && reserve() > 0; ++drains) {
+        queues.push(MidiTrafficClass::ChannelVoice, 1);
+        drainAll(queues);
+        assert(reserve() <= previous);
+        previous = reserve();
+    }
+    assert(reserve() == 0);
+
+    // A burst in between quiet drains postpones the shrink.
+    for (int i = 0; i < 100; ++i) queues.push(MidiTrafficClass::ChannelVoice, int{i});
+    drainAll(queues);
+    const size_t regrown = reserve();
+    assert(regrown >= 100 - 16);
+    for (int drains = 0; drains < 3; ++drains) drainAll(queues);
+    for (int i = 0; i < 80; ++i) queues.push(MidiTrafficClass::ChannelVoice, int{i});
+    drainAll(queues);
+    for (int drains = 0; drains < 3; ++drains) drainAll(queues);
+    assert(reserve() == regrown);
+    std::cout << "[PASS] test_SpillShrinksBack\n";
+}
+
+void test_InvalidOrderFallsBack() {
+    InboundQueueConfig config;
+    config.order = {MidiTrafficClass::SysEx, MidiTrafficClass::SysEx,
+                    MidiTrafficClass::Realtime};
+    Queues queues(config);
+    queues.push(MidiTrafficClass::ChannelVoice, 1);
+    queues.push(MidiTrafficClass::SysEx, 2);
+    queues.push(MidiTrafficClass::Realtime, 3);
+    const auto drained = drainAll(queues);
+    assert((drained == std::vector<int>{3, 1, 2}));
+    std::cout << "[PASS] test_InvalidOrderFallsBack\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "InboundQueues Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_Classification();
+    test::test_DrainsByPriorityKeepingClassOrder();
+    test::test_DropPolicies();
+    test::test_ForcePastCapacity();
+    test::test_LatencyPerClass();
+    test::test_InvalidOrderFallsBack();
+    test::test_BurstSpillsPastRing();
+    test::test_SaturatedDropOldestStaysBounded();
+    test::test_SpillShrinksBack();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
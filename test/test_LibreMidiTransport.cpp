@@ -2,18 +2,32 @@
  * @file test_LibreMidiTransport.cpp
  * @brief Unit tests for LibreMidiTransport
  *
- * Tests the LibreMidiTransport class message parsing and callback logic.
+ * Runs the real transport against in-process test doubles of libremidi
+ * and the framework (test/fake): input goes through framing, filtering,
+ * the inbound queues and update() dispatch; output is captured.
  * Note: Full MIDI I/O tests require real MIDI ports (loopMIDI on Windows).
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <functional>
 #include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
-// Minimal mock for testing processMessage logic
-// This simulates the callback behavior without needing real MIDI
+#include <libremidi/libremidi.hpp>
+#include <oc/hal/midi/LibreMidiTransport.hpp>
+
+using oc::hal::midi::CCPolicy;
+using oc::hal::midi::LibreMidiConfig;
+using oc::hal::midi::LibreMidiTransport;
+using oc::hal::midi::MidiTrafficClass;
+using oc::hal::midi::ParameterEvent;
+using oc::hal::midi::UmpPacket;
 
 namespace test {
 
@@ -39,6 +53,12 @@ public:
     int startCount = 0;
     int stopCount = 0;
     int continueCount = 0;
+    std::vector<int16_t> pitchBends;
+    std::vector<uint8_t> programChanges;
+    std::vector<ReceivedNote> polyPressures;
+    std::vector<uint16_t> songPositions;
+    std::vector<uint8_t> mtcPieces;
+    int tuneRequestCount = 0;
 
     void onCC(uint8_t ch, uint8_t cc, uint8_t val) {
         ccMessages.push_back({ch, cc, val});
@@ -73,66 +93,75 @@ public:
         startCount = 0;
         stopCount = 0;
         continueCount = 0;
+        pitchBends.clear();
+        programChanges.clear();
+        polyPressures.clear();
+        songPositions.clear();
+        mtcPieces.clear();
+        tuneRequestCount = 0;
     }
 };
 
-// Test message parsing logic (mirrors LibreMidiTransport::processMessage)
-void processTestMessage(const uint8_t* data, size_t length, MockMidiReceiver& receiver) {
-    if (length == 0) return;
-
-    uint8_t status = data[0];
-
-    switch (status) {
-        case 0xF8:
-            receiver.onClock();
-            return;
-        case 0xFA:
-            receiver.onStart();
-            return;
-        case 0xFB:
-            receiver.onContinue();
-            return;
-        case 0xFC:
-            receiver.onStop();
-            return;
-        default:
-            break;
+// Transport on the fake backend (test/fake/libremidi), with every
+// callback recorded in @p receiver
+class Harness {
+public:
+    explicit Harness(MockMidiReceiver& receiver, const LibreMidiConfig& config = {})
+        : transport(config) {
+        libremidi::fake::reset();
+        transport.setOnCC([&receiver](uint8_t ch, uint8_t cc, uint8_t val) {
+            receiver.onCC(ch, cc, val);
+        });
+        transport.setOnNoteOn([&receiver](uint8_t ch, uint8_t note, uint8_t vel) {
+            receiver.onNoteOn(ch, note, vel);
+        });
+        transport.setOnNoteOff([&receiver](uint8_t ch, uint8_t note, uint8_t vel) {
+            receiver.onNoteOff(ch, note, vel);
+        });
+        transport.setOnSysEx([&receiver](const uint8_t* data, size_t len) {
+            receiver.onSysEx(data, len);
+        });
+        transport.setOnClock([&receiver](uint64_t) { receiver.onClock(); });
+        transport.setOnStart([&receiver] { receiver.onStart(); });
+        transport.setOnStop([&receiver] { receiver.onStop(); });
+        transport.setOnContinue([&receiver] { receiver.onContinue(); });
+        transport.setOnPitchBend([&receiver](uint8_t, int16_t value) {
+            receiver.pitchBends.push_back(value);
+        });
+        transport.setOnProgramChange([&receiver](uint8_t, uint8_t program) {
+            receiver.programChanges.push_back(program);
+        });
+        transport.setOnPolyPressure([&receiver](uint8_t ch, uint8_t note, uint8_t pressure) {
+            receiver.polyPressures.push_back({ch, note, pressure});
+        });
+        transport.setOnSongPosition([&receiver](uint16_t beats) {
+            receiver.songPositions.push_back(beats);
+        });
+        transport.setOnMtcQuarterFrame([&receiver](uint8_t piece, uint8_t) {
+            receiver.mtcPieces.push_back(piece);
+        });
+        transport.setOnTuneRequest([&receiver] { receiver.tuneRequestCount++; });
     }
 
-    uint8_t type = status & 0xF0;
-    uint8_t channel = status & 0x0F;
-
-    switch (type) {
-        case 0x80: // Note Off
-            if (length >= 3) {
-                receiver.onNoteOff(channel, data[1], data[2]);
-            }
-            break;
-
-        case 0x90: // Note On
-            if (length >= 3) {
-                if (data[2] == 0) {
-                    // Velocity 0 = Note Off
-                    receiver.onNoteOff(channel, data[1], 0);
-                } else {
-                    receiver.onNoteOn(channel, data[1], data[2]);
-                }
-            }
-            break;
-
-        case 0xB0: // Control Change
-            if (length >= 3) {
-                receiver.onCC(channel, data[1], data[2]);
-            }
-            break;
-
-        case 0xF0: // System Exclusive
-            receiver.onSysEx(data, length);
-            break;
-
-        default:
-            break;
+    /// Opens the fake ports (no-op once done); routes must be added before
+    void init() {
+        const bool ok = transport.init().isOk();
+        assert(ok);
     }
+
+    /// One backend callback on this thread, then one update()
+    void feed(const uint8_t* data, size_t length) {
+        init();
+        if (length > 0) libremidi::fake::receive(std::vector<uint8_t>(data, data + length));
+        transport.update();
+    }
+
+    LibreMidiTransport transport;
+};
+
+void processTestMessage(const uint8_t* data, size_t length, MockMidiReceiver& receiver) {
+    Harness input(receiver);
+    input.feed(data, length);
 }
 
 // ═══════════════════════════════════════════════════════════════════
@@ -309,6 +338,359 @@ void test_RealtimeStop() {
     std::cout << "[PASS] test_RealtimeStop\n";
 }
 
+void test_RunningStatusAcrossCallbacks() {
+    MockMidiReceiver receiver;
+    Harness input(receiver);
+
+    // Backend delivers running-status CCs in separate callbacks
+    uint8_t first[] = {0xB2, 1, 10};
+    uint8_t second[] = {1, 11};
+    input.feed(first, sizeof(first));
+    input.feed(second, sizeof(second));
+
+    assert(receiver.ccMessages.size() == 2);
+    assert(receiver.ccMessages[1].channel == 2);
+    assert(receiver.ccMessages[1].value == 11);
+
+    std::cout << "[PASS] test_RunningStatusAcrossCallbacks\n";
+}
+
+void test_SysExSplitAcrossCallbacks() {
+    MockMidiReceiver receiver;
+    Harness input(receiver);
+
+    uint8_t head[] = {0xF0, 0x7E, 0x00};
+    uint8_t tail[] = {0xF8, 0x06, 0x01, 0xF7};
+    input.feed(head, sizeof(head));
+    assert(receiver.sysexMessages.empty());
+    input.feed(tail, sizeof(tail));
+
+    assert(receiver.clockCount == 1);
+    assert(receiver.sysexMessages.size() == 1);
+    assert(receiver.sysexMessages[0].size() == 6);
+
+    std::cout << "[PASS] test_SysExSplitAcrossCallbacks\n";
+}
+
+void test_ExtendedChannelMessages() {
+    MockMidiReceiver receiver;
+    Harness input(receiver);
+
+    // Pitch bend centre / max, program change, poly aftertouch
+    uint8_t msg[] = {0xE0, 0x00, 0x40, 0x7F, 0x7F, 0xC3, 12, 0xA1, 60, 90};
+    input.feed(msg, sizeof(msg));
+
+    assert((receiver.pitchBends == std::vector<int16_t>{0, 8191}));
+    assert(receiver.programChanges.size() == 1 && receiver.programChanges[0] == 12);
+    assert(receiver.polyPressures.size() == 1);
+    assert(receiver.polyPressures[0].channel == 1);
+    assert(receiver.polyPressures[0].velocity == 90);
+
+    std::cout << "[PASS] test_ExtendedChannelMessages\n";
+}
+
+void test_SystemCommonMessages() {
+    MockMidiReceiver receiver;
+    Harness input(receiver);
+
+    uint8_t msg[] = {0xF2, 0x10, 0x01, 0xF1, 0x35, 0xF1, 0x42, 0xF6};
+    input.feed(msg, sizeof(msg));
+
+    assert(receiver.songPositions.size() == 1 && receiver.songPositions[0] == 0x90);
+    assert((receiver.mtcPieces == std::vector<uint8_t>{3, 4}));
+    assert(receiver.tuneRequestCount == 1);
+
+    std::cout << "[PASS] test_SystemCommonMessages\n";
+}
+
+void test_LargeSysExDeliveredWhole() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.sysexBufferSize = 1024;
+    Harness input(receiver, config);
+
+    // 200 KB dump (firmware, samples) across 1 KB callbacks: no default limit.
+    std::vector<uint8_t> dump(200000, 0x55);
+    dump.front() = 0xF0;
+    dump.back() = 0xF7;
+    for (size_t i = 0; i < dump.size(); i += 1000) {
+        input.feed(dump.data() + i, std::min<size_t>(1000, dump.size() - i));
+    }
+    assert(receiver.sysexMessages.size() == 1);
+    assert(receiver.sysexMessages[0] == dump);
+
+    // Small SysEx still use the preallocated buffer.
+    uint8_t small[] = {0xF0, 0x7E, 0x01, 0xF7};
+    input.feed(small, sizeof(small));
+    assert(receiver.sysexMessages.size() == 2 && receiver.sysexMessages[1].size() == 4);
+
+    std::cout << "[PASS] test_LargeSysExDeliveredWhole\n";
+}
+
+void test_MaxSysExSizeIsOptIn() {
+    for (size_t buffer : {size_t{512}, size_t{4096}}) {
+        MockMidiReceiver receiver;
+        LibreMidiConfig config;
+        config.maxSysExSize = 1000;
+        config.sysexBufferSize = buffer;
+        Harness input(receiver, config);
+
+        std::vector<uint8_t> sysex(2000, 0x11);
+        sysex.front() = 0xF0;
+        sysex.back() = 0xF7;
+        input.feed(sysex.data(), sysex.size());
+        assert(receiver.sysexMessages.empty());
+
+        sysex.resize(1000);
+        sysex.back() = 0xF7;
+        input.feed(sysex.data(), sysex.size());
+        assert(receiver.sysexMessages.size() == 1 && receiver.sysexMessages[0] == sysex);
+    }
+    std::cout << "[PASS] test_MaxSysExSizeIsOptIn\n";
+}
+
+void test_FilterAndQueuePath() {
+    MockMidiReceiver receiver;
+    Harness input(receiver);
+    input.init();
+    CCPolicy unchanged;
+    unchanged.dropUnchanged = true;
+    input.transport.setCCPolicy(0, 7, unchanged);
+
+    // Filtered on the receive thread: the repeated value is never queued.
+    uint8_t volume[] = {0xB0, 7, 100, 7, 100, 7, 101};
+    input.feed(volume, sizeof(volume));
+    assert(receiver.ccMessages.size() == 2);
+    assert(receiver.ccMessages[1].value == 101);
+    assert(input.transport.ccFilterStats().dropped == 1);
+    assert(input.transport.inboundQueueStats(MidiTrafficClass::ChannelVoice).queued == 2);
+
+    // Nobody handles aftertouch: dropped before queuing.
+    uint8_t pressure[] = {0xD0, 40};
+    input.feed(pressure, sizeof(pressure));
+    assert(input.transport.inboundQueueStats(MidiTrafficClass::ChannelVoice).queued == 2);
+
+    // Realtime is drained first within one update().
+    std::vector<int> order;
+    input.transport.setOnNoteOn([&](uint8_t, uint8_t, uint8_t) { order.push_back(1); });
+    input.transport.setOnClock([&](uint64_t) { order.push_back(2); });
+    uint8_t mixed[] = {0x90, 60, 100, 0xF8};
+    input.feed(mixed, sizeof(mixed));
+    assert((order == std::vector<int>{2, 1}));
+    assert(input.transport.inboundQueueStats(MidiTrafficClass::Realtime).queued == 1);
+
+    std::cout << "[PASS] test_FilterAndQueuePath\n";
+}
+
+void test_ChunkedSysExFragments() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.sysexChunkSize = 100;
+    Harness input(receiver, config);
+    std::vector<uint8_t> joined;
+    std::vector<oc::hal::midi::SysExChunkPhase> phases;
+    input.transport.setOnSysExChunk(
+        [&](oc::hal::midi::SysExChunkPhase phase, const uint8_t* data, size_t length) {
+            phases.push_back(phase);
+            joined.insert(joined.end(), data, data + length);
+        });
+
+    std::vector<uint8_t> dump(250, 0x22);
+    dump.front() = 0xF0;
+    dump.back() = 0xF7;
+    // Twice: the second dump reuses the recycled fragment buffers.
+    for (int round = 0; round < 2; ++round) {
+        joined.clear();
+        phases.clear();
+        input.feed(dump.data(), dump.size());
+        assert(joined == dump);
+        assert(phases.size() == 3);
+        assert(phases.front() == oc::hal::midi::SysExChunkPhase::Begin);
+        assert(phases.back() == oc::hal::midi::SysExChunkPhase::End);
+    }
+    assert(receiver.sysexMessages.empty());
+
+    std::cout << "[PASS] test_ChunkedSysExFragments\n";
+}
+
+void test_SendOrderUnderContention() {
+    MockMidiReceiver receiver;
+    Harness output(receiver);
+    output.init();
+
+    // Another thread keeps the output busy (player, clock thru...).
+    std::atomic<bool> running{true};
+    std::thread other([&] {
+        const uint8_t clock = 0xF8;
+        while (running.load()) output.transport.sendMessage(&clock, 1);
+    });
+
+    const uint8_t sysex[] = {0xF0, 0x7D, 0x10, 0xF7};
+    for (uint8_t i = 0; i < 100; ++i) {
+        output.transport.sendSysEx(sysex, sizeof(sysex));
+        output.transport.sendCC(0, 20, i);
+    }
+    running = false;
+    other.join();
+
+    // Each SysEx leaves before the CC sent after it.
+    std::vector<uint8_t> kinds;
+    for (const auto& msg : libremidi::fake::sent()) {
+        if (msg[0] != 0xF8) kinds.push_back(msg[0]);
+    }
+    assert(kinds.size() == 200);
+    for (size_t i = 0; i < kinds.size(); i += 2) {
+        assert(kinds[i] == 0xF0 && kinds[i + 1] == 0xB0);
+    }
+
+    std::cout << "[PASS] test_SendOrderUnderContention\n";
+}
+
+void test_SysExDedupIgnoresUnsentFrames() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.suppressRedundantSysEx = true;
+    Harness output(receiver, config);
+    output.init();
+
+    const uint8_t frame[] = {0xF0, 0x7D, 0x01, 0x02, 0xF7};
+    libremidi::fake::setOutputConnected(false);
+    output.transport.sendSysEx(frame, sizeof(frame));
+    assert(libremidi::fake::sent().empty());
+
+    // Back online: the frame was never sent, so it is not suppressed.
+    libremidi::fake::setOutputConnected(true);
+    output.transport.sendSysEx(frame, sizeof(frame));
+    output.transport.sendSysEx(frame, sizeof(frame));
+    assert(libremidi::fake::sent().size() == 1);
+    assert(output.transport.sysExDedupStats().suppressed == 1);
+
+    std::cout << "[PASS] test_SysExDedupIgnoresUnsentFrames\n";
+}
+
+void test_RawCCUpdatesParameterCache() {
+    MockMidiReceiver receiver;
+    Harness output(receiver);
+    output.init();
+
+    output.transport.sendNRPN(0, 300, 1000);
+    assert(libremidi::fake::sent().size() == 4);
+    output.transport.sendNRPN(0, 300, 1001);
+    assert(libremidi::fake::sent().size() == 5);  // LSB only
+
+    // Selection changed behind the encoder's back: next write is full.
+    const uint8_t select[] = {0xB0, 101, 0};
+    output.transport.sendMessage(select, sizeof(select));
+    output.transport.sendNRPN(0, 300, 1002);
+    const auto sent = libremidi::fake::sent();
+    assert(sent.size() == 6 + 4);
+    assert(sent[6][1] == 99 && sent[7][1] == 98 && sent[9][1] == 38);
+
+    // A UMP translated for this byte port goes the same way.
+    UmpPacket umpSelect;
+    umpSelect.words[0] = 0x20B0'6500;  // CC 101, value 0
+    output.transport.sendUmp(umpSelect);
+    output.transport.sendNRPN(0, 300, 1003);
+    assert(libremidi::fake::sent().size() == 10 + 1 + 4);
+
+    std::cout << "[PASS] test_RawCCUpdatesParameterCache\n";
+}
+
+void test_DispatchLanesKeepOrder() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.dispatchThreads = 2;
+    config.assembleParameters = true;
+    Harness input(receiver, config);
+
+    std::mutex mutex;
+    std::vector<std::string> log;
+    auto record = [&](std::string entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        log.push_back(std::move(entry));
+    };
+    input.transport.setOnNoteOn([&](uint8_t ch, uint8_t, uint8_t) {
+        record("note" + std::to_string(ch));
+    });
+    input.transport.setOnParameter([&](const ParameterEvent&) { record("nrpn"); });
+    input.transport.setOnSysEx([&](const uint8_t*, size_t) { record("sysex"); });
+    input.init();
+
+    libremidi::fake::receive({0x90, 60, 100});
+    for (uint8_t cc : {99, 98, 6, 38}) libremidi::fake::receive({0xB0, cc, 1});
+    libremidi::fake::receive({0x91, 60, 100});
+    libremidi::fake::receive({0xF0, 0x7D, 0x01, 0xF7});
+    input.transport.update();
+
+    // The parameter (same queue as notes) waits for the lanes before it
+    // and is not overtaken by the lane posted after it.
+    assert(log.size() == 4);
+    const auto at = [&](const char* entry) {
+        return std::find(log.begin(), log.end(), entry) - log.begin();
+    };
+    assert(at("note0") < at("nrpn") && at("nrpn") < at("note1"));
+
+    std::cout << "[PASS] test_DispatchLanesKeepOrder\n";
+}
+
+void test_UmpInputUsesQueues() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.useUmp = true;
+    Harness input(receiver, config);
+    input.init();
+
+    const uint32_t noteOn = 0x20903C64;  // MIDI 1.0 channel voice, group 0
+    libremidi::fake::receiveUmp(&noteOn, 1);
+    input.transport.update();
+
+    assert(receiver.noteOnMessages.size() == 1);
+    assert(receiver.noteOnMessages[0].note == 60 && receiver.noteOnMessages[0].velocity == 100);
+    assert(input.transport.inboundQueueStats(MidiTrafficClass::ChannelVoice).queued == 1);
+
+    std::cout << "[PASS] test_UmpInputUsesQueues\n";
+}
+
+void test_UmpRingDropsCounted() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.useUmp = true;
+    config.umpQueueCapacity = 4;
+    Harness input(receiver, config);
+    input.init();
+
+    const uint32_t noteOn = 0x20903C64;
+    for (int i = 0; i < 6; ++i) libremidi::fake::receiveUmp(&noteOn, 1);
+    assert(input.transport.umpPacketsDropped() == 2);
+    input.transport.update();
+    assert(receiver.noteOnMessages.size() == 4);
+
+    std::cout << "[PASS] test_UmpRingDropsCounted\n";
+}
+
+void test_ClockThruNotSentTwice() {
+    MockMidiReceiver receiver;
+    LibreMidiConfig config;
+    config.forwardClock = true;
+    Harness input(receiver, config);
+    const bool added = input.transport.addThruRoute(oc::hal::midi::MidiThru::Route{});
+    assert(added);
+
+    const uint8_t tick = 0xF8;
+    const uint8_t start = 0xFA;
+    const uint8_t note[] = {0x90, 60, 100};
+    input.feed(&start, 1);
+    input.feed(&tick, 1);
+    input.feed(note, sizeof(note));
+
+    // Clock thru sends the realtime bytes, the route everything else.
+    const auto sent = libremidi::fake::sent();
+    assert(sent.size() == 3);
+    assert(sent[0][0] == 0xFA && sent[1][0] == 0xF8 && sent[2][0] == 0x90);
+
+    std::cout << "[PASS] test_ClockThruNotSentTwice\n";
+}
+
 } // namespace test
 
 int main() {
@@ -328,6 +710,21 @@ int main() {
     test::test_RealtimeStart();
     test::test_RealtimeContinue();
     test::test_RealtimeStop();
+    test::test_RunningStatusAcrossCallbacks();
+    test::test_SysExSplitAcrossCallbacks();
+    test::test_ExtendedChannelMessages();
+    test::test_SystemCommonMessages();
+    test::test_LargeSysExDeliveredWhole();
+    test::test_MaxSysExSizeIsOptIn();
+    test::test_FilterAndQueuePath();
+    test::test_ChunkedSysExFragments();
+    test::test_SendOrderUnderContention();
+    test::test_SysExDedupIgnoresUnsentFrames();
+    test::test_RawCCUpdatesParameterCache();
+    test::test_DispatchLanesKeepOrder();
+    test::test_UmpInputUsesQueues();
+    test::test_UmpRingDropsCounted();
+    test::test_ClockThruNotSentTwice();
 
     std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
     std::cout << "All tests passed!\n";
@@ -0,0 +1,150 @@
+/**
+ * @file test_MidiEvent.cpp
+ * @brief Unit tests for decodeMidiEvent
+ *
+ * Covers every channel voice, system common and realtime message, the
+ * Note On velocity 0 convention and rejection of truncated input.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiEvent.hpp>
+
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::decodeMidiEvent;
+using oc::hal::midi::midiEventBit;
+
+namespace test {
+
+MidiEvent decode(const std::vector<uint8_t>& bytes) {
+    MidiEvent event;
+    const bool decoded = decodeMidiEvent(bytes.data(), bytes.size(), event);
+    assert(decoded);
+    return event;
+}
+
+bool rejects(const std::vector<uint8_t>& bytes) {
+    MidiEvent event;
+    return !decodeMidiEvent(bytes.data(), bytes.size(), event);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_ChannelVoice() {
+    auto e = decode({0x93, 60, 100});
+    assert(e.type == MidiEventType::NoteOn && e.channel == 3);
+    assert(e.data1 == 60 && e.data2 == 100);
+
+    assert(decode({0x80, 60, 10}).type == MidiEventType::NoteOff);
+    assert(decode({0xAF, 60, 10}).type == MidiEventType::PolyPressure);
+    assert(decode({0xAF, 60, 10}).channel == 15);
+
+    e = decode({0xB2, 7, 127});
+    assert(e.type == MidiEventType::ControlChange && e.data1 == 7 && e.data2 == 127);
+
+    e = decode({0xC0, 5});
+    assert(e.type == MidiEventType::ProgramChange && e.data1 == 5);
+
+    e = decode({0xD1, 99});
+    assert(e.type == MidiEventType::ChannelPressure && e.data1 == 99);
+
+    std::cout << "[PASS] test_ChannelVoice\n";
+}
+
+void test_NoteOnVelocityZero() {
+    auto e = decode({0x90, 60, 0});
+    assert(e.type == MidiEventType::NoteOff);
+    assert(e.data1 == 60 && e.data2 == 0);
+
+    std::cout << "[PASS] test_NoteOnVelocityZero\n";
+}
+
+void test_PitchBend() {
+    auto e = decode({0xE0, 0x00, 0x40});
+    assert(e.type == MidiEventType::PitchBend);
+    assert(e.value14 == 8192 && e.pitchBend() == 0);
+
+    assert(decode({0xE0, 0x00, 0x00}).pitchBend() == -8192);
+    assert(decode({0xE0, 0x7F, 0x7F}).pitchBend() == 8191);
+
+    std::cout << "[PASS] test_PitchBend\n";
+}
+
+void test_SystemCommon() {
+    assert(decode({0xF0, 0x7D, 0xF7}).type == MidiEventType::SysEx);
+
+    auto e = decode({0xF1, 0x35});
+    assert(e.type == MidiEventType::MtcQuarterFrame && e.data1 == 0x35);
+
+    e = decode({0xF2, 0x7F, 0x01});
+    assert(e.type == MidiEventType::SongPosition && e.value14 == 0xFF);
+
+    e = decode({0xF3, 9});
+    assert(e.type == MidiEventType::SongSelect && e.data1 == 9);
+
+    assert(decode({0xF6}).type == MidiEventType::TuneRequest);
+
+    std::cout << "[PASS] test_SystemCommon\n";
+}
+
+void test_Realtime() {
+    assert(decode({0xF8}).type == MidiEventType::Clock);
+    assert(decode({0xFA}).type == MidiEventType::Start);
+    assert(decode({0xFB}).type == MidiEventType::Continue);
+    assert(decode({0xFC}).type == MidiEventType::Stop);
+    assert(decode({0xFE}).type == MidiEventType::ActiveSensing);
+    assert(decode({0xFF}).type == MidiEventType::SystemReset);
+
+    std::cout << "[PASS] test_Realtime\n";
+}
+
+void test_Rejected() {
+    assert(rejects({}));
+    assert(rejects({0x40, 0x10}));      // Data byte
+    assert(rejects({0x90, 60}));        // Truncated
+    assert(rejects({0xC0}));
+    assert(rejects({0xF2, 0x10}));
+    assert(rejects({0xF4}));            // Undefined
+    assert(rejects({0xFD}));
+
+    std::cout << "[PASS] test_Rejected\n";
+}
+
+void test_EventBitsDistinct() {
+    uint32_t seen = 0;
+    for (uint8_t t = 0; t <= static_cast<uint8_t>(MidiEventType::SystemReset); ++t) {
+        const uint32_t bit = midiEventBit(static_cast<MidiEventType>(t));
+        assert((seen & bit) == 0);
+        seen |= bit;
+    }
+
+    std::cout << "[PASS] test_EventBitsDistinct\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiEvent Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_ChannelVoice();
+    test::test_NoteOnVelocityZero();
+    test::test_PitchBend();
+    test::test_SystemCommon();
+    test::test_Realtime();
+    test::test_Rejected();
+    test::test_EventBitsDistinct();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
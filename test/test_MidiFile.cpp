@@ -0,0 +1,277 @@
+/**
+ * @file test_MidiFile.cpp
+ * @brief Unit tests for MidiFile / MidiFileCursor
+ *
+ * Tests SMF indexing, lazy per-track decoding and time-ordered track merging
+ * on in-memory images and on a memory-mapped file.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiFile.hpp>
+
+using oc::hal::midi::MidiFile;
+using oc::hal::midi::MidiFileCursor;
+using oc::hal::midi::MidiFileEvent;
+
+namespace test {
+
+// ═══════════════════════════════════════════════════════════════════
+// SMF image builder
+// ═══════════════════════════════════════════════════════════════════
+
+void putBe32(std::vector<uint8_t>& out, uint32_t v) {
+    out.push_back(static_cast<uint8_t>(v >> 24));
+    out.push_back(static_cast<uint8_t>(v >> 16));
+    out.push_back(static_cast<uint8_t>(v >> 8));
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+void putVlq(std::vector<uint8_t>& out, uint32_t v) {
+    uint8_t buf[4];
+    int n = 0;
+    buf[n++] = v & 0x7F;
+    while (v >>= 7) buf[n++] = static_cast<uint8_t>(0x80 | (v & 0x7F));
+    while (n) out.push_back(buf[--n]);
+}
+
+std::vector<uint8_t> makeSmf(uint16_t format, uint16_t division,
+                             const std::vector<std::vector<uint8_t>>& tracks) {
+    std::vector<uint8_t> out = {'M', 'T', 'h', 'd'};
+    putBe32(out, 6);
+    out.push_back(0);
+    out.push_back(static_cast<uint8_t>(format));
+    out.push_back(0);
+    out.push_back(static_cast<uint8_t>(tracks.size()));
+    out.push_back(static_cast<uint8_t>(division >> 8));
+    out.push_back(static_cast<uint8_t>(division));
+    for (const auto& t : tracks) {
+        out.insert(out.end(), {'M', 'T', 'r', 'k'});
+        putBe32(out, static_cast<uint32_t>(t.size()));
+        out.insert(out.end(), t.begin(), t.end());
+    }
+    return out;
+}
+
+void endOfTrack(std::vector<uint8_t>& t) {
+    t.insert(t.end(), {0x00, 0xFF, 0x2F, 0x00});
+}
+
+std::vector<MidiFileEvent> readAll(const MidiFile& file) {
+    MidiFileCursor cursor(file);
+    std::vector<MidiFileEvent> events;
+    MidiFileEvent e;
+    while (cursor.next(e)) events.push_back(e);
+    return events;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_RejectsInvalidHeader() {
+    MidiFile file;
+    const uint8_t garbage[] = {'R', 'I', 'F', 'F', 0, 0, 0, 6, 0, 0, 0, 1, 0, 96};
+    const bool openedGarbage = file.openMemory(garbage, sizeof(garbage));
+    assert(!openedGarbage);
+    assert(!file.isOpen());
+    const bool openedNull = file.openMemory(nullptr, 0);
+    assert(!openedNull);
+
+    std::cout << "[PASS] test_RejectsInvalidHeader\n";
+}
+
+void test_RunningStatus() {
+    std::vector<uint8_t> t;
+    t.insert(t.end(), {0x00, 0x90, 60, 100});
+    t.insert(t.end(), {0x10, 62, 101});       // running status
+    t.insert(t.end(), {0x10, 0xC1, 5});       // program change (1 data byte)
+    t.insert(t.end(), {0x00, 7});             // running program change
+    endOfTrack(t);
+    auto smf = makeSmf(0, 96, {t});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+    auto events = readAll(file);
+
+    assert(events.size() == 5);
+    assert(events[1].message[0] == 0x90 && events[1].message[1] == 62);
+    assert(events[1].tick == 16);
+    assert(events[2].messageLength == 2 && events[2].message[1] == 5);
+    assert(events[3].message[0] == 0xC1 && events[3].message[1] == 7);
+    assert(events[4].kind == MidiFileEvent::Kind::Meta && events[4].metaType == 0x2F);
+
+    std::cout << "[PASS] test_RunningStatus\n";
+}
+
+void test_TracksMergedByTime() {
+    std::vector<uint8_t> t0, t1;
+    t0.insert(t0.end(), {0x00, 0x90, 60, 100, 0x60, 0x80, 60, 0});  // ticks 0, 96
+    endOfTrack(t0);
+    t1.insert(t1.end(), {0x30, 0x91, 64, 90, 0x30, 0x81, 64, 0});   // ticks 48, 96
+    endOfTrack(t1);
+    auto smf = makeSmf(1, 96, {t0, t1});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+    assert(file.trackCount() == 2);
+
+    std::vector<MidiFileEvent> channel;
+    for (const auto& e : readAll(file)) {
+        if (e.kind == MidiFileEvent::Kind::Channel) channel.push_back(e);
+    }
+
+    assert(channel.size() == 4);
+    assert(channel[0].tick == 0 && channel[0].track == 0);
+    assert(channel[1].tick == 48 && channel[1].track == 1);
+    // Same tick: lower track index first
+    assert(channel[2].tick == 96 && channel[2].track == 0);
+    assert(channel[3].tick == 96 && channel[3].track == 1);
+
+    std::cout << "[PASS] test_TracksMergedByTime\n";
+}
+
+void test_TempoChanges() {
+    std::vector<uint8_t> t0, t1;
+    // 120 BPM, then 60 BPM at tick 96
+    t0.insert(t0.end(), {0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20});
+    t0.insert(t0.end(), {0x60, 0xFF, 0x51, 0x03, 0x0F, 0x42, 0x40});
+    endOfTrack(t0);
+    t1.insert(t1.end(), {0x60, 0x90, 60, 100});   // tick 96  -> 0.5 s
+    t1.insert(t1.end(), {0x60, 0x80, 60, 0});     // tick 192 -> 1.5 s
+    endOfTrack(t1);
+    auto smf = makeSmf(1, 96, {t0, t1});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+
+    std::vector<MidiFileEvent> channel;
+    for (const auto& e : readAll(file)) {
+        if (e.kind == MidiFileEvent::Kind::Channel) channel.push_back(e);
+    }
+
+    assert(channel.size() == 2);
+    assert(channel[0].timeUs == 500000);
+    assert(channel[1].timeUs == 1500000);
+
+    std::cout << "[PASS] test_TempoChanges\n";
+}
+
+void test_SmpteDivision() {
+    std::vector<uint8_t> t;
+    t.insert(t.end(), {0x00, 0x90, 60, 100});
+    t.insert(t.end(), {0x81, 0x48, 0x80, 60, 0});  // 200 ticks
+    endOfTrack(t);
+    // 25 fps, 40 ticks per frame = 1000 ticks/s
+    auto smf = makeSmf(0, static_cast<uint16_t>((0xE7 << 8) | 40), {t});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+    auto events = readAll(file);
+
+    assert(events[1].tick == 200);
+    assert(events[1].timeUs == 200000);
+
+    std::cout << "[PASS] test_SmpteDivision\n";
+}
+
+void test_SysExAndEscape() {
+    std::vector<uint8_t> t;
+    t.insert(t.end(), {0x00, 0xF0, 0x04, 0x7E, 0x00, 0x06, 0xF7});
+    t.insert(t.end(), {0x00, 0xF7, 0x01, 0xF8});
+    endOfTrack(t);
+    auto smf = makeSmf(0, 96, {t});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+    auto events = readAll(file);
+
+    assert(events[0].kind == MidiFileEvent::Kind::SysEx);
+    assert(events[0].payloadLength == 4);
+    assert(events[0].payload[0] == 0x7E && events[0].payload[3] == 0xF7);
+    assert(events[1].kind == MidiFileEvent::Kind::Escape);
+    assert(events[1].payloadLength == 1 && events[1].payload[0] == 0xF8);
+
+    std::cout << "[PASS] test_SysExAndEscape\n";
+}
+
+void test_MalformedTrackStopsOnlyThatTrack() {
+    std::vector<uint8_t> bad, good;
+    bad.insert(bad.end(), {0x00, 60, 100});   // data byte without running status
+    good.insert(good.end(), {0x10, 0x90, 60, 100});
+    endOfTrack(good);
+    auto smf = makeSmf(1, 96, {bad, good});
+
+    MidiFile file;
+    const bool opened = file.openMemory(smf.data(), smf.size());
+    assert(opened);
+    auto events = readAll(file);
+
+    assert(events.size() == 2);
+    assert(events[0].track == 1 && events[0].message[1] == 60);
+
+    std::cout << "[PASS] test_MalformedTrackStopsOnlyThatTrack\n";
+}
+
+void test_OpenMappedFile() {
+    std::vector<uint8_t> t;
+    t.insert(t.end(), {0x00, 0xB0, 7, 100});
+    endOfTrack(t);
+    auto smf = makeSmf(0, 480, {t});
+
+    const char* path = "test_MidiFile_mapped.mid";
+    FILE* f = std::fopen(path, "wb");
+    assert(f);
+    std::fwrite(smf.data(), 1, smf.size(), f);
+    std::fclose(f);
+
+    {
+        MidiFile file;
+        const bool opened = file.open(path);
+        assert(opened);
+        assert(file.division() == 480);
+        auto events = readAll(file);
+        assert(events.size() == 2);
+        assert(events[0].message[0] == 0xB0 && events[0].message[2] == 100);
+    }
+
+    std::remove(path);
+
+    MidiFile missing;
+    const bool openedMissing = missing.open("does_not_exist.mid");
+    assert(!openedMissing);
+
+    std::cout << "[PASS] test_OpenMappedFile\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiFile Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_RejectsInvalidHeader();
+    test::test_RunningStatus();
+    test::test_TracksMergedByTime();
+    test::test_TempoChanges();
+    test::test_SmpteDivision();
+    test::test_SysExAndEscape();
+    test::test_MalformedTrackStopsOnlyThatTrack();
+    test::test_OpenMappedFile();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_MidiFilePlayer.cpp
+ * @brief Unit tests for MidiFilePlayer
+ *
+ * Plays short in-memory sequences on the scheduling thread and checks output
+ * order, timing against absolute deadlines and held-note release on stop().
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <oc/hal/midi/MidiFilePlayer.hpp>
+
+using oc::hal::midi::MidiFilePlayer;
+using oc::hal::midi::MidiFilePlayerConfig;
+using oc::hal::midi::steadyNowUs;
+
+namespace test {
+
+struct Captured {
+    std::vector<uint8_t> bytes;
+    uint64_t timeUs;
+};
+
+class CaptureSink {
+public:
+    void operator()(const uint8_t* data, size_t length) {
+        std::lock_guard<std::mutex> lock(mutex);
+        messages.push_back({std::vector<uint8_t>(data, data + length), steadyNowUs()});
+    }
+
+    std::mutex mutex;
+    std::vector<Captured> messages;
+};
+
+// Format 0, 1000 ticks per quarter at 120 BPM: 1 tick = 0.5 ms
+std::vector<uint8_t> makeSequence(const std::vector<uint8_t>& events) {
+    std::vector<uint8_t> out = {'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1, 0x03, 0xE8,
+                                'M', 'T', 'r', 'k'};
+    const uint32_t length = static_cast<uint32_t>(events.size() + 4);
+    out.push_back(static_cast<uint8_t>(length >> 24));
+    out.push_back(static_cast<uint8_t>(length >> 16));
+    out.push_back(static_cast<uint8_t>(length >> 8));
+    out.push_back(static_cast<uint8_t>(length));
+    out.insert(out.end(), events.begin(), events.end());
+    out.insert(out.end(), {0x00, 0xFF, 0x2F, 0x00});
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_PlaysEventsInOrderWithDeadlines() {
+    // Note on at 0 ms, CC at 10 ms, SysEx at 20 ms, note off at 30 ms
+    auto smf = makeSequence({0x00, 0x90, 60, 100,
+                             0x14, 0xB0, 1, 64,
+                             0x14, 0xF0, 0x03, 0x7D, 0x01, 0xF7,
+                             0x14, 0x80, 60, 0});
+
+    CaptureSink sink;
+    MidiFilePlayerConfig config;
+    config.realtimePriority = false;
+    MidiFilePlayer player(config);
+    player.setOutput([&sink](const uint8_t* d, size_t n) { sink(d, n); });
+
+    const bool opened = player.openMemory(smf.data(), smf.size());
+    assert(opened);
+    const uint64_t playUs = steadyNowUs();
+    const bool started = player.play();
+    assert(started);
+    player.wait();
+    assert(!player.isPlaying());
+
+    assert(sink.messages.size() == 4);
+    assert(sink.messages[0].bytes == std::vector<uint8_t>({0x90, 60, 100}));
+    assert(sink.messages[1].bytes == std::vector<uint8_t>({0xB0, 1, 64}));
+    assert(sink.messages[2].bytes == std::vector<uint8_t>({0xF0, 0x7D, 0x01, 0xF7}));
+    assert(sink.messages[3].bytes == std::vector<uint8_t>({0x80, 60, 0}));
+
+    // The last event leaves at start delay + 30 ms: never early, and late
+    // only by scheduler slack
+    auto jitter = player.jitter();
+    assert(jitter.count == 4);
+    assert(jitter.minUs >= 0);
+    const uint64_t lastUs = sink.messages[3].timeUs - playUs;
+    assert(lastUs >= config.startDelayUs + 30000);
+    assert(lastUs < config.startDelayUs + 30000 + 50000);
+    assert(player.eventsSent() == 4);
+
+    std::cout << "[PASS] test_PlaysEventsInOrderWithDeadlines\n";
+}
+
+void test_StopReleasesHeldNotes() {
+    // Note on, then a note off 10 s later that is never reached
+    auto smf = makeSequence({0x00, 0x93, 64, 90,
+                             0x00, 0x90, 60, 90,
+                             0x81, 0x9C, 0x40, 0x80, 60, 0});
+
+    CaptureSink sink;
+    MidiFilePlayerConfig config;
+    config.realtimePriority = false;
+    MidiFilePlayer player(config);
+    player.setOutput([&sink](const uint8_t* d, size_t n) { sink(d, n); });
+
+    const bool opened = player.openMemory(smf.data(), smf.size());
+    assert(opened);
+    const bool started = player.play();
+    assert(started);
+
+    const uint64_t waitStart = steadyNowUs();
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(sink.mutex);
+            if (sink.messages.size() >= 2) break;
+        }
+        assert(steadyNowUs() - waitStart < 2000000);
+    }
+
+    player.stop();
+    assert(!player.isPlaying());
+
+    assert(sink.messages.size() == 4);
+    // Note offs for both held notes, in channel order
+    assert(sink.messages[2].bytes == std::vector<uint8_t>({0x80, 60, 0}));
+    assert(sink.messages[3].bytes == std::vector<uint8_t>({0x83, 64, 0}));
+
+    std::cout << "[PASS] test_StopReleasesHeldNotes\n";
+}
+
+void test_PlayRequiresFileAndOutput() {
+    MidiFilePlayer player;
+    const bool startedEmpty = player.play();
+    assert(!startedEmpty);
+
+    auto smf = makeSequence({0x00, 0x90, 60, 100});
+    const bool opened = player.openMemory(smf.data(), smf.size());
+    assert(opened);
+    const bool startedSilent = player.play();
+    assert(!startedSilent);
+
+    std::cout << "[PASS] test_PlayRequiresFileAndOutput\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiFilePlayer Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_PlaysEventsInOrderWithDeadlines();
+    test::test_StopReleasesHeldNotes();
+    test::test_PlayRequiresFileAndOutput();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file test_MidiScan.cpp
+ * @brief Unit tests for findStatusByte
+ *
+ * Checks the vectorised scan against the scalar reference for every
+ * position, length and misalignment around the 16/32-byte block sizes.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiScan.hpp>
+
+using oc::hal::midi::findStatusByte;
+using oc::hal::midi::findStatusByteScalar;
+
+namespace test {
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_EmptyRange() {
+    const uint8_t data[1] = {0x90};
+    assert(findStatusByte(data, data) == data);
+
+    std::cout << "[PASS] test_EmptyRange\n";
+}
+
+void test_NoStatusByte() {
+    std::vector<uint8_t> data(100, 0x7F);
+    assert(findStatusByte(data.data(), data.data() + data.size()) == data.data() + data.size());
+
+    std::cout << "[PASS] test_NoStatusByte\n";
+}
+
+void test_EveryPositionAndAlignment() {
+    std::vector<uint8_t> buffer(128 + 8);
+    for (size_t offset = 0; offset < 8; ++offset) {
+        for (size_t length = 0; length <= 128; ++length) {
+            for (size_t pos = 0; pos <= length; ++pos) {
+                uint8_t* begin = buffer.data() + offset;
+                for (size_t i = 0; i < length; ++i) begin[i] = static_cast<uint8_t>(i & 0x7F);
+                if (pos < length) begin[pos] = static_cast<uint8_t>(0x80 | (pos & 0x7F));
+
+                const uint8_t* expected = findStatusByteScalar(begin, begin + length);
+                assert(expected == begin + pos);
+                assert(findStatusByte(begin, begin + length) == expected);
+            }
+        }
+    }
+
+    std::cout << "[PASS] test_EveryPositionAndAlignment\n";
+}
+
+void test_FirstOfSeveralStatusBytes() {
+    std::vector<uint8_t> data(64, 0x10);
+    data[40] = 0xF7;
+    data[20] = 0xF8;
+    data[50] = 0x90;
+    assert(findStatusByte(data.data(), data.data() + data.size()) == data.data() + 20);
+    assert(findStatusByte(data.data() + 21, data.data() + data.size()) == data.data() + 40);
+
+    std::cout << "[PASS] test_FirstOfSeveralStatusBytes\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiScan Unit Tests (" << oc::hal::midi::MIDI_SCAN_ISA << ")\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_EmptyRange();
+    test::test_NoStatusByte();
+    test::test_EveryPositionAndAlignment();
+    test::test_FirstOfSeveralStatusBytes();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
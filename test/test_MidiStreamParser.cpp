@@ -0,0 +1,286 @@
+/**
+ * @file test_MidiStreamParser.cpp
+ * @brief Unit tests for MidiStreamParser
+ *
+ * Tests incremental framing of raw MIDI byte streams: running status,
+ * interleaved realtime bytes, SysEx split across reads and error recovery.
+ */
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiStreamParser.hpp>
+
+using oc::hal::midi::MidiStreamParser;
+using oc::hal::midi::SysExChunkPhase;
+
+namespace test {
+
+using Message = std::vector<uint8_t>;
+
+struct Collector {
+    std::vector<Message> messages;
+
+    void operator()(const uint8_t* data, size_t length) {
+        messages.emplace_back(data, data + length);
+    }
+};
+
+struct ChunkCollector {
+    std::vector<SysExChunkPhase> phases;
+    std::vector<Message> chunks;
+
+    void operator()(SysExChunkPhase phase, const uint8_t* data, size_t length) {
+        phases.push_back(phase);
+        chunks.emplace_back(data, data + length);
+    }
+};
+
+struct ParserFixture {
+    std::array<uint8_t, 16> sysex{};
+    MidiStreamParser parser{sysex.data(), sysex.size()};
+    Collector out;
+
+    void feed(const std::vector<uint8_t>& bytes) {
+        parser.parse(bytes.data(), bytes.size(), out);
+    }
+};
+
+struct ChunkedFixture {
+    std::array<uint8_t, 8> sysex{};
+    MidiStreamParser parser{sysex.data(), sysex.size()};
+    Collector out;
+    ChunkCollector chunks;
+
+    void feed(const std::vector<uint8_t>& bytes) {
+        parser.parse(bytes.data(), bytes.size(), out, chunks);
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_CompleteMessages() {
+    ParserFixture f;
+    f.feed({0x90, 60, 100, 0xB1, 7, 127, 0xC2, 5, 0xE3, 0x00, 0x40});
+
+    assert(f.out.messages.size() == 4);
+    assert(f.out.messages[0] == Message({0x90, 60, 100}));
+    assert(f.out.messages[1] == Message({0xB1, 7, 127}));
+    assert(f.out.messages[2] == Message({0xC2, 5}));
+    assert(f.out.messages[3] == Message({0xE3, 0x00, 0x40}));
+
+    std::cout << "[PASS] test_CompleteMessages\n";
+}
+
+void test_RunningStatus() {
+    ParserFixture f;
+    f.feed({0x90, 60, 100, 62, 101, 64, 0});
+    f.feed({0xD0, 10, 20, 30});
+
+    assert(f.out.messages.size() == 6);
+    assert(f.out.messages[1] == Message({0x90, 62, 101}));
+    assert(f.out.messages[2] == Message({0x90, 64, 0}));
+    assert(f.out.messages[5] == Message({0xD0, 30}));
+
+    std::cout << "[PASS] test_RunningStatus\n";
+}
+
+void test_MessageSplitAcrossReads() {
+    ParserFixture f;
+    f.feed({0xB0});
+    f.feed({1});
+    assert(f.out.messages.empty());
+    f.feed({64, 2});
+    f.feed({65});
+
+    assert(f.out.messages.size() == 2);
+    assert(f.out.messages[0] == Message({0xB0, 1, 64}));
+    assert(f.out.messages[1] == Message({0xB0, 2, 65}));
+
+    std::cout << "[PASS] test_MessageSplitAcrossReads\n";
+}
+
+void test_RealtimeInsideChannelMessage() {
+    ParserFixture f;
+    f.feed({0x90, 60, 0xF8, 100, 0xFA});
+
+    assert(f.out.messages.size() == 3);
+    assert(f.out.messages[0] == Message({0xF8}));
+    assert(f.out.messages[1] == Message({0x90, 60, 100}));
+    assert(f.out.messages[2] == Message({0xFA}));
+
+    std::cout << "[PASS] test_RealtimeInsideChannelMessage\n";
+}
+
+void test_SysExSplitWithRealtime() {
+    ParserFixture f;
+    f.feed({0xF0, 0x7E, 0x00});
+    f.feed({0xF8, 0x06});
+    assert(f.out.messages.size() == 1);
+    assert(f.parser.inSysEx());
+    f.feed({0x01, 0xF7, 0x80, 60, 0});
+
+    assert(f.out.messages.size() == 3);
+    assert(f.out.messages[0] == Message({0xF8}));
+    assert(f.out.messages[1] == Message({0xF0, 0x7E, 0x00, 0x06, 0x01, 0xF7}));
+    assert(f.out.messages[2] == Message({0x80, 60, 0}));
+    assert(!f.parser.inSysEx());
+
+    std::cout << "[PASS] test_SysExSplitWithRealtime\n";
+}
+
+void test_SysExCancelsRunningStatus() {
+    ParserFixture f;
+    f.feed({0x90, 60, 100, 0xF0, 0x01, 0xF7, 61, 100});
+
+    assert(f.out.messages.size() == 2);
+    assert(f.parser.stats().strayBytes == 2);
+
+    std::cout << "[PASS] test_SysExCancelsRunningStatus\n";
+}
+
+void test_SysExOverflowDropped() {
+    ParserFixture f;
+    std::vector<uint8_t> big = {0xF0};
+    for (int i = 0; i < 40; ++i) big.push_back(static_cast<uint8_t>(i));
+    big.push_back(0xF7);
+    f.feed(big);
+    f.feed({0xF0, 0x01, 0xF7});
+
+    assert(f.out.messages.size() == 1);
+    assert(f.out.messages[0] == Message({0xF0, 0x01, 0xF7}));
+    assert(f.parser.stats().sysexOverflows == 1);
+
+    std::cout << "[PASS] test_SysExOverflowDropped\n";
+}
+
+void test_SysExAbortedByStatus() {
+    ParserFixture f;
+    f.feed({0xF0, 0x01, 0x02, 0x90, 60, 100});
+
+    assert(f.out.messages.size() == 1);
+    assert(f.out.messages[0] == Message({0x90, 60, 100}));
+    assert(f.parser.stats().sysexAborted == 1);
+
+    std::cout << "[PASS] test_SysExAbortedByStatus\n";
+}
+
+void test_SystemCommon() {
+    ParserFixture f;
+    f.feed({0xF2, 0x10, 0x20, 0xF1, 0x35, 0xF6, 0xF3, 4, 5});
+
+    assert(f.out.messages.size() == 4);
+    assert(f.out.messages[0] == Message({0xF2, 0x10, 0x20}));
+    assert(f.out.messages[1] == Message({0xF1, 0x35}));
+    assert(f.out.messages[2] == Message({0xF6}));
+    assert(f.out.messages[3] == Message({0xF3, 4}));
+    // System common has no running status: trailing 5 is stray
+    assert(f.parser.stats().strayBytes == 1);
+
+    std::cout << "[PASS] test_SystemCommon\n";
+}
+
+void test_StrayDataAndReset() {
+    ParserFixture f;
+    f.feed({0x10, 0x20, 0xF7});
+    assert(f.out.messages.empty());
+    assert(f.parser.stats().strayBytes == 3);
+
+    f.feed({0x90, 60});
+    f.parser.reset();
+    f.feed({100});
+    assert(f.out.messages.empty());
+
+    std::cout << "[PASS] test_StrayDataAndReset\n";
+}
+
+void test_ChunkedSysExFragments() {
+    ChunkedFixture f;
+    std::vector<uint8_t> dump = {0xF0};
+    for (uint8_t i = 0; i < 20; ++i) dump.push_back(i);
+    dump.push_back(0xF7);
+
+    // Split across reads, with a clock in the middle
+    f.feed(std::vector<uint8_t>(dump.begin(), dump.begin() + 5));
+    f.feed({0xF8});
+    f.feed(std::vector<uint8_t>(dump.begin() + 5, dump.end()));
+
+    assert(f.out.messages.size() == 1);
+    assert(f.out.messages[0] == Message({0xF8}));
+
+    assert(f.chunks.phases.size() == 3);
+    assert(f.chunks.phases[0] == SysExChunkPhase::Begin);
+    assert(f.chunks.phases[1] == SysExChunkPhase::Data);
+    assert(f.chunks.phases[2] == SysExChunkPhase::End);
+
+    Message joined;
+    for (const auto& c : f.chunks.chunks) {
+        assert(c.size() <= 8);
+        joined.insert(joined.end(), c.begin(), c.end());
+    }
+    assert(joined == dump);
+    assert(f.parser.stats().sysexOverflows == 0);
+
+    std::cout << "[PASS] test_ChunkedSysExFragments\n";
+}
+
+void test_ChunkedSmallSysExDeliveredWhole() {
+    ChunkedFixture f;
+    f.feed({0xF0, 0x7D, 0x01, 0x02, 0xF7});
+
+    assert(f.chunks.phases.empty());
+    assert(f.out.messages.size() == 1);
+    assert(f.out.messages[0] == Message({0xF0, 0x7D, 0x01, 0x02, 0xF7}));
+
+    std::cout << "[PASS] test_ChunkedSmallSysExDeliveredWhole\n";
+}
+
+void test_ChunkedSysExAbort() {
+    ChunkedFixture f;
+    std::vector<uint8_t> bytes = {0xF0};
+    for (uint8_t i = 0; i < 12; ++i) bytes.push_back(i);
+    bytes.insert(bytes.end(), {0x90, 60, 100});
+    f.feed(bytes);
+
+    assert(f.chunks.phases.size() == 2);
+    assert(f.chunks.phases[0] == SysExChunkPhase::Begin);
+    assert(f.chunks.phases[1] == SysExChunkPhase::Abort);
+    assert(f.chunks.chunks[1].empty());
+    assert(f.out.messages.size() == 1);
+    assert(f.out.messages[0] == Message({0x90, 60, 100}));
+
+    std::cout << "[PASS] test_ChunkedSysExAbort\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiStreamParser Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_CompleteMessages();
+    test::test_RunningStatus();
+    test::test_MessageSplitAcrossReads();
+    test::test_RealtimeInsideChannelMessage();
+    test::test_SysExSplitWithRealtime();
+    test::test_SysExCancelsRunningStatus();
+    test::test_SysExOverflowDropped();
+    test::test_SysExAbortedByStatus();
+    test::test_SystemCommon();
+    test::test_StrayDataAndReset();
+    test::test_ChunkedSysExFragments();
+    test::test_ChunkedSmallSysExDeliveredWhole();
+    test::test_ChunkedSysExAbort();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
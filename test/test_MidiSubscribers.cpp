@@ -0,0 +1,159 @@
+/**
+ * @file test_MidiSubscribers.cpp
+ * @brief Unit tests for MidiSubscribers
+ *
+ * Checks fan-out by type mask, that every subscriber sees the same bytes,
+ * and subscribe / unsubscribe from inside a dispatch (including many
+ * subscribers joining at once).
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiSubscribers.hpp>
+
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::MidiSubscribers;
+using oc::hal::midi::decodeMidiEvent;
+using oc::hal::midi::midiEventBit;
+
+namespace test {
+
+void dispatch(MidiSubscribers& subscribers, const std::vector<uint8_t>& bytes) {
+    MidiEvent event;
+    const bool decoded = decodeMidiEvent(bytes.data(), bytes.size(), event);
+    assert(decoded);
+    subscribers.dispatch(event, bytes.data(), bytes.size(), 42);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_FanOutByMask() {
+    MidiSubscribers subscribers;
+    int notes = 0;
+    int all = 0;
+    subscribers.subscribe(midiEventBit(MidiEventType::NoteOn) |
+                              midiEventBit(MidiEventType::NoteOff),
+                          [&](const MidiEvent&, const uint8_t*, size_t, uint64_t) { ++notes; });
+    subscribers.subscribe(~0u, [&](const MidiEvent&, const uint8_t*, size_t, uint64_t timestampUs) {
+        assert(timestampUs == 42);
+        ++all;
+    });
+    const auto none =
+        subscribers.subscribe(0, [](const MidiEvent&, const uint8_t*, size_t, uint64_t) {});
+    assert(none == MidiSubscribers::INVALID_ID);
+
+    dispatch(subscribers, {0x90, 60, 100});
+    dispatch(subscribers, {0x80, 60, 0});
+    dispatch(subscribers, {0xB0, 1, 2});
+    assert(notes == 2 && all == 3);
+    assert(subscribers.interestMask() == ~0u);
+    std::cout << "[PASS] test_FanOutByMask\n";
+}
+
+void test_SharedView() {
+    MidiSubscribers subscribers;
+    std::vector<const uint8_t*> seen;
+    for (int i = 0; i < 3; ++i) {
+        subscribers.subscribe(midiEventBit(MidiEventType::SysEx),
+                              [&](const MidiEvent& event, const uint8_t* data, size_t length,
+                                  uint64_t) {
+                                  assert(event.type == MidiEventType::SysEx && length == 4);
+                                  seen.push_back(data);
+                              });
+    }
+    const std::vector<uint8_t> sysex = {0xF0, 0x7D, 0x01, 0xF7};
+    dispatch(subscribers, sysex);
+    assert(seen.size() == 3);
+    for (const auto* p : seen) assert(p == sysex.data());
+    std::cout << "[PASS] test_SharedView\n";
+}
+
+void test_ChangesDuringDispatch() {
+    MidiSubscribers subscribers;
+    const uint32_t cc = midiEventBit(MidiEventType::ControlChange);
+    std::vector<char> order;
+
+    MidiSubscribers::Id self = 0;
+    MidiSubscribers::Id other = 0;
+    self = subscribers.subscribe(cc, [&](const MidiEvent&, const uint8_t*, size_t, uint64_t) {
+        order.push_back('a');
+        subscribers.unsubscribe(self);   // Remove self
+        subscribers.unsubscribe(other);  // And a later subscriber
+        subscribers.subscribe(cc, [&](const MidiEvent&, const uint8_t*, size_t, uint64_t) {
+            order.push_back('c');
+        });
+    });
+    other = subscribers.subscribe(cc, [&](const MidiEvent&, const uint8_t*, size_t, uint64_t) {
+        order.push_back('b');
+    });
+
+    dispatch(subscribers, {0xB0, 7, 1});
+    assert((order == std::vector<char>{'a'}));  // 'b' removed, 'c' joins after
+    assert(subscribers.size() == 1);
+
+    dispatch(subscribers, {0xB0, 7, 2});
+    assert((order == std::vector<char>{'a', 'c'}));
+    const bool removedTwice = subscribers.unsubscribe(self);
+    assert(!removedTwice);
+    std::cout << "[PASS] test_ChangesDuringDispatch\n";
+}
+
+void test_ManyJoinDuringDispatch() {
+    MidiSubscribers subscribers;
+    const uint32_t cc = midiEventBit(MidiEventType::ControlChange);
+    std::vector<int> order;
+
+    // Far more joiners than entries_ has room for: merged through the
+    // spare list, in subscription order.
+    subscribers.subscribe(cc, [&](const MidiEvent& event, const uint8_t*, size_t, uint64_t) {
+        if (event.data2 != 1) return;
+        for (int i = 1; i <= 40; ++i) {
+            subscribers.subscribe(cc, [&order, i](const MidiEvent&, const uint8_t*, size_t,
+                                                  uint64_t) { order.push_back(i); });
+        }
+    });
+
+    dispatch(subscribers, {0xB0, 7, 1});
+    assert(order.empty() && subscribers.size() == 41);
+    dispatch(subscribers, {0xB0, 7, 2});
+    assert(order.size() == 40);
+    for (int i = 0; i < 40; ++i) assert(order[i] == i + 1);
+    std::cout << "[PASS] test_ManyJoinDuringDispatch\n";
+}
+
+void test_UnsubscribeClearsInterest() {
+    MidiSubscribers subscribers;
+    const auto id = subscribers.subscribe(midiEventBit(MidiEventType::Clock),
+                                          [](const MidiEvent&, const uint8_t*, size_t, uint64_t) {});
+    assert(subscribers.interestMask() == midiEventBit(MidiEventType::Clock));
+    const bool removed = subscribers.unsubscribe(id);
+    assert(removed);
+    assert(subscribers.interestMask() == 0 && subscribers.size() == 0);
+    std::cout << "[PASS] test_UnsubscribeClearsInterest\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiSubscribers Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_FanOutByMask();
+    test::test_SharedView();
+    test::test_ChangesDuringDispatch();
+    test::test_ManyJoinDuringDispatch();
+    test::test_UnsubscribeClearsInterest();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_MidiThru.cpp
+ * @brief Unit tests for MidiThru
+ *
+ * Checks type filtering, channel remapping and dropping, zero-copy
+ * forwarding of unchanged messages, and per-route sinks.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/MidiThru.hpp>
+
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::MidiThru;
+using oc::hal::midi::midiEventBit;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+struct Capture {
+    std::vector<Bytes> messages;
+    std::vector<const uint8_t*> pointers;
+
+    void operator()(const uint8_t* data, size_t length) {
+        messages.emplace_back(data, data + length);
+        pointers.push_back(data);
+    }
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_DefaultRouteForwardsEverything() {
+    MidiThru thru;
+    Capture out;
+    const Bytes note = {0x93, 60, 100};
+    const Bytes clock = {0xF8};
+    const Bytes sysex = {0xF0, 0x7D, 0x01, 0xF7};
+
+    const size_t routed = thru.forward(note.data(), note.size(), out);
+    assert(routed == 0);  // No routes
+    thru.add(MidiThru::Route{});
+    thru.forward(note.data(), note.size(), out);
+    thru.forward(clock.data(), clock.size(), out);
+    thru.forward(sysex.data(), sysex.size(), out);
+    assert((out.messages == std::vector<Bytes>{note, clock, sysex}));
+
+    // Zero copy: the sink sees the caller's bytes
+    assert(out.pointers[0] == note.data() && out.pointers[2] == sysex.data());
+    std::cout << "[PASS] test_DefaultRouteForwardsEverything\n";
+}
+
+void test_TypeMaskAndChannelMap() {
+    MidiThru thru;
+    MidiThru::Route route;
+    route.typeMask = midiEventBit(MidiEventType::NoteOn) | midiEventBit(MidiEventType::NoteOff);
+    route.onlyChannel(0, 9);
+    thru.add(route);
+
+    Capture out;
+    const Bytes on = {0x90, 36, 127};
+    const Bytes otherChannel = {0x91, 36, 127};
+    const Bytes cc = {0xB0, 1, 2};
+    const Bytes clock = {0xF8};
+    thru.forward(on.data(), on.size(), out);
+    thru.forward(otherChannel.data(), otherChannel.size(), out);
+    thru.forward(cc.data(), cc.size(), out);
+    thru.forward(clock.data(), clock.size(), out);
+
+    assert((out.messages == std::vector<Bytes>{{0x99, 36, 127}}));
+    assert(on[0] == 0x90);  // Input untouched
+    std::cout << "[PASS] test_TypeMaskAndChannelMap\n";
+}
+
+void test_MultipleSinks() {
+    MidiThru thru;
+    Capture second;
+    MidiThru::Route toDefault;
+    MidiThru::Route toSecond;
+    toSecond.channelMap[2] = MidiThru::DROP;
+    toSecond.sink = [&](const uint8_t* data, size_t length) { second(data, length); };
+    thru.add(toDefault);
+    thru.add(toSecond);
+
+    Capture first;
+    const Bytes a = {0xC1, 5};
+    const Bytes b = {0xC2, 6};
+    size_t routed = thru.forward(a.data(), a.size(), first);
+    assert(routed == 2);
+    routed = thru.forward(b.data(), b.size(), first);
+    assert(routed == 1);
+    assert((first.messages == std::vector<Bytes>{a, b}));
+    assert((second.messages == std::vector<Bytes>{a}));
+    std::cout << "[PASS] test_MultipleSinks\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiThru Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_DefaultRouteForwardsEverything();
+    test::test_TypeMaskAndChannelMap();
+    test::test_MultipleSinks();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
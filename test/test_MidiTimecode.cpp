@@ -0,0 +1,194 @@
+/**
+ * @file test_MidiTimecode.cpp
+ * @brief Unit tests for MidiTimecode helpers and MtcChaser
+ *
+ * Checks frame arithmetic (drop-frame included), quarter-frame and
+ * full-frame encoding, and the chaser on synthetic timestamps: lock after
+ * one run, extrapolation, jitter averaging, stop detection, out-of-order
+ * pieces and full-frame locate.
+ */
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include <oc/hal/midi/MidiTimecode.hpp>
+#include <oc/hal/midi/MtcChaser.hpp>
+
+using oc::hal::midi::MtcChaser;
+using oc::hal::midi::MtcPosition;
+using oc::hal::midi::MtcRate;
+using oc::hal::midi::MtcTime;
+using oc::hal::midi::MTC_FULL_FRAME_SIZE;
+using oc::hal::midi::mtcFramePeriodUs;
+using oc::hal::midi::mtcFromFrames;
+using oc::hal::midi::mtcFromQuarterFrames;
+using oc::hal::midi::mtcFullFrame;
+using oc::hal::midi::mtcParseFullFrame;
+using oc::hal::midi::mtcQuarterFrameData;
+using oc::hal::midi::mtcToFrames;
+
+namespace test {
+
+/// Feed one run of pieces 0-7 for @p time, first piece at @p startUs
+void feedRun(MtcChaser& chaser, const MtcTime& time, double startUs, double jitterUs = 0.0) {
+    const double quarterUs = mtcFramePeriodUs(time.rate) / 4.0;
+    for (uint8_t piece = 0; piece < 8; ++piece) {
+        const double jitter = (piece & 1) ? jitterUs : -jitterUs;
+        chaser.applyQuarterFrame(mtcQuarterFrameData(time, piece),
+                                 static_cast<uint64_t>(startUs + piece * quarterUs + jitter));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_FrameCountRoundTrip() {
+    for (MtcRate rate : {MtcRate::Fps24, MtcRate::Fps25, MtcRate::Fps2997Drop, MtcRate::Fps30}) {
+        for (uint32_t frames = 0; frames < 200000; frames += 7) {
+            assert(mtcToFrames(mtcFromFrames(frames, rate)) == frames);
+        }
+    }
+
+    const MtcTime oneHour{1, 0, 0, 0, MtcRate::Fps25};
+    assert(mtcToFrames(oneHour) == 3600u * 25u);
+    assert(mtcFromFrames(24u * 3600u * 25u, MtcRate::Fps25) == (MtcTime{0, 0, 0, 0, MtcRate::Fps25}));
+    std::cout << "[PASS] test_FrameCountRoundTrip\n";
+}
+
+void test_DropFrameSkipsFrameNumbers() {
+    // 00:00:59:29 is followed by 00:01:00:02; minute 10 keeps 00 and 01.
+    const uint32_t last = mtcToFrames(MtcTime{0, 0, 59, 29, MtcRate::Fps2997Drop});
+    assert(mtcFromFrames(last + 1, MtcRate::Fps2997Drop) ==
+           (MtcTime{0, 1, 0, 2, MtcRate::Fps2997Drop}));
+    const uint32_t nine = mtcToFrames(MtcTime{0, 9, 59, 29, MtcRate::Fps2997Drop});
+    assert(mtcFromFrames(nine + 1, MtcRate::Fps2997Drop) ==
+           (MtcTime{0, 10, 0, 0, MtcRate::Fps2997Drop}));
+    assert(mtcToFrames(MtcTime{0, 10, 0, 0, MtcRate::Fps2997Drop}) == 17982u);
+    std::cout << "[PASS] test_DropFrameSkipsFrameNumbers\n";
+}
+
+void test_QuarterFrameEncoding() {
+    const MtcTime time{23, 59, 58, 29, MtcRate::Fps30};
+    uint8_t nibbles[8];
+    for (uint8_t piece = 0; piece < 8; ++piece) {
+        const uint8_t data = mtcQuarterFrameData(time, piece);
+        assert((data >> 4) == piece);
+        nibbles[piece] = data & 0x0F;
+    }
+    assert(mtcQuarterFrameData(time, 7) == 0x77);  // Hours bit 4 set, rate 3
+    assert(mtcFromQuarterFrames(nibbles) == time);
+    std::cout << "[PASS] test_QuarterFrameEncoding\n";
+}
+
+void test_FullFrameRoundTrip() {
+    const MtcTime time{10, 20, 30, 12, MtcRate::Fps24};
+    uint8_t msg[MTC_FULL_FRAME_SIZE];
+    const size_t written = mtcFullFrame(time, msg);
+    assert(written == MTC_FULL_FRAME_SIZE);
+    assert(msg[0] == 0xF0 && msg[5] == 10 && msg[9] == 0xF7);
+
+    MtcTime parsed;
+    bool ok = mtcParseFullFrame(msg, sizeof(msg), parsed);
+    assert(ok && parsed == time);
+    msg[4] = 0x02;  // User bits, not a full frame
+    ok = mtcParseFullFrame(msg, sizeof(msg), parsed);
+    assert(!ok);
+    std::cout << "[PASS] test_FullFrameRoundTrip\n";
+}
+
+void test_ChaserLocksAfterOneRun() {
+    MtcChaser chaser;
+    const MtcTime time{1, 2, 3, 10, MtcRate::Fps25};
+    const double start = 1000000.0;
+    assert(!chaser.position(1000000).locked);
+
+    // Joined mid-run: pieces 4-7 are ignored until piece 0.
+    const double quarterUs = mtcFramePeriodUs(time.rate) / 4.0;
+    for (uint8_t piece = 4; piece < 8; ++piece) {
+        const bool changed = chaser.applyQuarterFrame(
+            mtcQuarterFrameData(time, piece), static_cast<uint64_t>(start - (8 - piece) * quarterUs));
+        assert(!changed);
+    }
+    assert(!chaser.position(1000000).locked);
+
+    feedRun(chaser, time, start);
+    const uint64_t now = static_cast<uint64_t>(start + 7 * quarterUs);
+    const MtcPosition pos = chaser.position(now);
+    assert(pos.locked && pos.running);
+    assert(std::fabs(pos.frames - (mtcToFrames(time) + 1.75)) < 0.01);
+    assert(pos.time == (MtcTime{1, 2, 3, 11, MtcRate::Fps25}));
+    std::cout << "[PASS] test_ChaserLocksAfterOneRun\n";
+}
+
+void test_ChaserAveragesJitterAndStops() {
+    MtcChaser chaser;
+    const MtcTime time{0, 0, 10, 0, MtcRate::Fps30};
+    const double period = mtcFramePeriodUs(time.rate);
+    const double start = 5000000.0;
+
+    // Alternating +-800 us per piece: the reference is their mean.
+    feedRun(chaser, time, start, 800.0);
+    const uint64_t last = static_cast<uint64_t>(start + 7 * period / 4.0 + 800.0);
+    MtcPosition pos = chaser.position(last);
+    assert(std::fabs(pos.frames - (mtcToFrames(time) + (last - start) / period)) < 0.001);
+
+    // No quarter frame for more than two frames: stopped, position held.
+    const uint64_t later = last + static_cast<uint64_t>(3 * period);
+    pos = chaser.position(later);
+    assert(pos.locked && !pos.running);
+    assert(std::fabs(pos.frames - (mtcToFrames(time) + (last - start) / period)) < 0.001);
+    std::cout << "[PASS] test_ChaserAveragesJitterAndStops\n";
+}
+
+void test_ChaserOutOfOrderAndFullFrame() {
+    MtcChaser chaser;
+    const MtcTime time{0, 5, 0, 0, MtcRate::Fps24};
+    const double quarterUs = mtcFramePeriodUs(time.rate) / 4.0;
+    const uint32_t version = chaser.version();
+
+    // Piece 3 missing: no position.
+    for (uint8_t piece : {0, 1, 2, 4, 5, 6, 7}) {
+        chaser.applyQuarterFrame(mtcQuarterFrameData(time, piece),
+                                 static_cast<uint64_t>(1000000 + piece * quarterUs));
+    }
+    assert(!chaser.position(1100000).locked);
+    assert(chaser.version() == version);
+
+    uint8_t msg[MTC_FULL_FRAME_SIZE];
+    mtcFullFrame(MtcTime{2, 0, 0, 5, MtcRate::Fps24}, msg);
+    const bool changed = chaser.applyFullFrame(msg, sizeof(msg), 2000000);
+    assert(changed);
+    assert(chaser.version() != version);
+    const MtcPosition pos = chaser.position(3000000);
+    assert(pos.locked && !pos.running);
+    assert(pos.time == (MtcTime{2, 0, 0, 5, MtcRate::Fps24}));
+
+    chaser.reset();
+    assert(!chaser.position(3000000).locked);
+    std::cout << "[PASS] test_ChaserOutOfOrderAndFullFrame\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MidiTimecode Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_FrameCountRoundTrip();
+    test::test_DropFrameSkipsFrameNumbers();
+    test::test_QuarterFrameEncoding();
+    test::test_FullFrameRoundTrip();
+    test::test_ChaserLocksAfterOneRun();
+    test::test_ChaserAveragesJitterAndStops();
+    test::test_ChaserOutOfOrderAndFullFrame();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file test_MtcGenerator.cpp
+ * @brief Loopback tests for MtcGenerator into MtcChaser
+ *
+ * The generator's output is framed by MidiStreamParser and fed to an
+ * MtcChaser with arrival timestamps, as the transport receive path does.
+ * Checks the quarter-frame rate and scheduling jitter, lock time (in
+ * quarter frames) from a cold start and when joining mid-stream, and that
+ * the chased position follows the generator. Timing bounds follow the
+ * generator's deadlines so a loaded host does not fail them.
+ */
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/MidiEvent.hpp>
+#include <oc/hal/midi/MidiStreamParser.hpp>
+#include <oc/hal/midi/MtcChaser.hpp>
+#include <oc/hal/midi/MtcGenerator.hpp>
+
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::MidiStreamParser;
+using oc::hal::midi::MtcChaser;
+using oc::hal::midi::MtcGenerator;
+using oc::hal::midi::MtcGeneratorConfig;
+using oc::hal::midi::MtcPosition;
+using oc::hal::midi::MtcRate;
+using oc::hal::midi::MtcTime;
+using oc::hal::midi::decodeMidiEvent;
+using oc::hal::midi::mtcToFrames;
+using oc::hal::midi::steadyNowUs;
+
+namespace test {
+
+/// Generator output -> parser -> chaser, on the generator thread
+class Loopback {
+public:
+    Loopback() : parser_(sysex_.data(), sysex_.size()) {}
+
+    void operator()(const uint8_t* data, size_t length) {
+        const uint64_t nowUs = steadyNowUs();
+        std::lock_guard<std::mutex> lock(mutex);
+        parser_.parse(data, length, [&](const uint8_t* msg, size_t msgLength) {
+            MidiEvent event;
+            if (!decodeMidiEvent(msg, msgLength, event)) return;
+            if (event.type == MidiEventType::SysEx) {
+                if (chaser.applyFullFrame(msg, msgLength, nowUs)) ++fullFrames;
+                return;
+            }
+            if (event.type != MidiEventType::MtcQuarterFrame) return;
+            arrivals.push_back(nowUs);
+            if (chaser.applyQuarterFrame(event.data1, nowUs) && firstLockUs == 0) {
+                firstLockUs = nowUs;
+            }
+        });
+    }
+
+    std::mutex mutex;
+    MtcChaser chaser;
+    std::vector<uint64_t> arrivals;
+    uint64_t firstLockUs = 0;
+    int fullFrames = 0;
+
+private:
+    std::array<uint8_t, 64> sysex_{};
+    MidiStreamParser parser_;
+};
+
+void sleepMs(int ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+/// Quarter frames that arrived in [fromUs, untilUs]
+size_t quarterFramesUntil(const Loopback& loop, uint64_t fromUs, uint64_t untilUs) {
+    size_t count = 0;
+    for (uint64_t arrival : loop.arrivals) count += arrival >= fromUs && arrival <= untilUs;
+    return count;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_QuarterFrameRateAndJitter() {
+    MtcGeneratorConfig config;
+    config.realtimePriority = false;
+    MtcGenerator mtc(config);
+    Loopback loop;
+    mtc.setOutput([&](const uint8_t* data, size_t length) { loop(data, length); });
+
+    const uint64_t startUs = steadyNowUs();
+    const bool started = mtc.start(MtcTime{0, 0, 0, 0, MtcRate::Fps30});
+    assert(started);
+    assert(mtc.isRunning());
+    sleepMs(500);
+    mtc.stop();
+    const uint64_t elapsedUs = steadyNowUs() - startUs;
+    assert(!mtc.isRunning());
+
+    // 120 quarter frames per second at 30 fps. Bounds come from the
+    // deadlines, not the wall clock, so a loaded host only makes them late:
+    // never more frames than deadlines passed, and never closer together
+    // than one interval apart from the deadlines.
+    const double intervalUs = 1000000.0 / 120.0;
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    const size_t n = loop.arrivals.size();
+    assert(n >= 2 && n <= static_cast<size_t>(elapsedUs / intervalUs) + 1);
+    assert(mtc.quarterFramesSent() == n);
+
+    const auto jitter = mtc.jitter();
+    assert(jitter.count == n);
+    assert(jitter.minUs >= 0);  // Never early
+    const double span = static_cast<double>(loop.arrivals.back() - loop.arrivals.front());
+    // First arrival at most maxUs late (plus loopback slack), last never early.
+    assert(span + static_cast<double>(jitter.maxUs) + intervalUs >= (n - 1) * intervalUs);
+    std::cout << "[PASS] test_QuarterFrameRateAndJitter\n";
+}
+
+void test_LockTimeFromColdStart() {
+    MtcGeneratorConfig config;
+    config.realtimePriority = false;
+    MtcGenerator mtc(config);
+    Loopback loop;
+    mtc.setOutput([&](const uint8_t* data, size_t length) { loop(data, length); });
+
+    const MtcTime from{1, 0, 0, 0, MtcRate::Fps25};
+    const bool started = mtc.start(from);
+    assert(started);
+    sleepMs(300);
+
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        assert(loop.fullFrames == 1);
+        assert(loop.firstLockUs != 0);
+        // Locked by the eighth quarter frame (pieces 0-7), however late
+        // the host delivered them.
+        assert(quarterFramesUntil(loop, 0, loop.firstLockUs) <= 8);
+    }
+
+    // The chased position follows the generator to within a frame.
+    const MtcPosition pos = loop.chaser.position(steadyNowUs());
+    assert(pos.locked && pos.running);
+    assert(std::fabs(pos.frames - mtc.frames()) <= 1.5);
+    assert(pos.frames >= mtcToFrames(from));
+    mtc.stop();
+    std::cout << "[PASS] test_LockTimeFromColdStart\n";
+}
+
+void test_LockTimeJoiningMidStream() {
+    MtcGeneratorConfig config;
+    config.realtimePriority = false;
+    config.sendFullFrame = false;
+    MtcGenerator mtc(config);
+    Loopback loop;
+    mtc.setOutput([&](const uint8_t* data, size_t length) { loop(data, length); });
+
+    const bool started = mtc.start(MtcTime{0, 10, 0, 0, MtcRate::Fps24});
+    assert(started);
+    sleepMs(95);  // Somewhere inside a run
+    uint64_t joinUs;
+    {
+        std::lock_guard<std::mutex> lock(loop.mutex);
+        loop.chaser.reset();
+        loop.firstLockUs = 0;
+        joinUs = steadyNowUs();
+    }
+    sleepMs(300);
+    mtc.stop();
+
+    std::lock_guard<std::mutex> lock(loop.mutex);
+    assert(loop.firstLockUs != 0);
+    // Worst case: just missed piece 0 (7 more pieces), then a full run.
+    assert(quarterFramesUntil(loop, joinUs, loop.firstLockUs) <= 7 + 8);
+
+    // Stopped generator: the chaser reports stopped after two frames.
+    sleepMs(100);
+    const MtcPosition pos = loop.chaser.position(steadyNowUs());
+    assert(pos.locked && !pos.running);
+    assert(std::fabs(pos.frames - mtc.frames()) <= 1.5);
+    std::cout << "[PASS] test_LockTimeJoiningMidStream\n";
+}
+
+void test_StartWithoutOutputFails() {
+    MtcGenerator mtc;
+    const bool started = mtc.start(MtcTime{});
+    assert(!started);
+    assert(!mtc.isRunning());
+    std::cout << "[PASS] test_StartWithoutOutputFails\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "MtcGenerator Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_QuarterFrameRateAndJitter();
+    test::test_LockTimeFromColdStart();
+    test::test_LockTimeJoiningMidStream();
+    test::test_StartWithoutOutputFails();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,159 @@
+/**
+ * @file test_OutputMirror.cpp
+ * @brief Unit tests for OutputMirror
+ *
+ * Checks what is recorded, replay order, that power-on defaults are left
+ * out, and token-bucket pacing.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/OutputMirror.hpp>
+
+using oc::hal::midi::OutputMirror;
+using oc::hal::midi::OutputMirrorConfig;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+void send(OutputMirror& mirror, Bytes message) { mirror.observe(message.data(), message.size()); }
+
+std::vector<Bytes> resync(OutputMirror& mirror, uint64_t nowUs, size_t maxMessages = SIZE_MAX) {
+    std::vector<Bytes> out;
+    mirror.resync(nowUs, [&](const uint8_t* data, size_t length) {
+        out.emplace_back(data, data + length);
+    }, maxMessages);
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_RecordsOnlyState() {
+    OutputMirror mirror;
+    send(mirror, {0x90, 60, 100});  // Notes are not state
+    send(mirror, {0xB0, 99, 1});    // Parameter selection
+    send(mirror, {0xB0, 6, 1});     // Data entry
+    send(mirror, {0xB0, 123, 0});   // Channel mode
+    send(mirror, {0xF8});
+    assert(mirror.entries() == 0);
+
+    send(mirror, {0xB0, 7, 100});
+    send(mirror, {0xB0, 7, 90});
+    send(mirror, {0xC0, 5});
+    send(mirror, {0xE0, 0, 0x50});
+    assert(mirror.entries() == 3);
+    std::cout << "[PASS] test_RecordsOnlyState\n";
+}
+
+void test_ReplayOrder() {
+    OutputMirrorConfig config;
+    config.messagesPerSecond = 0;
+    OutputMirror mirror(config);
+    send(mirror, {0xE3, 0x10, 0x50});
+    send(mirror, {0xB3, 74, 20});
+    send(mirror, {0xC3, 9});
+    send(mirror, {0xB3, 32, 2});
+    send(mirror, {0xB3, 0, 1});
+    send(mirror, {0xB1, 7, 64});
+    send(mirror, {0xB3, 74, 21});
+
+    auto replayed = resync(mirror, 0);
+    assert(replayed.empty());  // Nothing until a resync is requested
+    mirror.beginResync(0);
+    replayed = resync(mirror, 0);
+    assert((replayed == std::vector<Bytes>{{0xB1, 7, 64},
+                                           {0xB3, 0, 1},
+                                           {0xB3, 32, 2},
+                                           {0xC3, 9},
+                                           {0xB3, 74, 21},
+                                           {0xE3, 0x10, 0x50}}));
+    assert(!mirror.resyncPending());
+
+    mirror.clear();
+    mirror.beginResync(0);
+    replayed = resync(mirror, 0);
+    assert(replayed.empty());
+    std::cout << "[PASS] test_ReplayOrder\n";
+}
+
+void test_DefaultsNotReplayed() {
+    OutputMirrorConfig config;
+    config.messagesPerSecond = 0;
+    OutputMirror mirror(config);
+    send(mirror, {0xB0, 7, 100});   // Volume at power-on value
+    send(mirror, {0xB0, 10, 64});   // Pan centered
+    send(mirror, {0xB0, 1, 0});
+    send(mirror, {0xC0, 0});
+    send(mirror, {0xE0, 0, 0x40});  // Bend centered
+    send(mirror, {0xB0, 11, 90});
+    assert(mirror.entries() == 1);
+
+    mirror.beginResync(0);
+    const auto replayed = resync(mirror, 0);
+    assert((replayed == std::vector<Bytes>{{0xB0, 11, 90}}));
+
+    // Moved back to its default: nothing left to restore.
+    send(mirror, {0xB0, 11, 127});
+    assert(mirror.entries() == 0);
+
+    config.skipDefaults = false;
+    OutputMirror full(config);
+    send(full, {0xB0, 7, 100});
+    send(full, {0xE0, 0, 0x40});
+    assert(full.entries() == 2);
+    std::cout << "[PASS] test_DefaultsNotReplayed\n";
+}
+
+void test_Pacing() {
+    OutputMirrorConfig config;
+    config.messagesPerSecond = 1000;
+    config.burst = 4;
+    OutputMirror mirror(config);
+    for (uint8_t cc = 10; cc < 30; ++cc) send(mirror, {0xB0, cc, cc});
+
+    mirror.beginResync(1000);
+    size_t replayed = resync(mirror, 1000).size();
+    assert(replayed == 4);  // Initial burst
+    replayed = resync(mirror, 1500).size();
+    assert(replayed == 0);
+    replayed = resync(mirror, 3000).size();
+    assert(replayed == 2);  // 1 per ms
+    replayed = resync(mirror, 100000).size();
+    assert(replayed == 4);  // Capped at the burst size
+
+    // One at a time (lock released in between): same budget
+    replayed = resync(mirror, 101000, 1).size();
+    assert(replayed == 1);
+    replayed = resync(mirror, 101000).size();
+    assert(replayed == 0);
+
+    size_t total = 11;
+    for (uint64_t t = 200000; mirror.resyncPending(); t += 100000) total += resync(mirror, t, 1).size();
+    assert(total == 20);
+    std::cout << "[PASS] test_Pacing\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "OutputMirror Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_RecordsOnlyState();
+    test::test_ReplayOrder();
+    test::test_DefaultsNotReplayed();
+    test::test_Pacing();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file test_ParameterAssembler.cpp
+ * @brief Unit tests for ParameterAssembler
+ *
+ * Tests 14-bit CC pairs, NRPN / RPN sequences, data increment / decrement,
+ * per-channel state and timeouts of incomplete sequences (including a
+ * poll clock older than the input).
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/ParameterAssembler.hpp>
+
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::ParameterAssembler;
+using oc::hal::midi::ParameterAssemblerConfig;
+using oc::hal::midi::ParameterEvent;
+
+namespace test {
+
+using Kind = ParameterEvent::Kind;
+
+struct Fixture {
+    ParameterAssembler assembler;
+    std::vector<ParameterEvent> events;
+    uint64_t nowUs = 0;
+
+    explicit Fixture(const ParameterAssemblerConfig& config = {}) : assembler(config) {}
+
+    bool cc(uint8_t channel, uint8_t controller, uint8_t value) {
+        MidiEvent event;
+        event.type = MidiEventType::ControlChange;
+        event.channel = channel;
+        event.data1 = controller;
+        event.data2 = value;
+        return assembler.process(event, nowUs, [this](const ParameterEvent& p) {
+            events.push_back(p);
+        });
+    }
+
+    void poll() {
+        assembler.poll(nowUs, [this](const ParameterEvent& p) { events.push_back(p); });
+    }
+};
+
+ParameterAssemblerConfig cc14Config() {
+    ParameterAssemblerConfig config;
+    config.cc14Controllers = (1u << 1) | (1u << 7);  // Mod wheel, volume
+    config.timeoutUs = 1000;
+    return config;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_CC14Pair() {
+    Fixture f(cc14Config());
+
+    bool consumed = f.cc(0, 7, 0x40);
+    assert(consumed);
+    assert(f.events.empty());
+    consumed = f.cc(0, 39, 0x05);
+    assert(consumed);
+
+    assert(f.events.size() == 1);
+    assert(f.events[0].kind == Kind::CC14);
+    assert(f.events[0].number == 7);
+    assert(f.events[0].value == ((0x40 << 7) | 0x05));
+    assert(f.events[0].fine);
+
+    // LSB-only update keeps the last MSB
+    consumed = f.cc(0, 39, 0x06);
+    assert(consumed);
+    assert(f.events.size() == 2 && f.events[1].value == ((0x40 << 7) | 0x06));
+
+    // Unpaired controllers are not consumed
+    consumed = f.cc(0, 2, 10);
+    assert(!consumed);
+    consumed = f.cc(0, 34, 10);
+    assert(!consumed);
+
+    std::cout << "[PASS] test_CC14Pair\n";
+}
+
+void test_CC14LoneMsbTimesOut() {
+    Fixture f(cc14Config());
+
+    bool consumed = f.cc(3, 1, 100);
+    assert(consumed);
+    f.nowUs = 999;
+    f.poll();
+    assert(f.events.empty());
+    f.nowUs = 1000;
+    f.poll();
+
+    assert(f.events.size() == 1);
+    assert(f.events[0].channel == 3);
+    assert(f.events[0].value == (100 << 7));
+    assert(!f.events[0].fine);
+
+    // A new MSB flushes the previous lone one immediately
+    consumed = f.cc(3, 1, 10);
+    assert(consumed);
+    consumed = f.cc(3, 1, 11);
+    assert(consumed);
+    assert(f.events.size() == 2 && f.events[1].value == (10 << 7));
+
+    std::cout << "[PASS] test_CC14LoneMsbTimesOut\n";
+}
+
+void test_PollOlderThanInputDoesNotFlush() {
+    Fixture f(cc14Config());
+
+    // The receive thread stamped the MSB after the poller read its clock.
+    f.nowUs = 5000;
+    bool consumed = f.cc(0, 7, 0x40);
+    assert(consumed);
+    f.nowUs = 4990;
+    f.poll();
+    assert(f.events.empty());
+
+    // The LSB still pairs with it: one fine event, no coarse one.
+    f.nowUs = 5010;
+    consumed = f.cc(0, 39, 0x05);
+    assert(consumed);
+    assert(f.events.size() == 1 && f.events[0].fine);
+
+    std::cout << "[PASS] test_PollOlderThanInputDoesNotFlush\n";
+}
+
+void test_NrpnSequence() {
+    Fixture f;
+
+    bool consumed = f.cc(0, 99, 0x01);
+    assert(consumed);
+    consumed = f.cc(0, 98, 0x10);
+    assert(consumed);
+    consumed = f.cc(0, 6, 0x20);
+    assert(consumed);
+    consumed = f.cc(0, 38, 0x03);
+    assert(consumed);
+
+    assert(f.events.size() == 1);
+    assert(f.events[0].kind == Kind::NRPN);
+    assert(f.events[0].number == ((0x01 << 7) | 0x10));
+    assert(f.events[0].value == ((0x20 << 7) | 0x03));
+
+    // Streaming values to the same parameter: data bytes only
+    consumed = f.cc(0, 6, 0x21);
+    assert(consumed);
+    consumed = f.cc(0, 38, 0x00);
+    assert(consumed);
+    assert(f.events.size() == 2 && f.events[1].value == (0x21 << 7));
+
+    std::cout << "[PASS] test_NrpnSequence\n";
+}
+
+void test_RpnAndNullParameter() {
+    Fixture f;
+
+    // Pitch bend range: RPN 0, 12 semitones
+    bool consumed = f.cc(2, 101, 0);
+    assert(consumed);
+    consumed = f.cc(2, 100, 0);
+    assert(consumed);
+    consumed = f.cc(2, 6, 12);
+    assert(consumed);
+    consumed = f.cc(2, 38, 0);
+    assert(consumed);
+    assert(f.events.size() == 1);
+    assert(f.events[0].kind == Kind::RPN && f.events[0].number == 0);
+
+    // Null parameter: data entry is a plain CC again
+    consumed = f.cc(2, 101, 127);
+    assert(consumed);
+    consumed = f.cc(2, 100, 127);
+    assert(consumed);
+    consumed = f.cc(2, 6, 1);
+    assert(!consumed);
+    assert(f.events.size() == 1);
+
+    std::cout << "[PASS] test_RpnAndNullParameter\n";
+}
+
+void test_IncrementDecrement() {
+    Fixture f;
+
+    f.cc(0, 99, 0);
+    f.cc(0, 98, 5);
+    f.cc(0, 6, 1);
+    f.cc(0, 38, 0x7F);
+    bool consumed = f.cc(0, 96, 0);
+    assert(consumed);
+    consumed = f.cc(0, 97, 0);
+    assert(consumed);
+    consumed = f.cc(0, 97, 0);
+    assert(consumed);
+
+    assert(f.events.size() == 4);
+    assert(f.events[1].value == 0x100);
+    assert(f.events[2].value == 0xFF);
+    assert(f.events[3].value == 0xFE);
+
+    std::cout << "[PASS] test_IncrementDecrement\n";
+}
+
+void test_ChannelsIndependent() {
+    Fixture f;
+
+    f.cc(0, 99, 0);
+    f.cc(0, 98, 1);
+    f.cc(1, 99, 0);
+    f.cc(1, 98, 2);
+    f.cc(1, 6, 10);
+    f.cc(0, 6, 20);
+    f.cc(1, 38, 0);
+    f.cc(0, 38, 0);
+
+    assert(f.events.size() == 2);
+    assert(f.events[0].channel == 1 && f.events[0].number == 2 && f.events[0].value == (10 << 7));
+    assert(f.events[1].channel == 0 && f.events[1].number == 1 && f.events[1].value == (20 << 7));
+
+    std::cout << "[PASS] test_ChannelsIndependent\n";
+}
+
+void test_DataMsbOnlyAndPartialSelection() {
+    ParameterAssemblerConfig config;
+    config.timeoutUs = 1000;
+    Fixture f(config);
+
+    // 7-bit sender: MSB emitted on timeout, lazily on the next message
+    f.cc(0, 99, 0);
+    f.cc(0, 98, 1);
+    f.cc(0, 6, 64);
+    f.nowUs = 5000;
+    bool consumed = f.cc(0, 7, 100);
+    assert(!consumed);
+    assert(f.events.size() == 1 && !f.events[0].fine);
+    assert(f.events[0].value == (64 << 7));
+
+    // Selection never completed: forgotten after the timeout
+    f.cc(5, 99, 3);
+    f.nowUs = 7000;
+    f.poll();
+    f.cc(5, 98, 4);
+    consumed = f.cc(5, 6, 1);
+    assert(!consumed);
+
+    std::cout << "[PASS] test_DataMsbOnlyAndPartialSelection\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "ParameterAssembler Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_CC14Pair();
+    test::test_CC14LoneMsbTimesOut();
+    test::test_PollOlderThanInputDoesNotFlush();
+    test::test_NrpnSequence();
+    test::test_RpnAndNullParameter();
+    test::test_IncrementDecrement();
+    test::test_ChannelsIndependent();
+    test::test_DataMsbOnlyAndPartialSelection();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file test_ParameterEncoder.cpp
+ * @brief Unit tests for ParameterEncoder
+ *
+ * Checks which CCs are skipped when streaming to one parameter, cache
+ * invalidation, and a round trip through ParameterAssembler.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/ParameterAssembler.hpp>
+#include <oc/hal/midi/ParameterEncoder.hpp>
+
+using oc::hal::midi::MidiEvent;
+using oc::hal::midi::ParameterAssembler;
+using oc::hal::midi::ParameterEncoder;
+using oc::hal::midi::ParameterEvent;
+using oc::hal::midi::decodeMidiEvent;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+Bytes nrpn(ParameterEncoder& encoder, uint8_t channel, uint16_t number, uint16_t value) {
+    uint8_t out[ParameterEncoder::MAX_BYTES];
+    const size_t n = encoder.encodeNRPN(channel, number, value, out);
+    return Bytes(out, out + n);
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_FirstWriteIsComplete() {
+    ParameterEncoder encoder;
+    const Bytes message = nrpn(encoder, 1, 0x0085, 0x1003);
+    assert((message == Bytes{0xB1, 99, 0x01, 0xB1, 98, 0x05, 0xB1, 6, 0x20, 0xB1, 38, 0x03}));
+
+    std::cout << "[PASS] test_FirstWriteIsComplete\n";
+}
+
+void test_StreamingSkipsRedundantCCs() {
+    ParameterEncoder encoder;
+    nrpn(encoder, 0, 10, 0x0100);
+
+    // Same parameter, same MSB: LSB only
+    Bytes message = nrpn(encoder, 0, 10, 0x0105);
+    assert((message == Bytes{0xB0, 38, 0x05}));
+    // MSB moves: data MSB + LSB
+    message = nrpn(encoder, 0, 10, 0x0185);
+    assert((message == Bytes{0xB0, 6, 0x03, 0xB0, 38, 0x05}));
+    // Other parameter: full write
+    message = nrpn(encoder, 0, 11, 0x0185);
+    assert(message.size() == 12);
+    // Other channel has its own cache
+    message = nrpn(encoder, 2, 11, 0x0185);
+    assert(message.size() == 12);
+
+    // RPN selection replaces the NRPN one
+    uint8_t out[ParameterEncoder::MAX_BYTES];
+    size_t n = encoder.encodeRPN(0, 11, 0x0185, out);
+    assert(n == 12);
+    assert(out[1] == 101 && out[4] == 100);
+    n = encoder.encodeRPN(0, 11, 0x0186, out);
+    assert(n == 3);
+
+    std::cout << "[PASS] test_StreamingSkipsRedundantCCs\n";
+}
+
+void test_CC14() {
+    ParameterEncoder encoder;
+    uint8_t out[ParameterEncoder::MAX_BYTES];
+
+    size_t n = encoder.encodeCC14(0, 7, 0x2001, out);
+    assert(n == 6);
+    assert(out[1] == 7 && out[2] == 0x40 && out[4] == 39 && out[5] == 0x01);
+    n = encoder.encodeCC14(0, 7, 0x2002, out);
+    assert(n == 3);
+    assert(out[1] == 39 && out[2] == 0x02);
+
+    std::cout << "[PASS] test_CC14\n";
+}
+
+void test_DataEntryAndCC14ShareCC6() {
+    ParameterEncoder encoder;
+    uint8_t out[ParameterEncoder::MAX_BYTES];
+
+    // The NRPN's data entry moves the receiver's CC 6 away from 0x40
+    size_t n = encoder.encodeCC14(0, 6, 0x2001, out);
+    assert(n == 6);
+    Bytes message = nrpn(encoder, 0, 10, 0x0105);
+    assert(message.size() == 12 && message[8] == 0x02);
+    n = encoder.encodeCC14(0, 6, 0x2002, out);
+    assert(n == 6 && out[1] == 6 && out[2] == 0x40);
+
+    // And the 14-bit write moved the latched data MSB away from 0x02
+    message = nrpn(encoder, 0, 10, 0x0106);
+    assert((message == Bytes{0xB0, 6, 0x02, 0xB0, 38, 0x06}));
+
+    // Same MSB on both paths: nothing redundant is written
+    n = encoder.encodeCC14(0, 6, 0x0107, out);
+    assert(n == 3 && out[1] == 38);
+
+    std::cout << "[PASS] test_DataEntryAndCC14ShareCC6\n";
+}
+
+void test_InvalidateAndObserve() {
+    ParameterEncoder encoder;
+    nrpn(encoder, 0, 10, 0x0100);
+
+    encoder.invalidate();
+    Bytes message = nrpn(encoder, 0, 10, 0x0100);
+    assert(message.size() == 12);
+
+    // A CC 99 sent elsewhere changes the receiver's selection
+    encoder.observeCC(0, 99, 5);
+    message = nrpn(encoder, 0, 10, 0x0100);
+    assert(message.size() == 12);
+
+    // A CC 6 sent elsewhere changes the latched MSB
+    encoder.observeCC(0, 6, 9);
+    message = nrpn(encoder, 0, 10, 0x0100);
+    assert(message.size() == 6);
+
+    std::cout << "[PASS] test_InvalidateAndObserve\n";
+}
+
+void test_RoundTripThroughAssembler() {
+    ParameterEncoder encoder;
+    ParameterAssembler assembler;
+    std::vector<ParameterEvent> events;
+
+    const uint16_t values[] = {0x0000, 0x0001, 0x0080, 0x3FFF, 0x3FFE};
+    for (uint16_t value : values) {
+        const Bytes message = nrpn(encoder, 4, 300, value);
+        for (size_t i = 0; i < message.size(); i += 3) {
+            MidiEvent event;
+            const bool decoded = decodeMidiEvent(message.data() + i, 3, event);
+            assert(decoded);
+            const bool consumed = assembler.process(event, 0, [&](const ParameterEvent& p) {
+                events.push_back(p);
+            });
+            assert(consumed);
+        }
+    }
+
+    assert(events.size() == 5);
+    for (size_t i = 0; i < events.size(); ++i) {
+        assert(events[i].kind == ParameterEvent::Kind::NRPN);
+        assert(events[i].channel == 4 && events[i].number == 300);
+        assert(events[i].value == values[i]);
+    }
+
+    std::cout << "[PASS] test_RoundTripThroughAssembler\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "ParameterEncoder Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_FirstWriteIsComplete();
+    test::test_StreamingSkipsRedundantCCs();
+    test::test_CC14();
+    test::test_DataEntryAndCC14ShareCC6();
+    test::test_InvalidateAndObserve();
+    test::test_RoundTripThroughAssembler();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
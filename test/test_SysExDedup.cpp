@@ -0,0 +1,169 @@
+/**
+ * @file test_SysExDedup.cpp
+ * @brief Unit tests for SysExDedup
+ *
+ * Tests per-key suppression of identical frames, forced refresh, eviction
+ * of the least recently sent key and invalidation.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/SysExDedup.hpp>
+
+using oc::hal::midi::SysExDedup;
+using oc::hal::midi::SysExDedupConfig;
+
+namespace test {
+
+using Frame = std::vector<uint8_t>;
+
+// Display line update: F0 7D <cmd> <line> <text...> F7
+Frame line(uint8_t index, char text) {
+    return {0xF0, 0x7D, 0x10, index, static_cast<uint8_t>(text), 0xF7};
+}
+
+bool send(SysExDedup& dedup, const Frame& frame, uint64_t nowUs) {
+    return dedup.shouldSend(frame.data(), frame.size(), nowUs);
+}
+
+SysExDedupConfig lineConfig() {
+    SysExDedupConfig config;
+    config.keyLength = 3;  // manufacturer, command, line
+    config.refreshIntervalUs = 100000;
+    config.maxKeys = 4;
+    return config;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_IdenticalFrameSuppressed() {
+    SysExDedup dedup(lineConfig());
+
+    bool sent = send(dedup, line(0, 'A'), 0);
+    assert(sent);
+    sent = send(dedup, line(0, 'A'), 1000);
+    assert(!sent);
+    sent = send(dedup, line(0, 'A'), 2000);
+    assert(!sent);
+    sent = send(dedup, line(0, 'B'), 3000);
+    assert(sent);
+    sent = send(dedup, line(0, 'A'), 4000);
+    assert(sent);
+
+    assert(dedup.stats().sent == 3);
+    assert(dedup.stats().suppressed == 2);
+
+    std::cout << "[PASS] test_IdenticalFrameSuppressed\n";
+}
+
+void test_KeysTrackedSeparately() {
+    SysExDedup dedup(lineConfig());
+
+    bool sent = send(dedup, line(0, 'A'), 0);
+    assert(sent);
+    sent = send(dedup, line(1, 'A'), 0);
+    assert(sent);
+    sent = send(dedup, line(0, 'A'), 10);
+    assert(!sent);
+    sent = send(dedup, line(1, 'A'), 10);
+    assert(!sent);
+
+    std::cout << "[PASS] test_KeysTrackedSeparately\n";
+}
+
+void test_ForcedRefresh() {
+    SysExDedup dedup(lineConfig());
+
+    bool sent = send(dedup, line(0, 'A'), 0);
+    assert(sent);
+    sent = send(dedup, line(0, 'A'), 99999);
+    assert(!sent);
+    sent = send(dedup, line(0, 'A'), 100000);
+    assert(sent);
+    // Interval restarts from the refresh
+    sent = send(dedup, line(0, 'A'), 150000);
+    assert(!sent);
+    assert(dedup.stats().refreshed == 1);
+
+    SysExDedupConfig config = lineConfig();
+    config.refreshIntervalUs = 0;
+    SysExDedup never(config);
+    sent = send(never, line(0, 'A'), 0);
+    assert(sent);
+    sent = send(never, line(0, 'A'), 60000000);
+    assert(!sent);
+
+    std::cout << "[PASS] test_ForcedRefresh\n";
+}
+
+void test_LeastRecentKeyEvicted() {
+    SysExDedup dedup(lineConfig());
+
+    for (uint8_t i = 0; i < 4; ++i) {
+        const bool sent = send(dedup, line(i, 'A'), i);
+        assert(sent);
+    }
+    // Line 0 is refreshed so line 1 becomes the oldest
+    bool sent = send(dedup, line(0, 'B'), 10);
+    assert(sent);
+    sent = send(dedup, line(4, 'A'), 20);
+    assert(sent);
+    assert(dedup.stats().evicted == 1);
+
+    sent = send(dedup, line(0, 'B'), 30);
+    assert(!sent);
+    sent = send(dedup, line(1, 'A'), 40);
+    assert(sent);  // Forgotten, sent again
+
+    std::cout << "[PASS] test_LeastRecentKeyEvicted\n";
+}
+
+void test_InvalidateResendsAll() {
+    SysExDedup dedup(lineConfig());
+
+    bool sent = send(dedup, line(0, 'A'), 0);
+    assert(sent);
+    dedup.invalidate();
+    sent = send(dedup, line(0, 'A'), 10);
+    assert(sent);
+
+    std::cout << "[PASS] test_InvalidateResendsAll\n";
+}
+
+void test_ShortFrames() {
+    SysExDedup dedup(lineConfig());
+    const Frame tiny = {0xF0, 0xF7};
+
+    bool sent = send(dedup, tiny, 0);
+    assert(sent);
+    sent = send(dedup, tiny, 10);
+    assert(!sent);
+
+    std::cout << "[PASS] test_ShortFrames\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "SysExDedup Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_IdenticalFrameSuppressed();
+    test::test_KeysTrackedSeparately();
+    test::test_ForcedRefresh();
+    test::test_LeastRecentKeyEvicted();
+    test::test_InvalidateResendsAll();
+    test::test_ShortFrames();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_SysExPacking.cpp
+ * @brief Unit tests for 7-in-8 SysEx packing
+ *
+ * Tests the wire format against known vectors, the vectorised kernels
+ * against the scalar reference for every length, and buildPackedSysEx().
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/SysExPacking.hpp>
+
+using namespace oc::hal::midi;
+
+namespace test {
+
+std::vector<uint8_t> makeData(size_t length, uint32_t seed) {
+    std::vector<uint8_t> out(length);
+    for (auto& b : out) {
+        seed = seed * 1664525u + 1013904223u;
+        b = static_cast<uint8_t>(seed >> 24);
+    }
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_Sizes() {
+    assert(sysEx7PackedSize(0) == 0);
+    assert(sysEx7PackedSize(1) == 2);
+    assert(sysEx7PackedSize(7) == 8);
+    assert(sysEx7PackedSize(8) == 10);
+    assert(sysEx7UnpackedSize(0) == 0);
+    assert(sysEx7UnpackedSize(2) == 1);
+    assert(sysEx7UnpackedSize(8) == 7);
+    assert(sysEx7UnpackedSize(10) == 8);
+
+    std::cout << "[PASS] test_Sizes\n";
+}
+
+void test_KnownVector() {
+    const uint8_t raw[] = {0x80, 0x01, 0xFF, 0x7F, 0x00, 0x00, 0x81, 0xC0};
+    const uint8_t expected[] = {0x45, 0x00, 0x01, 0x7F, 0x7F, 0x00, 0x00, 0x01,
+                                0x01, 0x40};
+    uint8_t packed[sizeof(expected)] = {};
+    const size_t packedSize = packSysEx7(raw, sizeof(raw), packed);
+    assert(packedSize == sizeof(expected));
+    for (size_t i = 0; i < sizeof(expected); ++i) assert(packed[i] == expected[i]);
+
+    uint8_t unpacked[sizeof(raw)] = {};
+    const size_t unpackedSize = unpackSysEx7(packed, sizeof(packed), unpacked);
+    assert(unpackedSize == sizeof(raw));
+    for (size_t i = 0; i < sizeof(raw); ++i) assert(unpacked[i] == raw[i]);
+
+    std::cout << "[PASS] test_KnownVector\n";
+}
+
+void test_MatchesScalarForAllLengths() {
+    for (size_t length = 0; length <= 300; ++length) {
+        const auto raw = makeData(length, static_cast<uint32_t>(length));
+
+        std::vector<uint8_t> fast(sysEx7PackedSize(length));
+        std::vector<uint8_t> reference(sysEx7PackedSize(length));
+        const size_t fastPacked = packSysEx7(raw.data(), length, fast.data());
+        const size_t referencePacked = packSysEx7Scalar(raw.data(), length, reference.data());
+        assert(fastPacked == fast.size());
+        assert(referencePacked == reference.size());
+        assert(fast == reference);
+        for (uint8_t b : fast) assert(b < 0x80);
+
+        std::vector<uint8_t> back(length);
+        std::vector<uint8_t> backReference(length);
+        const size_t fastUnpacked = unpackSysEx7(fast.data(), fast.size(), back.data());
+        const size_t referenceUnpacked =
+            unpackSysEx7Scalar(fast.data(), fast.size(), backReference.data());
+        assert(fastUnpacked == length);
+        assert(referenceUnpacked == length);
+        assert(back == raw);
+        assert(backReference == raw);
+    }
+
+    std::cout << "[PASS] test_MatchesScalarForAllLengths\n";
+}
+
+void test_UnpackDoesNotWritePastOutput() {
+    const auto raw = makeData(70, 7);
+    std::vector<uint8_t> packed(sysEx7PackedSize(raw.size()));
+    packSysEx7(raw.data(), raw.size(), packed.data());
+
+    std::vector<uint8_t> out(raw.size() + 16, 0xEE);
+    const size_t unpacked = unpackSysEx7(packed.data(), packed.size(), out.data());
+    assert(unpacked == raw.size());
+    for (size_t i = raw.size(); i < out.size(); ++i) assert(out[i] == 0xEE);
+
+    std::cout << "[PASS] test_UnpackDoesNotWritePastOutput\n";
+}
+
+void test_BuildPackedSysEx() {
+    const uint8_t prefix[] = {0x00, 0x21, 0x7F, 0x10};
+    const uint8_t payload[] = {0xDE, 0xAD, 0xBE, 0xEF};
+    uint8_t out[32] = {};
+
+    const size_t expected = packedSysExMessageSize(sizeof(prefix), sizeof(payload));
+    assert(expected == 2 + 4 + 5);
+    size_t built = buildPackedSysEx(prefix, sizeof(prefix), payload, sizeof(payload), out,
+                                    sizeof(out));
+    assert(built == expected);
+    assert(out[0] == 0xF0);
+    assert(out[1] == 0x00 && out[4] == 0x10);
+    assert(out[5] == 0x0F);
+    assert(out[expected - 1] == 0xF7);
+    for (size_t i = 1; i + 1 < expected; ++i) assert(out[i] < 0x80);
+
+    uint8_t raw[4] = {};
+    const size_t unpacked = unpackSysEx7(out + 5, expected - 6, raw);
+    assert(unpacked == 4);
+    assert(raw[0] == 0xDE && raw[3] == 0xEF);
+
+    // Too small: nothing written
+    built = buildPackedSysEx(prefix, sizeof(prefix), payload, sizeof(payload), out,
+                             expected - 1);
+    assert(built == 0);
+
+    std::cout << "[PASS] test_BuildPackedSysEx\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "SysExPacking Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_Sizes();
+    test::test_KnownVector();
+    test::test_MatchesScalarForAllLengths();
+    test::test_UnpackDoesNotWritePastOutput();
+    test::test_BuildPackedSysEx();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_SysExRouter.cpp
+ * @brief Unit tests for SysExRouter
+ *
+ * Tests longest-prefix routing, ANY wildcards, early rejection through
+ * matches() and prefix validation.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <oc/hal/midi/SysExRouter.hpp>
+
+using oc::hal::midi::SysExRouter;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+struct Fixture {
+    SysExRouter router;
+    std::vector<std::string> calls;
+
+    std::vector<bool> handled;  ///< dispatch() results, in order
+
+    void route(const Bytes& prefix, const std::string& name) {
+        auto handler = [this, name](const uint8_t*, size_t) { calls.push_back(name); };
+        const bool added = router.add(prefix.data(), prefix.size(), handler);
+        assert(added);
+    }
+
+    void dispatch(const Bytes& message) {
+        handled.push_back(router.dispatch(message.data(), message.size()));
+    }
+};
+
+constexpr uint8_t ANY = SysExRouter::ANY;
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_LongestPrefixWins() {
+    Fixture f;
+    f.route({0x00, 0x21, 0x1D}, "vendor");
+    f.route({0x00, 0x21, 0x1D, 0x01, 0x10}, "display");
+
+    f.dispatch({0xF0, 0x00, 0x21, 0x1D, 0x01, 0x10, 0x05, 0xF7});
+    f.dispatch({0xF0, 0x00, 0x21, 0x1D, 0x01, 0x11, 0xF7});
+    f.dispatch({0xF0, 0x00, 0x21, 0x1D, 0xF7});
+    assert((f.handled == std::vector<bool>{true, true, true}));
+    assert((f.calls == std::vector<std::string>{"display", "vendor", "vendor"}));
+
+    std::cout << "[PASS] test_LongestPrefixWins\n";
+}
+
+void test_UnmatchedRejected() {
+    Fixture f;
+    f.route({0x7D, 0x01}, "dev");
+
+    f.dispatch({0xF0, 0x7D, 0x02, 0xF7});
+    f.dispatch({0xF0, 0x41, 0x01, 0xF7});
+    // Prefix longer than the message body
+    f.dispatch({0xF0, 0x7D, 0xF7});
+    assert((f.handled == std::vector<bool>{false, false, false}));
+    assert(!f.router.matches(nullptr, 0));
+    assert(f.calls.empty());
+
+    const Bytes hit = {0xF0, 0x7D, 0x01, 0x00, 0xF7};
+    assert(f.router.matches(hit.data(), hit.size()));
+    assert(f.calls.empty());  // matches() never calls handlers
+
+    std::cout << "[PASS] test_UnmatchedRejected\n";
+}
+
+void test_AnyMatchesDeviceId() {
+    Fixture f;
+    f.route({0x7E, ANY, 0x06, 0x02}, "identity");
+    f.route({0x7E, 0x10, 0x06}, "device16");
+
+    f.dispatch({0xF0, 0x7E, 0x00, 0x06, 0x02, 0x41, 0xF7});
+    f.dispatch({0xF0, 0x7E, 0x7F, 0x06, 0x02, 0xF7});
+    // Exact device match tried first, ANY still reached when it falls short
+    f.dispatch({0xF0, 0x7E, 0x10, 0x06, 0x02, 0xF7});
+    f.dispatch({0xF0, 0x7E, 0x10, 0x06, 0x01, 0xF7});
+    f.dispatch({0xF0, 0x7E, 0x00, 0x06, 0x01, 0xF7});
+    assert((f.handled == std::vector<bool>{true, true, true, true, false}));
+
+    assert((f.calls ==
+            std::vector<std::string>{"identity", "identity", "identity", "device16"}));
+
+    std::cout << "[PASS] test_AnyMatchesDeviceId\n";
+}
+
+void test_AnyAtRoot() {
+    Fixture f;
+    f.route({ANY}, "all");
+    f.route({0x43}, "yamaha");
+
+    f.dispatch({0xF0, 0x43, 0x10, 0xF7});
+    f.dispatch({0xF0, 0x41, 0x10, 0xF7});
+    assert((f.handled == std::vector<bool>{true, true}));
+    assert((f.calls == std::vector<std::string>{"yamaha", "all"}));
+
+    std::cout << "[PASS] test_AnyAtRoot\n";
+}
+
+void test_ReplaceAndClear() {
+    Fixture f;
+    f.route({0x7D}, "first");
+    f.route({0x7D}, "second");
+    f.dispatch({0xF0, 0x7D, 0xF7});
+    assert((f.handled == std::vector<bool>{true}));
+    f.handled.clear();
+    assert(f.calls.back() == "second");
+
+    f.router.clear();
+    assert(f.router.empty());
+    f.dispatch({0xF0, 0x7D, 0xF7});
+    assert((f.handled == std::vector<bool>{false}));
+
+    std::cout << "[PASS] test_ReplaceAndClear\n";
+}
+
+void test_InvalidPrefix() {
+    SysExRouter router;
+    auto handler = [](const uint8_t*, size_t) {};
+    const uint8_t status[] = {0x7D, 0x90};
+    const uint8_t tooLong[SysExRouter::MAX_PREFIX_LENGTH + 1] = {};
+
+    bool added = false;
+    added |= router.add(status, sizeof(status), handler);
+    added |= router.add(tooLong, sizeof(tooLong), handler);
+    added |= router.add(status, 0, handler);
+    added |= router.add(status, 1, nullptr);
+    assert(!added);
+    assert(router.empty());
+
+    std::cout << "[PASS] test_InvalidPrefix\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "SysExRouter Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_LongestPrefixWins();
+    test::test_UnmatchedRejected();
+    test::test_AnyMatchesDeviceId();
+    test::test_AnyAtRoot();
+    test::test_ReplaceAndClear();
+    test::test_InvalidPrefix();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
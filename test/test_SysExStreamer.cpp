@@ -0,0 +1,326 @@
+/**
+ * @file test_SysExStreamer.cpp
+ * @brief Unit tests for SysExStreamer
+ *
+ * Tests whole-message and split chunking, delay and handshake pacing,
+ * cancellation and progress reporting on the streaming thread.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include <oc/hal/midi/SysExStreamer.hpp>
+#include <oc/hal/midi/Timing.hpp>
+
+using oc::hal::midi::SysExStreamer;
+using oc::hal::midi::SysExStreamerConfig;
+using oc::hal::midi::steadyNowUs;
+
+namespace test {
+
+using Chunk = std::vector<uint8_t>;
+
+struct Sink {
+    std::mutex mutex;
+    std::vector<Chunk> chunks;
+    std::vector<uint64_t> times;
+
+    void attach(SysExStreamer& streamer) {
+        streamer.setOutput([this](const uint8_t* data, size_t length) {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.emplace_back(data, data + length);
+            times.push_back(steadyNowUs());
+        });
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return chunks.size();
+    }
+};
+
+std::vector<uint8_t> makeDump(size_t messages, size_t payload) {
+    std::vector<uint8_t> out;
+    for (size_t m = 0; m < messages; ++m) {
+        out.push_back(0xF0);
+        for (size_t i = 0; i < payload; ++i) out.push_back(static_cast<uint8_t>((m + i) & 0x7F));
+        out.push_back(0xF7);
+    }
+    return out;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_FixedSizeChunks() {
+    SysExStreamerConfig config;
+    config.chunkSize = 10;
+    config.splitMessages = true;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(1, 23);  // 25 bytes
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    streamer.wait();
+
+    assert(streamer.state() == SysExStreamer::State::Completed);
+    assert(sink.chunks.size() == 3);
+    assert(sink.chunks[0].size() == 10 && sink.chunks[2].size() == 5);
+    assert(streamer.bytesSent() == dump.size());
+
+    std::cout << "[PASS] test_FixedSizeChunks\n";
+}
+
+void test_ChunksAlignedToMessages() {
+    SysExStreamerConfig config;
+    config.chunkSize = 64;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(3, 10);  // three 12-byte messages
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    streamer.wait();
+
+    assert(sink.chunks.size() == 3);
+    for (const auto& chunk : sink.chunks) {
+        assert(chunk.size() == 12);
+        assert(chunk.front() == 0xF0 && chunk.back() == 0xF7);
+    }
+
+    std::cout << "[PASS] test_ChunksAlignedToMessages\n";
+}
+
+void test_MessagesNeverSplit() {
+    SysExStreamerConfig config;
+    config.chunkSize = 8;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    // Longer than chunkSize: still one output call per message.
+    const auto dump = makeDump(2, 40);
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    streamer.wait();
+
+    assert(sink.chunks.size() == 2);
+    for (const auto& chunk : sink.chunks) {
+        assert(chunk.size() == 42 && chunk.front() == 0xF0 && chunk.back() == 0xF7);
+    }
+
+    std::cout << "[PASS] test_MessagesNeverSplit\n";
+}
+
+void test_ReaderSourceAndProgress() {
+    SysExStreamerConfig config;
+    config.chunkSize = 16;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(2, 30);  // two 32-byte messages
+    size_t offset = 0;
+    std::vector<size_t> progress;
+    streamer.setOnProgress([&](size_t sent, size_t total) {
+        assert(total == dump.size());
+        progress.push_back(sent);
+    });
+
+    // Reader hands out 5 bytes at a time
+    const bool started = streamer.start([&](uint8_t* buffer, size_t capacity) {
+        const size_t n = std::min<size_t>({capacity, 5, dump.size() - offset});
+        std::memcpy(buffer, dump.data() + offset, n);
+        offset += n;
+        return n;
+    }, dump.size());
+    assert(started);
+    streamer.wait();
+
+    // Messages larger than the staging buffer still leave whole.
+    assert(streamer.state() == SysExStreamer::State::Completed);
+    assert(sink.chunks.size() == 2);
+    Chunk joined;
+    for (const auto& chunk : sink.chunks) {
+        assert(chunk.size() == 32 && chunk.front() == 0xF0 && chunk.back() == 0xF7);
+        joined.insert(joined.end(), chunk.begin(), chunk.end());
+    }
+    assert(joined == dump);
+    assert((progress == std::vector<size_t>{32, 64}));
+
+    std::cout << "[PASS] test_ReaderSourceAndProgress\n";
+}
+
+void test_OversizedMessageStops() {
+    SysExStreamerConfig config;
+    config.chunkSize = 16;
+    config.maxMessageSize = 40;
+
+    // Span: the 32-byte message leaves, the 52-byte one is refused whole.
+    auto dump = makeDump(1, 30);
+    const auto large = makeDump(1, 50);
+    dump.insert(dump.end(), large.begin(), large.end());
+    {
+        SysExStreamer streamer(config);
+        Sink sink;
+        sink.attach(streamer);
+        const bool started = streamer.start(dump.data(), dump.size());
+        assert(started);
+        streamer.wait();
+        assert(streamer.state() == SysExStreamer::State::TooLarge);
+        assert(sink.chunks.size() == 1 && sink.chunks[0].size() == 32);
+    }
+
+    // Reader: staging stops growing at the limit instead of following the source.
+    {
+        SysExStreamer streamer(config);
+        Sink sink;
+        sink.attach(streamer);
+        size_t offset = 0;
+        const bool started = streamer.start([&](uint8_t* buffer, size_t capacity) {
+            const size_t n = std::min(capacity, dump.size() - offset);
+            std::memcpy(buffer, dump.data() + offset, n);
+            offset += n;
+            return n;
+        });
+        assert(started);
+        streamer.wait();
+        assert(streamer.state() == SysExStreamer::State::TooLarge);
+        assert(sink.chunks.size() == 1 && streamer.bytesSent() == 32);
+        assert(offset < dump.size());
+    }
+
+    std::cout << "[PASS] test_OversizedMessageStops\n";
+}
+
+void test_DelayPacing() {
+    SysExStreamerConfig config;
+    config.chunkSize = 4;
+    config.splitMessages = true;
+    config.interChunkDelayUs = 5000;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(1, 14);  // 16 bytes -> 4 chunks
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    streamer.wait();
+
+    assert(sink.chunks.size() == 4);
+    for (size_t i = 1; i < sink.times.size(); ++i) {
+        assert(sink.times[i] - sink.times[i - 1] >= 5000);
+    }
+
+    std::cout << "[PASS] test_DelayPacing\n";
+}
+
+void test_HandshakePacing() {
+    SysExStreamerConfig config;
+    config.chunkSize = 64;
+    config.pacing = SysExStreamerConfig::Pacing::Handshake;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(3, 8);
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+
+    // Acknowledge each packet once it has been seen, like a device reply
+    // would; the next one waits for it. The last one needs no reply.
+    for (size_t acked = 0; acked < 2; ++acked) {
+        const uint64_t start = steadyNowUs();
+        while (sink.count() <= acked) assert(steadyNowUs() - start < 1000000);
+        assert(sink.count() == acked + 1);
+        streamer.acknowledge();
+    }
+    streamer.wait();
+
+    assert(streamer.state() == SysExStreamer::State::Completed);
+    assert(sink.chunks.size() == 3);
+
+    // A single message completes at once, without waiting for a reply.
+    const uint64_t start = steadyNowUs();
+    const bool restarted = streamer.start(dump.data(), 10);
+    assert(restarted);
+    streamer.wait();
+    assert(streamer.state() == SysExStreamer::State::Completed);
+    assert(steadyNowUs() - start < config.handshakeTimeoutUs / 2);
+
+    std::cout << "[PASS] test_HandshakePacing\n";
+}
+
+void test_HandshakeTimeout() {
+    SysExStreamerConfig config;
+    config.pacing = SysExStreamerConfig::Pacing::Handshake;
+    config.handshakeTimeoutUs = 10000;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(2, 8);
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    streamer.wait();
+
+    assert(streamer.state() == SysExStreamer::State::TimedOut);
+    assert(sink.chunks.size() == 1);
+
+    std::cout << "[PASS] test_HandshakeTimeout\n";
+}
+
+void test_Cancel() {
+    SysExStreamerConfig config;
+    config.chunkSize = 4;
+    config.splitMessages = true;
+    config.interChunkDelayUs = 1000000;
+    SysExStreamer streamer(config);
+    Sink sink;
+    sink.attach(streamer);
+
+    const auto dump = makeDump(1, 30);
+    const bool started = streamer.start(dump.data(), dump.size());
+    assert(started);
+    const uint64_t start = steadyNowUs();
+    while (sink.count() == 0) assert(steadyNowUs() - start < 1000000);
+    streamer.cancel();
+
+    assert(streamer.state() == SysExStreamer::State::Cancelled);
+    assert(sink.chunks.size() == 1);
+    assert(steadyNowUs() - start < 500000);
+
+    std::cout << "[PASS] test_Cancel\n";
+}
+
+} // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "SysExStreamer Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_FixedSizeChunks();
+    test::test_ChunksAlignedToMessages();
+    test::test_MessagesNeverSplit();
+    test::test_ReaderSourceAndProgress();
+    test::test_OversizedMessageStops();
+    test::test_DelayPacing();
+    test::test_HandshakePacing();
+    test::test_HandshakeTimeout();
+    test::test_Cancel();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
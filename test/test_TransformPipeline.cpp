@@ -0,0 +1,161 @@
+/**
+ * @file test_TransformPipeline.cpp
+ * @brief Unit tests for the transform stages, TransformPipeline and StaticTransform
+ *
+ * Checks each stage, a keyboard split built from zones, drop semantics,
+ * the SysEx type check and that both chain forms agree.
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <oc/hal/midi/TransformPipeline.hpp>
+
+using oc::hal::midi::MidiEventType;
+using oc::hal::midi::StaticTransform;
+using oc::hal::midi::TransformPipeline;
+using oc::hal::midi::midiEventBit;
+namespace transform = oc::hal::midi::transform;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+template <typename Chain>
+bool run(const Chain& chain, Bytes& message) {
+    return chain.apply(message.data(), message.size());
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_Stages() {
+    Bytes m = {0x90, 60, 100};
+    bool kept = transform::Transpose{-12}.apply(m.data(), 3);
+    assert(kept && m[1] == 48);
+    kept = transform::Transpose{100}.apply(m.data(), 3);
+    assert(!kept);
+
+    m = {0x92, 60, 100};
+    transform::MapChannel map;
+    map.map[2] = 9;
+    kept = map.apply(m.data(), 3);
+    assert(kept && m[0] == 0x99);
+    map.map[9] = transform::MapChannel::DROP;
+    kept = map.apply(m.data(), 3);
+    assert(!kept);
+
+    m = {0x90, 100, 100};
+    kept = transform::ScaleVelocity{128}.apply(m.data(), 3);
+    assert(kept && m[2] == 50);
+    m = {0x90, 100, 1};
+    kept = transform::ScaleVelocity{64}.apply(m.data(), 3);
+    assert(kept && m[2] == 1);  // Never 0
+    m = {0x90, 100, 120};
+    kept = transform::ScaleVelocity{256, 20}.apply(m.data(), 3);
+    assert(kept && m[2] == 127);
+    m = {0x90, 100, 0};
+    kept = transform::ScaleVelocity{512}.apply(m.data(), 3);
+    assert(kept && m[2] == 0);  // Note Off stays
+
+    m = {0xB3, 7, 100};
+    kept = transform::FilterChannels{0x0008}.apply(m.data(), 3);
+    assert(kept);
+    kept = transform::FilterChannels{0x0001}.apply(m.data(), 3);
+    assert(!kept);
+    kept = transform::FilterTypes{midiEventBit(MidiEventType::NoteOn)}.apply(m.data(), 3);
+    assert(!kept);
+    std::cout << "[PASS] test_Stages\n";
+}
+
+void test_KeyboardSplit() {
+    TransformPipeline pipeline;
+    pipeline.add(transform::KeyZone{0, 59, 1});
+    pipeline.add(transform::KeyZone{60, 127, 2});
+    pipeline.add(transform::Transpose{12});
+
+    Bytes low = {0x90, 40, 100};
+    Bytes high = {0x80, 72, 0};
+    Bytes cc = {0xB0, 64, 127};
+    bool kept = run(pipeline, low);
+    assert(kept && (low == Bytes{0x91, 52, 100}));
+    kept = run(pipeline, high);
+    assert(kept && (high == Bytes{0x82, 84, 0}));
+    kept = run(pipeline, cc);
+    assert(kept && (cc == Bytes{0xB0, 64, 127}));  // Not a note message
+
+    Bytes clock = {0xF8};
+    kept = run(pipeline, clock);
+    assert(kept && clock[0] == 0xF8);
+    std::cout << "[PASS] test_KeyboardSplit\n";
+}
+
+void test_DropAndCapacity() {
+    TransformPipeline pipeline;
+    assert(pipeline.empty());
+    pipeline.add(transform::FilterTypes{midiEventBit(MidiEventType::NoteOn) |
+                                        midiEventBit(MidiEventType::NoteOff)});
+    Bytes cc = {0xB0, 1, 2};
+    Bytes note = {0x90, 1, 2};
+    bool kept = run(pipeline, cc);
+    assert(!kept);
+    kept = run(pipeline, note);
+    assert(kept);
+    assert(!pipeline.passes(MidiEventType::SysEx));
+
+    pipeline.clear();
+    assert(pipeline.passes(MidiEventType::SysEx));
+    for (size_t i = 0; i < TransformPipeline::MAX_STAGES; ++i) {
+        const bool added = pipeline.add(transform::Transpose{0});
+        assert(added);
+    }
+    const bool addedPastCapacity = pipeline.add(transform::Transpose{0});
+    assert(!addedPastCapacity);
+    std::cout << "[PASS] test_DropAndCapacity\n";
+}
+
+void test_StaticMatchesRuntime() {
+    TransformPipeline runtime;
+    runtime.add(transform::MapChannel{{1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}});
+    runtime.add(transform::Transpose{5});
+    runtime.add(transform::ScaleVelocity{200, 3});
+    StaticTransform<transform::MapChannel, transform::Transpose, transform::ScaleVelocity>
+        fixed(transform::MapChannel{{1, 0, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}},
+              transform::Transpose{5}, transform::ScaleVelocity{200, 3});
+
+    for (uint8_t status : {0x80, 0x90, 0xA0, 0xB0}) {
+        for (uint8_t ch = 0; ch < 3; ++ch) {
+            for (int note = 0; note < 128; note += 7) {
+                Bytes a = {static_cast<uint8_t>(status | ch), static_cast<uint8_t>(note), 77};
+                Bytes b = a;
+                const bool keptRuntime = run(runtime, a);
+                const bool keptFixed = run(fixed, b);
+                assert(keptRuntime == keptFixed);
+                assert(a == b);
+            }
+        }
+    }
+    std::cout << "[PASS] test_StaticMatchesRuntime\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "TransformPipeline Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_Stages();
+    test::test_KeyboardSplit();
+    test::test_DropAndCapacity();
+    test::test_StaticMatchesRuntime();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}
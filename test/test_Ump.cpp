@@ -0,0 +1,377 @@
+/**
+ * @file test_Ump.cpp
+ * @brief Unit tests for UmpPacket, UmpDispatcher, UMP translation and SpscQueue
+ *
+ * Covers value scaling, MIDI 1.0 <-> UMP round trips in both protocols,
+ * SysEx7 segmentation and reassembly, and the packet ring used between the
+ * receive thread and update().
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <oc/hal/midi/SpscQueue.hpp>
+#include <oc/hal/midi/Ump.hpp>
+#include <oc/hal/midi/UmpTranslator.hpp>
+
+using oc::hal::midi::Midi1ToUmp;
+using oc::hal::midi::SpscQueue;
+using oc::hal::midi::UmpDispatcher;
+using oc::hal::midi::UmpPacket;
+using oc::hal::midi::UmpToMidi1;
+using oc::hal::midi::UmpType;
+using oc::hal::midi::umpScaleDown;
+using oc::hal::midi::umpScaleUp;
+
+namespace test {
+
+using Bytes = std::vector<uint8_t>;
+
+std::vector<UmpPacket> toUmp(Midi1ToUmp& translator, const Bytes& message) {
+    std::vector<UmpPacket> packets;
+    translator.convert(message.data(), message.size(),
+                       [&](const UmpPacket& packet) { packets.push_back(packet); });
+    return packets;
+}
+
+std::vector<Bytes> toMidi1(UmpToMidi1& translator, const std::vector<UmpPacket>& packets) {
+    std::vector<Bytes> messages;
+    for (const auto& packet : packets) {
+        translator.convert(packet, [&](const uint8_t* data, size_t length) {
+            messages.emplace_back(data, data + length);
+        });
+    }
+    return messages;
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Test Cases
+// ═══════════════════════════════════════════════════════════════════
+
+void test_Scaling() {
+    assert(umpScaleUp(0, 7, 16) == 0);
+    assert(umpScaleUp(64, 7, 16) == 0x8000);
+    assert(umpScaleUp(127, 7, 16) == 0xFFFF);
+    assert(umpScaleUp(127, 7, 32) == 0xFFFFFFFF);
+    assert(umpScaleUp(0x2000, 14, 32) == 0x80000000);
+    assert(umpScaleUp(0x3FFF, 14, 32) == 0xFFFFFFFF);
+
+    for (uint32_t v = 0; v < 128; ++v) {
+        assert(umpScaleDown(umpScaleUp(v, 7, 16), 16, 7) == v);
+        assert(umpScaleDown(umpScaleUp(v, 7, 32), 32, 7) == v);
+    }
+    std::cout << "[PASS] test_Scaling\n";
+}
+
+void test_PacketFields() {
+    UmpPacket packet;
+    packet.words[0] = 0x4395407F;
+    assert(packet.type() == 0x4);
+    assert(packet.group() == 0x3);
+    assert(packet.status() == 0x95);
+    assert(packet.channel() == 0x5);
+    assert(packet.wordCount() == 2);
+
+    packet.words[0] = 0x10F80000;
+    assert(packet.wordCount() == 1);
+    packet.words[0] = 0x50000000;
+    assert(packet.wordCount() == 4);
+    std::cout << "[PASS] test_PacketFields\n";
+}
+
+void test_Midi1ProtocolRoundTrip() {
+    Midi1ToUmp to(2, false);
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    const std::vector<Bytes> messages = {
+        {0x93, 60, 100}, {0x83, 60, 0}, {0xB0, 7, 99}, {0xC4, 12},  {0xD1, 77},
+        {0xE2, 0x11, 0x40}, {0xF8},     {0xF2, 0x10, 0x02}, {0xF1, 0x35}};
+    for (const auto& message : messages) {
+        const auto packets = toUmp(to, message);
+        assert(packets.size() == 1);
+        assert(packets[0].wordCount() == 1);
+        assert(packets[0].group() == 2);
+        const auto back = toMidi1(from, packets);
+        assert(back.size() == 1 && back[0] == message);
+    }
+
+    const auto packets = toUmp(to, {0x93, 60, 100});
+    assert(packets[0].words[0] == 0x2293'3C64);
+    std::cout << "[PASS] test_Midi1ProtocolRoundTrip\n";
+}
+
+void test_Midi2ProtocolRoundTrip() {
+    Midi1ToUmp to(0, true);
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    const std::vector<Bytes> messages = {{0x90, 60, 100}, {0x80, 60, 64}, {0xA1, 60, 5},
+                                         {0xB2, 74, 127}, {0xD3, 1},      {0xE4, 0x7F, 0x7F},
+                                         {0xE4, 0x00, 0x40}};
+    for (const auto& message : messages) {
+        const auto packets = toUmp(to, message);
+        assert(packets.size() == 1);
+        assert(packets[0].type() == 0x4 && packets[0].wordCount() == 2);
+        const auto back = toMidi1(from, packets);
+        assert(back.size() == 1 && back[0] == message);
+    }
+
+    // Velocity is 16-bit in the second word
+    const auto note = toUmp(to, {0x90, 60, 127});
+    assert(note[0].words[0] == 0x4090'3C00);
+    assert(note[0].words[1] == 0xFFFF'0000);
+    std::cout << "[PASS] test_Midi2ProtocolRoundTrip\n";
+}
+
+void test_NoteOnVelocityZero() {
+    Midi1ToUmp to(0, true);
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    auto packets = toUmp(to, {0x91, 60, 0});
+    assert(packets.size() == 1 && packets[0].status() == 0x81);
+    auto back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{{0x81, 60, 64}}));
+
+    // A MIDI 2.0 Note On with velocity 0 stays a Note On in MIDI 1.0
+    UmpPacket zero;
+    zero.words[0] = 0x4091'3C00;
+    zero.words[1] = 0;
+    back = toMidi1(from, {zero});
+    assert((back == std::vector<Bytes>{{0x91, 60, 1}}));
+    std::cout << "[PASS] test_NoteOnVelocityZero\n";
+}
+
+void test_ProgramChangeWithBank() {
+    Midi1ToUmp to(0, true);
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    auto packets = toUmp(to, {0xB5, 0, 3});
+    assert(packets.empty());
+    packets = toUmp(to, {0xB5, 32, 9});
+    assert(packets.empty());
+    packets = toUmp(to, {0xC5, 42});
+    assert(packets.size() == 1);
+    assert(packets[0].words[0] == 0x40C5'0001);
+    assert(packets[0].words[1] == 0x2A00'0309);
+    auto back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{{0xB5, 0, 3}, {0xB5, 32, 9}, {0xC5, 42}}));
+
+    // Bank is consumed by the Program Change
+    packets = toUmp(to, {0xC5, 43});
+    assert((packets[0].words[0] & 0x01) == 0);
+    back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{{0xC5, 43}}));
+    std::cout << "[PASS] test_ProgramChangeWithBank\n";
+}
+
+void test_RegisteredControllerToCC() {
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    UmpPacket nrpn;
+    nrpn.words[0] = 0x4032'0105;  // Assignable controller, bank 1, index 5
+    nrpn.words[1] = umpScaleUp(0x1003, 14, 32);
+    const auto nrpnMessages = toMidi1(from, {nrpn});
+    assert((nrpnMessages ==
+            std::vector<Bytes>{{0xB2, 99, 1}, {0xB2, 98, 5}, {0xB2, 6, 0x20}, {0xB2, 38, 0x03}}));
+
+    UmpPacket rpn = nrpn;
+    rpn.words[0] = 0x4022'0000;
+    const auto messages = toMidi1(from, {rpn});
+    assert(messages.size() == 4 && messages[0][1] == 101 && messages[1][1] == 100);
+    std::cout << "[PASS] test_RegisteredControllerToCC\n";
+}
+
+void test_DataEntryToRegisteredController() {
+    Midi1ToUmp to(0, true);
+    uint8_t buffer[16];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    // Selection is held; each data entry CC carries the current value
+    auto packets = toUmp(to, {0xB2, 99, 1});
+    assert(packets.empty());
+    packets = toUmp(to, {0xB2, 98, 5});
+    assert(packets.empty());
+    packets = toUmp(to, {0xB2, 6, 0x20});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x4032'0105);
+    assert(packets[0].words[1] == umpScaleUp(0x20 << 7, 14, 32));
+    packets = toUmp(to, {0xB2, 38, 0x03});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x4032'0105);
+    assert(packets[0].words[1] == umpScaleUp(0x1003, 14, 32));
+    const auto back = toMidi1(from, packets);
+    assert((back ==
+            std::vector<Bytes>{{0xB2, 99, 1}, {0xB2, 98, 5}, {0xB2, 6, 0x20}, {0xB2, 38, 0x03}}));
+
+    // LSB-only update keeps the latched MSB
+    packets = toUmp(to, {0xB2, 38, 0x04});
+    assert(packets.size() == 1 && packets[0].words[1] == umpScaleUp(0x1004, 14, 32));
+
+    // RPN selection replaces the NRPN one
+    toUmp(to, {0xB2, 101, 0});
+    toUmp(to, {0xB2, 100, 2});
+    packets = toUmp(to, {0xB2, 6, 0x40});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x4022'0002);
+
+    // Null RPN: data entry and increment stay plain CCs
+    toUmp(to, {0xB2, 101, 127});
+    toUmp(to, {0xB2, 100, 127});
+    packets = toUmp(to, {0xB2, 6, 0x40});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x40B2'0600);
+    packets = toUmp(to, {0xB2, 96, 0});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x40B2'6000);
+
+    // Other channels have their own selection
+    packets = toUmp(to, {0xB3, 6, 1});
+    assert(packets.size() == 1 && packets[0].words[0] == 0x40B3'0600);
+    std::cout << "[PASS] test_DataEntryToRegisteredController\n";
+}
+
+void test_SysExSegmentation() {
+    Midi1ToUmp to(1, false);
+    uint8_t buffer[64];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    const Bytes shortSysEx = {0xF0, 0x7E, 0x7F, 0x06, 0x01, 0xF7};
+    auto packets = toUmp(to, shortSysEx);
+    assert(packets.size() == 1);
+    assert(packets[0].words[0] == 0x3104'7E7F);
+    auto back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{shortSysEx}));
+
+    Bytes longSysEx = {0xF0};
+    for (uint8_t i = 0; i < 20; ++i) longSysEx.push_back(i);
+    longSysEx.push_back(0xF7);
+    packets = toUmp(to, longSysEx);
+    assert(packets.size() == 4);
+    assert(((packets[0].words[0] >> 20) & 0x0F) == 1);
+    assert(((packets[1].words[0] >> 20) & 0x0F) == 2);
+    assert(((packets[3].words[0] >> 20) & 0x0F) == 3);
+    assert(((packets[3].words[0] >> 16) & 0x0F) == 2);
+    back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{longSysEx}));
+
+    // Empty SysEx still produces one complete packet
+    packets = toUmp(to, {0xF0, 0xF7});
+    assert(packets.size() == 1 && (packets[0].words[0] & 0x00FF'0000) == 0);
+    back = toMidi1(from, packets);
+    assert((back == std::vector<Bytes>{{0xF0, 0xF7}}));
+    std::cout << "[PASS] test_SysExSegmentation\n";
+}
+
+void test_SysExOverflow() {
+    Midi1ToUmp to;
+    uint8_t buffer[8];
+    UmpToMidi1 from(buffer, sizeof(buffer));
+
+    Bytes sysex = {0xF0};
+    for (uint8_t i = 0; i < 10; ++i) sysex.push_back(i);
+    sysex.push_back(0xF7);
+    auto back = toMidi1(from, toUmp(to, sysex));
+    assert(back.empty());
+    assert(from.sysexOverflows() == 1);
+
+    // Continue without Start is ignored
+    UmpPacket orphan;
+    orphan.words[0] = 0x3026'0102;
+    back = toMidi1(from, {orphan});
+    assert(back.empty());
+    std::cout << "[PASS] test_SysExOverflow\n";
+}
+
+void test_Dispatcher() {
+    UmpDispatcher dispatcher;
+    int voice = 0;
+    dispatcher.setHandler(UmpType::Midi2ChannelVoice, [&](const UmpPacket&) { ++voice; });
+
+    UmpPacket packet;
+    packet.words[0] = 0x4090'3C00;
+    bool handled = dispatcher.dispatch(packet);
+    assert(handled);
+    packet.words[0] = 0x2090'3C64;
+    handled = dispatcher.dispatch(packet);
+    assert(!handled);
+    assert(voice == 1);
+    assert(dispatcher.hasHandler(0x4) && !dispatcher.hasHandler(0x2));
+    std::cout << "[PASS] test_Dispatcher\n";
+}
+
+void test_SpscQueue() {
+    SpscQueue<int> queue(3);
+    assert(queue.capacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        const bool pushed = queue.push(i);
+        assert(pushed);
+    }
+    bool ok = queue.push(4);
+    assert(!ok);
+    int value = -1;
+    ok = queue.pop(value);
+    assert(ok && value == 0);
+    ok = queue.push(4);
+    assert(ok);
+    for (int i = 1; i <= 4; ++i) {
+        const bool popped = queue.pop(value);
+        assert(popped && value == i);
+    }
+    ok = queue.pop(value);
+    assert(!ok && queue.empty());
+
+    // Ordered, lossless hand-off between two threads
+    SpscQueue<uint32_t> ring(64);
+    constexpr uint32_t COUNT = 20000;
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < COUNT;) {
+            if (ring.push(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t expected = 0;
+    while (expected < COUNT) {
+        uint32_t v;
+        if (ring.pop(v)) {
+            assert(v == expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    assert(ring.empty());
+    std::cout << "[PASS] test_SpscQueue\n";
+}
+
+}  // namespace test
+
+int main() {
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "UMP Unit Tests\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    test::test_Scaling();
+    test::test_PacketFields();
+    test::test_Midi1ProtocolRoundTrip();
+    test::test_Midi2ProtocolRoundTrip();
+    test::test_NoteOnVelocityZero();
+    test::test_ProgramChangeWithBank();
+    test::test_RegisteredControllerToCC();
+    test::test_DataEntryToRegisteredController();
+    test::test_SysExSegmentation();
+    test::test_SysExOverflow();
+    test::test_Dispatcher();
+    test::test_SpscQueue();
+
+    std::cout << "\n═══════════════════════════════════════════════════════════════════\n";
+    std::cout << "All tests passed!\n";
+    std::cout << "═══════════════════════════════════════════════════════════════════\n";
+
+    return 0;
+}